@@ -23,11 +23,18 @@
 #include <time.h>
 #include <math.h>
 #include <limits.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <dirent.h>
 
 #ifndef _ISWINDOWS
 #include <sys/stat.h>
+#include <sys/resource.h>
 #endif
 
 // SDL2
@@ -49,6 +56,111 @@
 // How many turns we allow for history and playboard, before we reset history and playboard turns
 #define TURN_LIMIT UINT_MAX
 
+// The directory scanned for additional .rle pattern files on startup
+#define PATTERN_DIRECTORY "patterns"
+
+// The maximum size of a .rle pattern file we read in
+#define PATTERN_FILE_LIMIT 1048576
+
+// The widest and tallest pattern we read in, the size of the largest playboard
+#define PATTERN_SIZE_LIMIT 250
+
+// The default memory cap of the undo journal in kilobytes
+#define UNDO_LIMIT_KB 16384
+
+// How many generations of shape and position are kept per tracked object, the longest detectable period
+#define TRACK_HISTORY 32
+
+// Objects with more living cells are not tracked, they are most likely chaotic regions
+#define TRACK_POPULATION_LIMIT 400
+
+// How many timed samples are taken per benchmark case
+#define BENCH_SAMPLES 15
+
+// How many bootstrap resamples are drawn for the confidence interval of a speedup
+#define BENCH_RESAMPLES 2000
+
+// The default slowdown a benchmark case may show before it counts as regression
+#define BENCH_THRESHOLD 0.05
+
+// How many frames are rendered per sample of a render benchmark case
+#define BENCH_FRAMES 8
+
+// How many generations are recorded per sample of a history benchmark case
+#define BENCH_HISTORY_TURNS 256
+
+// How many random turns are displayed per sample of the history seek benchmark
+#define BENCH_SEEKS 32
+
+// How many timed samples are taken per image import and export case, each takes long
+#define BENCH_IO_SAMPLES 5
+
+// The directory of the example images, the inputs of the image import benchmark
+#define EXAMPLE_IMAGE_DIRECTORY "example_images"
+
+// The longest line of an input recording, a dropped file path makes it long
+#define INPUT_LINE_LIMIT 1024
+
+// The maximum size of a benchmark result file we read in
+#define BENCH_FILE_LIMIT 16777216
+
+// How many phases of the program start are timed for the startup report
+#define STARTUP_PHASES 16
+
+// The directory saved images are written to, created on the first save
+#define SAVED_IMAGE_DIRECTORY "saved_images"
+
+// How many bytes of the memory overlay text lines are reserved
+#define MEMORY_LINE_LENGTH 64
+
+// How many of the latest events the flight recorder keeps
+#define FLIGHT_EVENTS 4096
+
+// A frame taking longer than this many milliseconds dumps the flight recorder
+#define FLIGHT_STALL_MS 250
+
+// The file the flight recorder is dumped to on a stall
+#define FLIGHT_RECORDER_FILE "flight_recorder.log"
+
+// The file the flight recorder is dumped to on a crash, stalls never overwrite it
+#define FLIGHT_CRASH_FILE "flight_recorder_crash.log"
+
+// The most entries of the transitions of a rule table, states to the power of the neighbourhood cells
+#define STATE_TABLE_ENTRY_LIMIT 16777216
+
+// The most variables of a rule table
+#define STATE_TABLE_VARIABLES 128
+
+// The most threads applying the bands of a rule table turn
+#define STATE_TABLE_THREADS 8
+
+// The least cells of a band applied by its own thread
+#define STATE_TABLE_BAND_CELLS 4096
+
+// The most threads applying the slabs of a 3D Life turn
+#define LIFE_CUBE_THREADS 8
+
+// The most threads applying the bands of the transforms of a Lenia turn
+#define LENIA_THREADS 8
+
+// The least state of a Lenia cell shown as living
+#define LENIA_VISIBLE 0.05
+
+// Pi for the roots of unity of the Fourier transforms
+#define FFT_PI 3.14159265358979323846
+
+// The share of the predicted cost of the playing engine the other engine of
+// -engineauto has to beat, and the turns in a row it has to, before a switch
+#define AUTO_ENGINE_MARGIN 0.7
+#define AUTO_ENGINE_TURNS 16
+
+// How fast the cost of an engine follows its measured turns
+#define AUTO_ENGINE_LEARNING 0.1
+
+// The turns -verify plays -engineauto on each engine before switching, so
+// every run converts the playboard both ways at the same turns
+#define AUTO_ENGINE_VERIFY_TURNS 5
+
 //------------------------------------------------------------------------------
 // Enums
 //------------------------------------------------------------------------------
@@ -73,6 +185,46 @@ enum INFOPANELSTATES {
   BORN = 1
 };
 
+// The neighbourhoods of a cell a turn counts the living neighbours in
+enum NEIGHBOURHOODS {
+  MOORE = 0,        // The 8 surrounding cells
+  HEXAGONAL = 1,    // 6 cells of a hexagonal grid, odd rows are shifted right by half a cell
+  VON_NEUMANN = 2,  // The 4 cells sharing an edge
+  NEIGHBOURHOOD_COUNT = 3
+};
+
+// The operations applied to the selected rectangle of the playboard
+enum REGIONOPERATIONS {
+  REGION_CLEAR = 0,
+  REGION_INVERT = 1,
+  REGION_RANDOM = 2
+};
+
+// The subsystems memory is accounted to, see memoryAllocate
+enum MEMORYTAGS {
+  MEMORY_CELLS = 0,
+  MEMORY_HISTORY = 1,
+  MEMORY_JOURNAL = 2,
+  MEMORY_BLOCKS = 3,
+  MEMORY_TRACKING = 4,
+  MEMORY_SEARCH = 5,
+  MEMORY_SURFACES = 6,
+  MEMORY_RULES = 7,
+  MEMORY_TAGS = 8
+};
+
+// The events kept by the flight recorder
+enum FLIGHTEVENTS {
+  FLIGHT_FRAME = 0,
+  FLIGHT_TURN = 1,
+  FLIGHT_RENDER = 2,
+  FLIGHT_HISTORY = 3,
+  FLIGHT_PAINT = 4,
+  FLIGHT_IMPORT = 5,
+  FLIGHT_SAVE = 6,
+  FLIGHT_STALL = 7
+};
+
 enum COMMANDTYPES {
   CELLSXY = 0,
   COLORTRESHOLD = 1,
@@ -82,7 +234,37 @@ enum COMMANDTYPES {
   DOCREATEHISTORY = 5,
   DRAWINFOPANEL = 6,
   USERANDOM = 7,
-  USECAIRO = 8
+  USECAIRO = 8,
+  UNDOLIMIT = 9,
+  VERIFY = 10,
+  BENCHMARK = 11,
+  BENCHCOMPARE = 12,
+  BENCHTHRESHOLD = 13,
+  RECORDINPUT = 14,
+  REPLAYINPUT = 15,
+  STARTUPREPORT = 16,
+  STALLTHRESHOLD = 17,
+  NEIGHBOURHOOD = 18,
+  RULE = 19,
+  STATETABLE = 20,
+  BIRTHNOISE = 21,
+  DEATHNOISE = 22,
+  RANDOMSEED = 23,
+  WIREWORLD = 24,
+  IMMIGRATION = 25,
+  QUADLIFE = 26,
+  LIFECUBE = 27,
+  ELEMENTARY = 28,
+  LENIA = 29,
+  TURNENGINE = 30
+};
+
+// The states of the cells of a Wireworld playboard
+enum WIRESTATES {
+  WIRE_EMPTY = 0,
+  WIRE_HEAD = 1,
+  WIRE_TAIL = 2,
+  WIRE_COPPER = 3
 };
 
 //------------------------------------------------------------------------------
@@ -112,6 +294,21 @@ typedef struct options {
   int maximumFitCellsForRandom; // Maximum number of cells on random placement
   unsigned int colorThreshold;  // The minimum amount of color a pixel must contain to birth a living cell
   short activePanelItem;        // Which info panel item is active?
+  struct bitBlock* stampPreview; // The pattern stamp shown under the mouse in paint mode, NULL if none
+  int stampX;                   // The cell x location of the stamp preview
+  int stampY;                   // The cell y location of the stamp preview
+  bool hasSelection;            // Is a rectangle of the playboard selected in paint mode?
+  int selectionX;               // The left cell of the selection
+  int selectionY;               // The top cell of the selection
+  int selectionWidth;           // The width of the selection in cells
+  int selectionHeight;          // The height of the selection in cells
+  unsigned int matchCount;      // How many pattern matches of the last search are highlighted
+  struct patternMatch* matches; // The pattern matches of the last search
+  char* trackingSummary;        // The summary of the object tracking for the info panel, NULL if disabled
+  uint64_t randomSeed;          // Fixed seed of the random playboards and fills, 0 seeds by the time
+  bool isFontSelected;          // Is the font face selected, this is deferred until the first text is drawn
+  bool drawMemoryStats;         // Should we draw the memory of each subsystem over the playboard?
+  unsigned int randomBoards;    // How many random playboards were drawn, the counter of the next one
 } options;
 
 // The gameBoard which we refer to for all actions
@@ -128,9 +325,260 @@ typedef struct playBoard {
   unsigned int livingCells; // The total count of living cells
   unsigned int turns;       // The count of turns
   struct cell* cells;       // The data pointer for all cells
+  unsigned int changedCount;  // How many cells changed in the last turn
+  unsigned int* changedIndex; // The cell indexes changed in the last turn, NULL if not collected
+  int neighbourhood;          // Which neighbours are counted, see NEIGHBOURHOODS
+  unsigned int birthRule;     // Bit n is set if a dead cell with n living neighbours is born
+  unsigned int survivalRule;  // Bit n is set if a living cell with n living neighbours survives
+  unsigned char ruleTable[512]; // The next state per 3x3 block, bits NW N NE W C E SW S SE from bit 8 down to 0
+  unsigned char* states;        // The state of each cell for a rule table, NULL until the first rule table turn
+  struct stateTable* stateTable; // The rule table of the turns and colours, NULL for Conway's game
+  uint64_t noiseSeed;           // The seed of the noise after each turn
+  uint64_t birthNoise;          // A dead cell is born by noise if its draw is below, 0 for no noise
+  uint64_t deathNoise;          // A living cell dies by noise if its draw is below, 0 for no noise
+  struct wireWorld* wireWorld;  // The electrons of a Wireworld playboard, NULL for other games
+  struct colourLife* colourLife;  // The colour planes of Immigration and QuadLife, NULL for other games
+  struct lifeCube* lifeCube;    // The voxels of 3D Life shown by a slice or projection, NULL for other games
+  struct elementaryAutomaton* elementary; // The row of a 1D automaton shown as spacetime, NULL for other games
+  struct lenia* lenia;          // The continuous states of Lenia, NULL for other games
+  struct liveList* liveList;    // The sorted living cells of the list turn engine, NULL until its first turn
+  struct autoEngine* autoEngine;  // The engine choice of the auto turn engine, NULL until its first turn
+  struct editJournal* journal;  // The undo journal of the running edit, which records the flipped cells, NULL outside of edits
+  bool isEdited;                // Was a cell set outside of the turns, so engines with own lists rebuild them?
 
 } playBoard;
 
+// A turn engine, every engine has to produce the same playboards as the reference applyTurn
+typedef struct turnEngine {
+  char name[16];                              // The name of the engine used in reports
+  void (*applyTurn)(struct playBoard*, bool); // The function applying one turn
+} turnEngine;
+
+// A neighbourhood with its specialized turn function and its default rule
+typedef struct neighbourhoodKernel {
+  char name[16];                              // The name used by -nb and in reports
+  void (*applyTurn)(struct playBoard*, bool); // The function applying one turn with the rule of the playboard
+  unsigned int birthRule;                     // The default birth rule, see playBoard
+  unsigned int survivalRule;                  // The default survival rule, see playBoard
+} neighbourhoodKernel;
+
+// A multi-state automaton of a Golly .rule or .table file, expanded into the
+// next state of every neighbourhood. A Moore neighbourhood is packed by columns
+// left to right, each column top to bottom, as digits of base stateCount. A von
+// Neumann neighbourhood is packed as N, W, C, E, S.
+typedef struct stateTable {
+  char name[64];                  // The name of the @RULE or the file
+  unsigned int stateCount;        // The states of a cell, 0 is dead
+  int neighbourhood;              // MOORE or VON_NEUMANN
+  unsigned int inputCount;        // The cells of a neighbourhood, 9 or 5
+  unsigned int entryCount;        // stateCount to the power of inputCount
+  unsigned char* transitions;     // The next state of each packed neighbourhood
+  unsigned char colors[256][3];   // The rgb colour of each state
+} stateTable;
+
+// A variable of a rule table, which stands for a set of states
+typedef struct stateVariable {
+  char name[32];                  // The name used in the transitions
+  unsigned int valueCount;        // How many states the variable takes
+  unsigned char values[256];      // The states of the variable
+} stateVariable;
+
+// The state of reading a rule table line by line
+typedef struct stateTableReader {
+  int section;                    // 0 outside of a table, 1 in @TABLE or a .table file, 2 in @COLORS
+  char symmetries[32];            // The symmetries of the transitions, like rotate4reflect
+  unsigned int variableCount;     // How many variables are defined
+  struct stateVariable variables[STATE_TABLE_VARIABLES];
+  unsigned int symmetryCount;     // How many orientations a transition is expanded to
+  unsigned char symmetry[16][8];  // The neighbour each orientation reads, clockwise from N
+  bool isPermuted;                // Are the neighbours permuted in any order?
+} stateTableReader;
+
+// The electrons of a Wireworld playboard, the states of its cells are the
+// states of the playboard, see WIRESTATES. Only the cells around the heads are
+// visited by a turn, the lists hold cell indexes.
+typedef struct wireWorld {
+  unsigned int* heads;            // The electron heads
+  unsigned int headCount;
+  unsigned int* tails;            // The electron tails
+  unsigned int tailCount;
+  unsigned int* reached;          // The copper cells next to a head in this turn
+  unsigned char* headNeighbours;  // The heads next to each cell, 0 outside of a turn
+} wireWorld;
+
+// The colours of the Wireworld states: blue heads, red tails and orange copper
+float wireColors[4][3] = {
+  { 1, 1, 1 },
+  { 0.1, 0.35, 1 },
+  { 0.9, 0.1, 0.1 },
+  { 1, 0.6, 0.1 }
+};
+
+// The colours of Immigration and QuadLife, kept in bit planes of 64 cells per
+// word beside the living cells. A row starts with a new word, the bits past the
+// end of a row stay zero. The colour of a living cell is plane 0 plus twice
+// plane 1, dead cells have colour 0.
+typedef struct colourLife {
+  unsigned int colourCount;   // 2 for Immigration, 4 for QuadLife
+  unsigned int wordsPerRow;   // The words of a row in each plane
+  unsigned int wordCount;     // The words of each plane
+  uint64_t* words;            // All planes in one allocation
+  uint64_t* living;           // The living cells of the last turn, their colours are known
+  uint64_t* planes[2];        // The colour bits of the living cells
+  uint64_t* west[3];          // The living and colour planes, shifted by a cell to the east, so a bit holds its west neighbour
+  uint64_t* east[3];          // The living and colour planes, shifted by a cell to the west, so a bit holds its east neighbour
+  uint64_t* next[3];          // The living and colour planes of the next turn
+  unsigned int imports;       // The images imported so far, each takes the next colour
+  unsigned int pen;           // The colour of painted and stamped cells, the colour of the last image
+} colourLife;
+
+// The colours of Immigration and QuadLife: red, blue, green and yellow
+float colourLifeColors[4][3] = {
+  { 1, 0.2, 0.2 },
+  { 0.2, 0.4, 1 },
+  { 0.2, 0.8, 0.3 },
+  { 1, 0.8, 0.1 }
+};
+
+// The voxels of 3D Life on a cube of the size of the playboard, wrapped on all
+// sides. A row of voxels starts with a new word of 64 voxels, the rows of a
+// plane follow each other and the planes are stacked in z. A voxel is born or
+// survives by the count of its 26 neighbours, within the ranges of the rule.
+typedef struct lifeCube {
+  int size;                   // The voxels of an edge
+  unsigned int wordsPerRow;   // The words of a row of voxels
+  unsigned int wordCount;     // The words of the cube
+  uint64_t* voxels;           // The living voxels
+  uint64_t* next;             // The living voxels of the next turn
+  uint64_t* rowSums[2];       // The bits of the living voxels of each voxel and its west and east neighbour
+  uint64_t* shown;            // The cells shown on the playboard, to find the edits
+  unsigned int survivalLow;   // The least neighbours a living voxel survives with
+  unsigned int survivalHigh;  // The most neighbours a living voxel survives with
+  unsigned int birthLow;      // The least neighbours a dead voxel is born with
+  unsigned int birthHigh;     // The most neighbours a dead voxel is born with
+  int slice;                  // The plane shown on the playboard
+  bool isProjected;           // Show the voxels living in any plane instead of a slice?
+  unsigned int livingVoxels;  // The living voxels of all planes, the shown cells are only a part
+} lifeCube;
+
+// A row of an elementary 1D automaton, 64 cells a word, wrapped at its ends.
+// Bit n of the rule is the next state of a cell whose left neighbour, itself
+// and right neighbour are the bits of n, from high to low, like Wolfram's rule
+// numbers.
+typedef struct elementaryAutomaton {
+  unsigned int rule;          // The rule number from 0 to 255
+  int cells;                  // The cells of the row
+  unsigned int words;         // The words of the row
+  uint64_t* row;              // The cells of the generation
+  uint64_t* left;             // The left neighbour of each cell
+  uint64_t* right;            // The right neighbour of each cell
+  unsigned long long generations; // The generations evolved
+} elementaryAutomaton;
+
+// A plan of the fast Fourier transform of a length, split into its prime
+// factors, each transformed by a stage of the Stockham algorithm. Any length
+// works, large prime factors are slower.
+typedef struct fftPlan {
+  int size;                   // The length of the transform
+  int factors[32];            // The prime factors of the length, a stage each
+  int factorCount;
+  double* rootsRe;            // The roots of unity exp(-2 pi i t / size), real parts
+  double* rootsIm;            // The imaginary parts
+} fftPlan;
+
+// The continuous states of Lenia on the playboard. The neighbourhood is a ring
+// of the radius, weighted by a smooth bump, and the growth function of the
+// weighted sum is a gauss curve around mu of the width sigma.
+typedef struct lenia {
+  int radius;                 // The radius of the kernel in cells
+  double mu;                  // The weighted sum of the neighbours growing the most
+  double sigma;               // The width of the growth around mu
+  double dt;                  // The step of a turn, one by the time resolution
+  int cellsX;                 // The cells of a row
+  int cellsY;                 // The rows
+  double* states;             // The state of each cell from 0 to 1
+  double* spectrumRe;         // The transform of the states, real parts
+  double* spectrumIm;         // The imaginary parts
+  double* kernelRe;           // The transform of the kernel, real parts
+  double* kernelIm;           // The imaginary parts
+  struct fftPlan rowPlan;     // The transform of a row
+  struct fftPlan columnPlan;  // The transform of a column
+} lenia;
+
+// The colour ramp of the Lenia states 0, 0.5 and 1, from purple over blue to yellow
+float leniaRamp[3][3] = {
+  { 0.25, 0.05, 0.45 },
+  { 0.05, 0.55, 1 },
+  { 1, 0.9, 0.2 }
+};
+
+// The rows or columns of Lenia one thread transforms in a turn
+typedef struct leniaBand {
+  struct lenia* lenia;        // The Lenia of the turn
+  int first;                  // The first row or column of the band
+  int end;                    // The row or column after the band
+  int phase;                  // 0 transforms rows, 1 convolves columns, 2 transforms rows back and grows
+  bool isChanged;             // Did a state of the band change?
+} leniaBand;
+
+// The living cells of a playboard as sorted lists, without a cell per field,
+// so memory and turns cost by the living cells only. The rows with living
+// cells are listed from top to bottom, each with the columns of its living
+// cells from left to right. All arrays share one allocation, which grows
+// with the population.
+typedef struct liveList {
+  int cellsX;                 // The cells of a row, the columns wrap around
+  int cellsY;                 // The rows, they wrap around too
+  unsigned int rowCount;      // The rows with living cells
+  unsigned int count;         // The living cells
+  int* rows;                  // The row of each row with living cells, ascending
+  unsigned int* rowStarts;    // The first living cell of each row, rowCount + 1 entries
+  int* columns;               // The column of each living cell, ascending in its row
+  int* nextRows;              // The rows of the next turn, swapped with rows
+  unsigned int* nextRowStarts;  // The first living cells of the next turn
+  int* nextColumns;           // The columns of the next turn
+  int* merged;                // The columns with living cells in three rows around a row
+  unsigned char* mergedCounts;  // The living cells in each merged column, bit 2 if the middle row lives
+  unsigned int* changed;      // The cells of the playboard changed by the last turn
+  unsigned int changedCount;
+  unsigned int rowCapacity;   // The rows the arrays hold
+  unsigned int cellCapacity;  // The living cells the arrays hold
+  void* data;                 // The allocation of all arrays
+} liveList;
+
+// The choice of the auto turn engine between the flat moore engine, which
+// costs by the cells of the playboard, and the list engine, which costs by
+// the living and changed cells. The cost per unit of work of each engine is
+// learned from its own turns, the defaults are close to the benchmarks.
+typedef struct autoEngine {
+  int engine;                 // The engine playing, an index of autoEngines
+  double costs[2];            // The nanoseconds per unit of work of each engine
+  unsigned int favoured;      // The turns in a row the other engine was predicted faster by the margin
+  unsigned int turnsPlayed;   // The turns since the last switch
+  unsigned int switches;      // The switches since the start
+  unsigned int switchTurns;   // Switch after this many turns without timing, 0 to switch by the costs
+  bool isLogged;              // Print each switch?
+} autoEngine;
+
+// The planes of the cube one thread applies a 3D Life turn to
+typedef struct lifeCubeSlab {
+  struct lifeCube* cube;      // The cube of the turn
+  int firstPlane;             // The first plane of the slab
+  int endPlane;               // The plane after the slab
+  bool isSumming;             // Sum the rows, before the planes are counted?
+  unsigned int livingVoxels;  // The living voxels of the slab after the turn
+  bool isChanged;             // Did a voxel of the slab change?
+} lifeCubeSlab;
+
+// The rows of the playboard one thread applies a rule table turn to
+typedef struct stateTableBand {
+  struct playBoard* gameBoard;    // The playboard read
+  struct stateTable* table;       // The rule table applied
+  unsigned char* nextStates;      // The next state of all cells
+  int firstRow;                   // The first row of the band
+  int endRow;                     // The row after the band
+} stateTableBand;
+
 //------------------------------------------------------------------------------
 // Data structures for the game history recording and stats function
 //------------------------------------------------------------------------------
@@ -150,6 +598,195 @@ typedef struct gameHistoryGame {
   struct gameHistoryTurn* turnData;  // History elements, for the turns
 } gameHistoryGame;
 
+//------------------------------------------------------------------------------
+// Data structures for the pattern stamps
+//------------------------------------------------------------------------------
+
+// A bit packed block of cells, bit x of a row is bit (x & 63) of word (x >> 6)
+typedef struct bitBlock {
+  int width;        // The width of the block in cells
+  int height;       // The height of the block in cells
+  int wordsPerRow;  // How many 64 bit words make up one row
+  uint64_t* words;  // The row major bit storage
+} bitBlock;
+
+typedef struct stampPattern {
+  char name[32];          // The display name of the pattern
+  struct bitBlock block;  // The pattern cells in its original orientation
+} stampPattern;
+
+typedef struct stampLibrary {
+  unsigned int count;             // How many patterns are in the library
+  int active;                     // Which pattern is selected for stamping, -1 if we paint single cells
+  int rotation;                   // Clockwise rotation of the active pattern in quarter turns
+  bool flipped;                   // Is the active pattern mirrored horizontally?
+  struct stampPattern* patterns;  // The patterns
+  struct bitBlock oriented;       // The active pattern with rotation and flip applied
+  int clipboard;                  // The index of the pattern holding the copied selection, -1 if nothing was copied
+} stampLibrary;
+
+//------------------------------------------------------------------------------
+// Data structures for the undo journal of playboard edits
+//------------------------------------------------------------------------------
+typedef struct editJournalEntry {
+  unsigned int words;   // Amount of changed words of the packed playboard
+  unsigned int* index;  // The index of each changed word
+  uint64_t* delta;      // The changed words, xor of the word before and after the edit
+} editJournalEntry;
+
+typedef struct editJournal {
+  unsigned int entries;               // How many edits are recorded
+  unsigned int position;              // How many edits are applied, the entries above are redo steps
+  size_t bytes;                       // Memory used by the recorded edits
+  size_t byteLimit;                   // Memory cap, the oldest edits are dropped above it
+  unsigned int* slots;                // For each word of the packed playboard its pending word plus one, 0 if the running edit did not flip it
+  unsigned int slotCount;             // The words of the packed playboard
+  unsigned int* pendingIndex;         // The words flipped by the running edit
+  uint64_t* pendingDelta;             // The flipped cells of each pending word
+  unsigned int pendingCount;          // How many words the running edit flipped
+  unsigned int pendingCapacity;       // How many pending words fit
+  bool isOverflowed;                  // Could a flip of the running edit not be recorded?
+  struct editJournalEntry* entryData; // The recorded edits, oldest first
+} editJournal;
+
+//------------------------------------------------------------------------------
+// Data structures for the pattern search
+//------------------------------------------------------------------------------
+typedef struct patternMatch {
+  int x;              // The left cell of the found pattern
+  int y;              // The top cell of the found pattern
+  int width;          // The width of the found pattern in its orientation
+  int height;         // The height of the found pattern in its orientation
+  short orientation;  // Clockwise quarter turns, plus 4 if the pattern is flipped
+} patternMatch;
+
+//------------------------------------------------------------------------------
+// Data structures for the tracking of moving objects
+//------------------------------------------------------------------------------
+typedef struct trackedObject {
+  unsigned int id;                          // The number of the object, counting up
+  int x;                                    // The left cell of the bounding box on the playboard
+  int y;                                    // The top cell of the bounding box on the playboard
+  int width;                                // The width of the bounding box
+  int height;                               // The height of the bounding box
+  unsigned int population;                  // The living cells of the object
+  unsigned int age;                         // How many generations is the object tracked
+  int period;                               // The detected period, 0 if not yet known
+  int velocityX;                            // The x displacement per period
+  int velocityY;                            // The y displacement per period
+  uint64_t shapeHash[TRACK_HISTORY];        // The hash of the shape per generation, indexed by age
+  uint64_t canonicalHash[TRACK_HISTORY];    // The smallest hash of the shape in its 8 orientations per generation
+  int positionX[TRACK_HISTORY];             // The x position per generation, continued across the wrap
+  int positionY[TRACK_HISTORY];             // The y position per generation, continued across the wrap
+} trackedObject;
+
+typedef struct objectTracker {
+  bool isEnabled;                   // Do we track objects after each turn?
+  unsigned int count;               // How many objects are tracked
+  unsigned int nextId;              // The id given to the next new object
+  unsigned int generation;          // Counter to mark visited cells without clearing
+  struct trackedObject* objects;    // The tracked objects
+  struct trackedObject* detected;   // The objects detected in this generation
+  unsigned int* visited;            // Per cell, the generation the cell was visited in
+  int* queue;                       // Flood fill queue of cell indexes
+  int* queueX;                      // Flood fill queue of x locations, continued across the wrap
+  int* queueY;                      // Flood fill queue of y locations, continued across the wrap
+  char summary[128];                // The summary for the info panel
+} objectTracker;
+
+//------------------------------------------------------------------------------
+// Data structures for the benchmarks
+//------------------------------------------------------------------------------
+typedef struct benchmarkCase {
+  char name[64];                  // The case name, compared between result files
+  char unit[16];                  // What one value measures, like "ns/turn"
+  unsigned int samples;           // How many values are taken
+  double values[BENCH_SAMPLES];   // The measured values, lower is better
+  double percentiles[3];          // The 50th, 90th and 99th percentile of single operations, 0 if not measured
+  double bytes;                   // The bytes read or written per operation, 0 if not measured
+  long peakKilobytes;             // The peak resident memory of the process after the case, 0 if not measured
+} benchmarkCase;
+
+typedef struct benchmarkResult {
+  unsigned int count;             // How many cases are measured
+  struct benchmarkCase* cases;    // The measured cases
+} benchmarkResult;
+
+//------------------------------------------------------------------------------
+// Data structures for the memory accounting
+//------------------------------------------------------------------------------
+
+// Every accounted allocation starts with this header, so it can be resized and freed by its pointer
+typedef union memoryHeader {
+  struct {
+    size_t bytes;             // The bytes requested for the allocation
+    int tag;                  // The subsystem of the allocation
+  } info;
+  long double alignment;      // Keeps the data behind the header aligned like malloc does
+} memoryHeader;
+
+typedef struct memoryAccounting {
+  size_t current[MEMORY_TAGS];  // The bytes in use per subsystem
+  size_t peak[MEMORY_TAGS];     // The most bytes in use at once per subsystem
+  size_t total;                 // The bytes in use of all subsystems
+  size_t totalPeak;             // The most bytes in use at once of all subsystems
+} memoryAccounting;
+
+//------------------------------------------------------------------------------
+// Data structures for the flight recorder
+//------------------------------------------------------------------------------
+typedef struct flightEvent {
+  int type;               // Which event, see FLIGHTEVENTS
+  int value;              // A value of the event, like the turn or the living cells
+  unsigned int frame;     // The frame of the main loop the event happened in
+  Uint64 start;           // Performance counter at the start of the event
+  Uint64 duration;        // Performance counter ticks the event took
+} flightEvent;
+
+typedef struct flightRecorder {
+  struct flightEvent events[FLIGHT_EVENTS];  // The ring of the latest events
+  unsigned long long count;                  // How many events were recorded, the next goes to count % FLIGHT_EVENTS
+  unsigned int frame;                        // The current frame of the main loop
+  Uint64 start;                              // Performance counter at the program start
+  Uint64 frequency;                          // Performance counter ticks per second
+  Uint64 stallTicks;                         // Frames longer than this dump the recorder
+  Uint64 frameStart;                         // Performance counter at the start of the running frame, 0 between frames
+  volatile sig_atomic_t isCrashed;           // Was the crash dump written, a second crash does not dump again
+} flightRecorder;
+
+//------------------------------------------------------------------------------
+// Data structures for the startup timeline
+//------------------------------------------------------------------------------
+typedef struct startupReport {
+  bool isEnabled;                               // Is the report printed after the first frame?
+  Uint64 start;                                 // Performance counter at the program start
+  Uint64 last;                                  // Performance counter at the end of the last phase
+  unsigned int count;                           // How many phases are timed
+  char names[STARTUP_PHASES][32];               // The name of each phase
+  double milliseconds[STARTUP_PHASES];          // The duration of each phase
+} startupReport;
+
+//------------------------------------------------------------------------------
+// Data structures for recording and replaying input sessions
+//------------------------------------------------------------------------------
+typedef struct inputSession {
+  FILE* file;                   // The recording written or replayed, NULL if none
+  bool isReplaying;             // Are the events read from the file instead of SDL?
+  int cellsX;                   // The cells in x of the recorded playboard
+  int cellsY;                   // The cells in y of the recorded playboard
+  uint64_t seed;                // The random seed of the recorded session
+  unsigned int frame;           // The current frame of the main loop
+  unsigned int endFrame;        // The last frame of the recording, known when replaying
+  Uint32 startTicks;            // The ticks at the start of the recording, for the timestamps
+  bool hasPending;              // Was an event read, which waits for its frame?
+  unsigned int pendingFrame;    // The frame of the waiting event
+  SDL_Event pending;            // The waiting event
+  Uint64 frameStart;            // The performance counter at the start of the current frame
+  double* frameTimes;           // The nanoseconds of every replayed frame
+  unsigned int frameCount;      // How many frame times are collected
+  unsigned int frameCapacity;   // For how many frame times is memory reserved
+} inputSession;
+
 //------------------------------------------------------------------------------
 // Functions / Forward declarations
 //------------------------------------------------------------------------------
@@ -163,1106 +800,8998 @@ bool drawGameBoard(SDL_Window*, SDL_Surface*, cairo_surface_t*, cairo_t*, struct
 // Function which applies all game rules on a new turn
 void applyTurn(struct playBoard*, bool);
 
-// Function to fill a board with random cell state
-void initRandomBoard(struct playBoard*, struct options*);
+// Function to apply a turn with the rule of the playboard on the 8 surrounding cells
+void applyTurnMoore(struct playBoard*, bool);
 
-// Set a options message to be diplayed in the game screen (Grid on/off, Animations on/off, Pause/Play)
-void set_options_message(struct options*, char[]);
+// Function to apply a turn with the rule of the playboard on the 6 cells of a hexagonal grid
+void applyTurnHexagonal(struct playBoard*, bool);
 
-// Function to draw living cells with the mouse in painting mode
-void paintCell(SDL_Event*, struct playBoard*, bool);
+// Function to apply a turn with the rule of the playboard on the 4 cells sharing an edge
+void applyTurnVonNeumann(struct playBoard*, bool);
 
-// Function to generate a cell map from a dropped image file
-bool generateCellMapFromImage(char*, struct playBoard*, struct options*);
+// Function to copy the living state of all cells into a byte per cell
+void gatherLiving(struct playBoard*, unsigned char*);
 
-// Function to reset the playboard state
-void resetPlayboard(struct playBoard*);
+// Function to set the next living state of all cells and collect the changes of the turn
+void commitTurn(struct playBoard*, unsigned char*, bool);
 
-// Function to print out the help and usage - display using "cgol -h"...
-void printHelp();
+// Function to parse a rule like B3/S23 into birth and survival bits
+bool parseRule(char*, unsigned int*, unsigned int*);
 
-bool writePNG(SDL_Surface*, struct playBoard*, char*, struct options*);
+// Function to write the birth and survival bits as a rule like B3/S23
+void formatRule(char*, unsigned int, unsigned int);
 
-//------------------------------------------------------------------------------
-// History Functions
+// Function to apply a turn by looking up the next state of each 3x3 block in the rule table of the playboard
+void applyTurnIsotropic(struct playBoard*, bool);
 
-// Function to clear the game history
-bool clearHistory(struct gameHistoryGame*);
+// Function to fill a rule table from birth and survival bits of neighbour counts
+void fillTotalisticTable(unsigned char*, unsigned int, unsigned int);
 
-// Function to add the playboard state to the history
-bool addHistory(struct gameHistoryGame*, struct playBoard*);
+// Function to compile a rule in Hensel notation, like B2-a3/S12, into a rule table
+bool compileRuleTable(char*, unsigned char*);
 
-bool historyBackwards(struct gameHistoryGame*, struct playBoard*);
-bool historyForwards(struct gameHistoryGame*, struct playBoard*);
+// Function to get the Hensel letter of the living neighbours, bit 0 is N going clockwise to NW
+int henselLetterIndex(unsigned int);
 
-// Function to display history data on the playboard
-bool historyDisplayTurn(struct gameHistoryGame*, struct playBoard*);
+// Function to add the hexagon of a cell on a hexagonal playboard to the path, scaled around its center
+void traceHexagon(cairo_t*, struct playBoard*, struct cell*, double);
 
+// Function to set the colour of a cell for drawing, the colour of its state for a rule table
+void setCellColor(cairo_t*, struct playBoard*, unsigned int, double);
 
+// Function to prepare a rule table with its name and default colours
+void initStateTable(struct stateTable*, char*);
 
-//------------------------------------------------------------------------------
-// Functions / Real function content
-//------------------------------------------------------------------------------
+// Function to free the transitions of a rule table
+void freeStateTable(struct stateTable*);
 
+// Function to load a Golly .rule file with a @TABLE section or a .table file
+bool loadStateTable(char*, struct stateTable*);
 
-//------------------------------------------------------------------------------
-// Returns if a neighbour in "direction" (enum) is living
-//------------------------------------------------------------------------------
-bool get_neighbour_living(struct cell* gameCell, struct playBoard* gameBoard, int direction) {
-  // The x and y offset used to determine the index in the cell array, defaulted in case of no change
-  int limitX = gameCell->cellX;
-  int limitY = gameCell->cellY;
+// Function to parse the text of a rule table and expand its transitions
+bool parseStateTable(char*, struct stateTable*);
 
-  // Shift for the offset
-  short calcX = 0;
-  short calcY = 0;
+// Function to read a line of a rule table
+bool readStateTableLine(struct stateTable*, struct stateTableReader*, char*);
 
-  // Check for the direction according to enum
-  switch (direction) {
-    case TOP:
-      calcY = -1;
-      break;
-    case TOP_RIGHT:
-      calcX = 1;
-      calcY = -1;
-      break;
-    case RIGHT:
-      calcX = 1;
-      break;
-    case BOTTOM_RIGHT:
-      calcX = 1;
-      calcY = 1;
-      break;
-    case BOTTOM:
-      calcY = 1;
-      break;
-    case BOTTOM_LEFT:
-      calcX = -1;
-      calcY = 1;
-      break;
-    case LEFT:
-      calcX = -1;
-      break;
-    case TOP_LEFT:
-      calcX = -1;
-      calcY = -1;
-      break;
-    default:
-      return false;
-  }
+// Function to read a variable of a rule table like a={0,1,2}
+bool readStateVariable(struct stateTableReader*, char*);
 
-  // Offset calculation in case shift is present in X
-  if (calcX == -1) {
-    limitX = gameCell->cellX == 0 ? gameBoard->cellsX - 1: gameCell->cellX - 1;
-  } else if (calcX == 1) {
-    limitX = gameCell->cellX == gameBoard->cellsX - 1 ? 0 : gameCell->cellX + 1;
-  }
+// Function to find a variable of a rule table by its name
+int findStateVariable(struct stateTableReader*, char*);
 
-  // Offset calculation in case shift is present in Y
-  if (calcY == -1) {
-    limitY = gameCell->cellY == 0 ? gameBoard->cellsY - 1 : gameCell->cellY - 1;
-  } else if (calcY == 1) {
-    limitY = gameCell->cellY == gameBoard->cellsY - 1 ? 0 : gameCell->cellY + 1;
-  }
+// Function to reserve the transitions and prepare the symmetries of a rule table
+bool prepareStateTable(struct stateTable*, struct stateTableReader*);
 
-  #ifdef DEBUG
-  // The location of a cell in an array, used for debugging only
-  int cellOffset = limitX + (limitY * gameBoard->cellsY);
+// Function to read a transition of a rule table and expand its variables
+bool readStateTransition(struct stateTable*, struct stateTableReader*, char*);
 
-  // This displays, which fields are checked for each direction enum
-  printf("[%d x, %d y] = DIRECTION %d - STATUS: %d @ [%d x, %d y]\n", gameCell->cellX, gameCell->cellY, direction, gameBoard->cells[cellOffset].isLiving, gameBoard->cells[cellOffset].cellX, gameBoard->cells[cellOffset].cellY);
-  #endif
+// Function to store a transition of a rule table in every orientation of its symmetries
+void storeStateTransition(struct stateTable*, struct stateTableReader*, unsigned char*);
 
-  // Return the "isLiving" status of the particular cell in direction at offset in array
-  return gameBoard->cells[limitX + (limitY * gameBoard->cellsY)].isLiving;
-}
+// Function to step to the next greater order of the values
+bool nextPermutation(unsigned char*, unsigned int);
 
-//------------------------------------------------------------------------------
-// Draws the game board and living cells
-//------------------------------------------------------------------------------
-bool drawGameBoard(SDL_Window* appWindow, SDL_Surface* drawingSurface, cairo_surface_t* cairoSurface, cairo_t* drawingContext, struct playBoard* gameBoard, struct options* gameOptions, struct gameHistoryGame* gameHistory) {
+// Function to pack a neighbourhood of a rule table into the index of its transitions
+unsigned int packNeighbourhood(struct stateTable*, unsigned int, unsigned char*);
 
-  // Clear the drawing area with a white background
-  SDL_FillRect(drawingSurface, NULL, SDL_MapRGB(drawingSurface->format, 255, 255, 255));
+// Function to run the work of a count of items, each but the first on its own thread
+void runInThreads(int (*)(void*), const char*, void*, size_t, int);
 
-  // This might not be required, but keeps the SDL surface from changing
-  SDL_LockSurface(drawingSurface);
+// Function to apply a rule table to the rows of a band, the function of a band thread
+int applyStateTableBand(void*);
 
-  // Draw the game playBoard
+// Function to apply a turn with the rule table of the playboard
+void applyTurnStateTable(struct playBoard*, bool);
 
-  // Draw the grid lines
-  if (gameOptions->drawGrid) {
-    // Set the cairo drawing color as rgba value
-    cairo_set_source_rgba(drawingContext, 0, 0, 0, 0.2);
+// Function to draw a random number from the seed, the generation and the cell without any state
+uint64_t counterRandom(uint64_t, uint64_t, uint64_t);
 
-    for (int x = gameBoard->cellWidth; x < gameBoard->width; x += gameBoard->cellWidth) {
-      cairo_move_to(drawingContext, x, 0);
-      cairo_line_to(drawingContext, x, gameBoard->width);
-    }
+// Function to mix the bits of a number
+uint64_t mixBits(uint64_t);
 
-    for (int y = gameBoard->cellHeight; y < gameBoard->height; y += gameBoard->cellHeight) {
-      cairo_move_to(drawingContext, 0, y);
-      cairo_line_to(drawingContext, gameBoard->height, y);
-    }
+// Function to get the draw below which an event of a probability happens
+uint64_t probabilityThreshold(double);
 
-    // Stroke the pathes created with line_to commands
-    cairo_stroke(drawingContext);
-  }
+// Function to flip cells by the noise of the playboard, for turns which do not commit by commitTurn
+void applyNoise(struct playBoard*);
 
-  // Draw the living cells
-  bool isAnimating = false;   // Is any cell animating right now
-  float offX = 0.0;           // Offset in X for position and size when animating
-  float offY = 0.0;           // Offset in Y for postion and size when animating
-  int centerX = 0;
-  int centerY = 0;
-  float animationStepSize = 0.05;
+// Function to flip the next living states of a turn by the noise of the playboard, before they are committed
+void applyNoiseToTurn(struct playBoard*, unsigned char*);
 
-  if (!gameOptions->showAnimations) {
-    cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, 0.75);
-  }
+// Function to apply a Wireworld turn around the electron heads
+void applyTurnWireWorld(struct playBoard*, bool);
 
-  // Draw the living cells as rectangles
-  for (int i = 0; i < gameBoard->cellCount; ++i) {
-    if (gameBoard->cells[i].isLiving) {
-      // The cell is living
+// Function to rebuild the states and electron lists of a Wireworld playboard after edits
+bool rebuildWireWorld(struct playBoard*);
 
-      // If we dont show animations simply draw the rectangle
-      if (!gameOptions->showAnimations) {
-        cairo_rectangle(drawingContext, gameBoard->cells[i].x, gameBoard->cells[i].y, gameBoard->cellWidth, gameBoard->cellHeight);
-        continue;
-      }
+// Function to free the electron lists of a Wireworld playboard
+void freeWireWorld(struct wireWorld*);
 
-      // If we do animate, animate here
-      if (gameBoard->cells[i].size == 1) {
-        cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, 0.75);
-        cairo_rectangle(drawingContext, gameBoard->cells[i].x, gameBoard->cells[i].y, gameBoard->cellWidth, gameBoard->cellHeight);
-        cairo_fill(drawingContext);
-      } else {
-        // Do the animation: Growing with increasing alpha
-        gameBoard->cells[i].size += animationStepSize;
+// Function to allocate the colour planes of Immigration or QuadLife for a playboard
+bool initColourLife(struct playBoard*, struct colourLife*, unsigned int);
 
-        if (gameBoard->cells[i].size >= 1) {
-          gameBoard->cells[i].size = 1;
-          gameBoard->cells[i].cellChanged = false;
-        }
+// Function to free the colour planes of Immigration or QuadLife
+void freeColourLife(struct colourLife*);
 
-        // Set animations to be running
-        isAnimating = true;
+// Function to get the colour of a cell of Immigration or QuadLife, painted cells have the pen colour
+unsigned int getCellColour(struct playBoard*, unsigned int);
 
-        // Animation offset in X and Y and center on cell center
-        offX = round(gameBoard->cellWidth * gameBoard->cells[i].size);
-        offY = round(gameBoard->cellHeight * gameBoard->cells[i].size);
-        centerX = (gameBoard->cellWidth - offX) * 0.5;
-        centerY = (gameBoard->cellHeight - offY) * 0.5;
+// Function to set a cell of Immigration or QuadLife living in a colour
+void setCellColour(struct playBoard*, unsigned int, unsigned int);
 
-        cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, (gameBoard->cells[i].size * 0.5) + 0.25);
-        cairo_rectangle(drawingContext, gameBoard->cells[i].x + centerX, gameBoard->cells[i].y + centerY, offX, offY);
+// Function to update the colour planes after edits: new cells take the pen colour, dead cells lose their colour
+void rebuildColourLife(struct playBoard*);
 
-        // Fill the rectangles / living cells
-        cairo_fill(drawingContext);
-      }
+// Function to shift a row of cells by one cell to the east and to the west, wrapped around the row
+void shiftRow(uint64_t*, uint64_t*, uint64_t*, unsigned int, int);
 
-    } else if (gameOptions->showAnimations && !gameBoard->cells[i].isLiving && gameBoard->cells[i].cellChanged) {
-      // The cell died in an earlier or this turn, shrink animate it
-      gameBoard->cells[i].size -= animationStepSize;
-      isAnimating = true;
+// Function to shift all rows of a colour plane by one cell, wrapped around the playboard
+void shiftPlaneRows(struct colourLife*, int, uint64_t*, uint64_t*, uint64_t*);
 
-      // Animation offset in X and Y and center on cell center
-      offX = round(gameBoard->cellWidth * gameBoard->cells[i].size);
-      offY = round(gameBoard->cellHeight * gameBoard->cells[i].size);
-      centerX = (gameBoard->cellWidth - offX) * 0.5;
-      centerY = (gameBoard->cellHeight - offY) * 0.5;
+// Function to add eight words bitwise, giving four bit planes of the count 0 to 8 of each bit
+void addEightWords(uint64_t*, uint64_t*);
 
-      cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, gameBoard->cells[i].size - 0.25);
-      cairo_rectangle(drawingContext, gameBoard->cells[i].x + centerX, gameBoard->cells[i].y + centerY, offX, offY);
-      cairo_fill(drawingContext);
+// Function to apply a turn of Immigration or QuadLife on the bit planes, newborn cells take the majority colour
+void applyTurnColourLife(struct playBoard*, bool);
 
-      if (gameBoard->cells[i].size <= 0) {
-        gameBoard->cells[i].size = 0;
-        gameBoard->cells[i].cellChanged = false;
-      }
-    }
-  }
+// Function to parse a 3D Life rule in Bays notation, like 4555, into the ranges of the cube
+bool parseCubeRule(char*, struct lifeCube*);
 
-  // If we dont show animations fill the rectangles drawn earlier
-  if (!gameOptions->showAnimations) {
-    cairo_fill(drawingContext);
-  }
+// Function to allocate the voxels of 3D Life for a square playboard
+bool initLifeCube(struct playBoard*, struct lifeCube*);
 
-  // Render turn stats and information panel
-  struct cell* activeCell = NULL;
-  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->currentTurn];
+// Function to free the voxels of 3D Life
+void freeLifeCube(struct lifeCube*);
 
-  // TODO: Create the info panel display
+// Function to clear all voxels of the cube
+void resetLifeCube(struct lifeCube*);
 
+// Function to count the living voxels of all planes of the cube
+void countLifeCube(struct lifeCube*);
 
-  if (gameOptions->drawInfoPanel && gameOptions->doRecordHistory && gameHistory->turns != 0) {
+// Function to fill the cube with random voxels and show them
+void fillLifeCube(struct playBoard*, uint64_t, uint64_t, uint64_t);
 
-    //--------------------------------------------------------------------------
-    if (gameOptions->activePanelItem >= STABLE && gameOptions->activePanelItem <= BORN) {
+// Function to apply the edits of the shown cells to the voxels of the slice
+void applyLifeCubeEdits(struct playBoard*);
+
+// Function to show the slice or projection of the cube on the playboard
+void showLifeCube(struct playBoard*, bool);
+
+// Function to add a number of bit planes to another, 64 bits a word at once
+void addBitPlanes(uint64_t*, int, uint64_t*, int);
+
+// Function to sum the rows or count the neighbours of a slab of planes of the cube, run by a thread
+int applyLifeCubeSlab(void*);
+
+// Function to apply a turn of 3D Life on the voxels of the cube and show it
+void applyTurnLifeCube(struct playBoard*, bool);
+
+// Function to allocate the row of an elementary 1D automaton
+bool initElementaryAutomaton(struct elementaryAutomaton*, int, unsigned int);
+
+// Function to free the row of an elementary 1D automaton
+void freeElementaryAutomaton(struct elementaryAutomaton*);
+
+// Function to evolve the row of an elementary 1D automaton by one generation, 64 cells a word at once
+void evolveElementaryRow(struct elementaryAutomaton*);
+
+// Function to apply a turn of a 1D automaton, the playboard scrolls up and the new generation is the bottom row
+void applyTurnElementary(struct playBoard*, bool);
+
+// Function to plan the fast Fourier transforms of a length
+bool initFFTPlan(struct fftPlan*, int);
+
+// Function to free the roots of a plan of the fast Fourier transform
+void freeFFTPlan(struct fftPlan*);
+
+// Function to transform complex values in place, forward or inverse without scaling
+void transformFFT(struct fftPlan*, double*, double*, double*, double*, bool);
+
+// Function to parse the Lenia parameters radius, mu, sigma and time resolution
+bool parseLeniaParameters(char*, struct lenia*);
+
+// Function to allocate the states of Lenia and transform its kernel
+bool initLenia(struct playBoard*, struct lenia*);
+
+// Function to free the states and transforms of Lenia
+void freeLenia(struct lenia*);
+
+// Function to run a phase of a Lenia turn on a band of rows or columns, run by a thread
+int applyLeniaBand(void*);
+
+// Function to apply a turn of Lenia, convolving the states with the kernel by fast Fourier transforms
+void applyTurnLenia(struct playBoard*, bool);
+
+// Function to make room in a live cell list for rows and living cells
+bool reserveLiveList(struct liveList*, unsigned int, unsigned int);
+
+// Function to free the arrays of a live cell list
+void freeLiveList(struct liveList*);
+
+// Function to add a living cell after all others, in order of rows and columns
+void appendLiveCell(struct liveList*, int, int);
+
+// Function to find the index of a row in a live cell list, -1 if it has no living cells
+int findLiveRow(struct liveList*, int);
+
+// Function to evolve a live cell list by one turn of a Moore rule, merging the lists of neighbouring rows
+bool evolveLiveList(struct liveList*, unsigned int, unsigned int);
+
+// Function to collect the living cells of the playboard into its live cell list
+bool rebuildLiveList(struct playBoard*);
+
+// Function to apply a turn by the live cell list, only the changed cells of the playboard are set
+void applyTurnList(struct playBoard*, bool);
+
+// Function to allocate the engine choice of the auto turn engine, starting with the flat engine
+bool initAutoEngine(struct playBoard*, bool);
+
+// Function to apply a turn by the engine predicted fastest for the population, switching with hysteresis
+void applyTurnAuto(struct playBoard*, bool);
+
+// Function to move the playboard of the auto engine to another engine
+void switchAutoEngine(struct playBoard*, int);
+
+// Function to fill a board with random cell state
+void initRandomBoard(struct playBoard*, struct options*);
+
+// Set a options message to be diplayed in the game screen (Grid on/off, Animations on/off, Pause/Play)
+void set_options_message(struct options*, char[]);
+
+// Function to get the index of the cell under a window position, the cell count if there is none
+unsigned int getCellIndexAt(struct playBoard*, double, double);
+
+// Function to draw living cells with the mouse in painting mode
+void paintCell(SDL_Event*, struct playBoard*, bool);
+
+// Function to generate a cell map from a dropped image file
+bool generateCellMapFromImage(char*, struct playBoard*, struct options*);
+
+// Function to reset the playboard state
+void resetPlayboard(struct playBoard*);
+
+// Function to allocate a playboard of cellsX by cellsY cells drawn on width by height pixels
+bool initPlayBoard(struct playBoard*, int, int, int, int);
+
+// Function to free the cells of a playboard
+void freePlayBoard(struct playBoard*);
+
+// Function to print out the help and usage - display using "cgol -h"...
+void printHelp();
+
+bool writePNG(SDL_Surface*, struct playBoard*, char*, struct options*);
+
+// Function to write one run of a run length encoded pattern
+void writeRLERun(FILE*, int, char, int*);
+
+// Function to write the living cells of the playboard to a run length encoded pattern file
+bool writeRLE(char*, struct playBoard*, char*);
+
+// Function to get a hash of the living cells of the playboard
+uint64_t hashPlayBoard(struct playBoard*);
+
+//------------------------------------------------------------------------------
+// Verification Functions
+
+// Function to run the turn engines in lockstep with the reference engine, returns false if any differed
+bool runVerification(unsigned int);
+
+// Function to copy the living cells of one playboard to another of the same size
+void copyPlayBoard(struct playBoard*, struct playBoard*);
+
+// Function to check if an engine differs from the reference within a count of turns, for a start playboard
+bool enginesDiverge(struct turnEngine*, struct playBoard*, unsigned int, unsigned int*);
+
+// Function to remove living cells of a failing start playboard while the engine still differs
+void shrinkFailure(struct turnEngine*, struct playBoard*, unsigned int);
+
+// Function to get the neighbour offsets of a cell in a row for the hexagonal or von Neumann neighbourhood
+int getNeighbourOffsets(int, int, const int (**)[2]);
+
+//------------------------------------------------------------------------------
+// Benchmark Functions
+
+// Function to run all benchmark cases and write the results to a JSON file
+bool runBenchmark(char*);
+
+// Function to add a case to the benchmark results, returns NULL if out of memory
+struct benchmarkCase* addBenchmarkCase(struct benchmarkResult*, char*, char*);
+
+// Function to free all cases of the benchmark results
+void freeBenchmarkResult(struct benchmarkResult*);
+
+// Function to get the nanoseconds passed since a performance counter value
+double benchmarkNanoseconds(Uint64);
+
+// Function to fill a playboard with random cells of a density of n/256, by a seed
+void fillBenchmarkBoard(struct playBoard*, uint64_t, unsigned int);
+
+// Function to time the turns of all turn engines on dense and sparse playboards
+void benchmarkTurnEngines(struct benchmarkResult*);
+
+// Function to time the live cell list of the list engine on a torus far beyond a playboard
+void benchmarkLiveList(struct benchmarkResult*);
+
+// Function to time the Wireworld turns on the same wires with few and many electrons
+void benchmarkWireWorld(struct benchmarkResult*);
+
+// Function to time the QuadLife turns on the bit planes
+void benchmarkColourLife(struct benchmarkResult*);
+
+// Function to time the 3D Life turns on random cubes
+void benchmarkLifeCube(struct benchmarkResult*);
+
+// Function to time the generations of 1D automata on a long row
+void benchmarkElementary(struct benchmarkResult*);
+
+// Function to time the Lenia turns on random states
+void benchmarkLenia(struct benchmarkResult*);
+
+// Function to time the offscreen rendering of playboards by sizes, densities and drawing options
+void benchmarkRendering(struct benchmarkResult*);
+
+// Function to time appending, seeking and scrubbing the history and get its bytes per turn
+void benchmarkHistory(struct benchmarkResult*);
+
+// Function to time the import of the example images and the png export by cell sizes
+void benchmarkImages(struct benchmarkResult*);
+
+// Function to get the size of a file in bytes, 0 if it cannot be opened
+long fileBytes(char*);
+
+// Function to get the peak resident memory of the process in kilobytes, 0 if unknown
+long peakResidentKilobytes();
+
+// Function to set the playboard to a recorded generation, marking the changed cells like a turn
+void replayGeneration(struct bitBlock*, struct playBoard*);
+
+// Function to get a percentile of values by the nearest rank, the values are sorted
+double percentileOf(double*, unsigned int, double);
+
+// Function to write the benchmark results to a JSON file
+bool writeBenchmarkJSON(char*, struct benchmarkResult*);
+
+// Function to read benchmark results from a JSON file written by writeBenchmarkJSON
+bool readBenchmarkJSON(char*, struct benchmarkResult*);
+
+// Function to compare two doubles for qsort
+int compareDoubles(const void*, const void*);
+
+// Function to get the median of at most BENCH_SAMPLES values
+double medianOf(double*, unsigned int);
+
+// Function to get the bootstrap confidence interval of the speedup between two cases
+void bootstrapSpeedup(struct benchmarkCase*, struct benchmarkCase*, uint64_t*, double*, double*);
+
+// Function to compare two benchmark result files, returns false on a regression
+bool compareBenchmarks(char*, char*, double);
+
+//------------------------------------------------------------------------------
+// Input recording Functions
+
+// Function to start recording the input events of the session to a file
+bool openInputRecording(struct inputSession*, char*, int, int, uint64_t);
+
+// Function to open a recorded input session for replay and read its header
+bool openInputReplay(struct inputSession*, char*);
+
+// Function to write one input event of the current frame to the recording
+void recordInputEvent(struct inputSession*, SDL_Event*);
+
+// Function to read the next event of the recording, returns false at the end
+bool readInputEvent(struct inputSession*);
+
+// Function to get the next replayed event of the current frame, like SDL_PollEvent
+bool nextReplayEvent(struct inputSession*, SDL_Event*);
+
+// Function to count a frame of the main loop and take the time of the last one
+void beginInputFrame(struct inputSession*);
+
+// Function to end the recording or replay, the replay frame times and playboard are reported
+void closeInputSession(struct inputSession*, char*, struct playBoard*);
+
+//------------------------------------------------------------------------------
+// Startup Functions
+
+// Function to end a timed phase of the program start
+void markStartupPhase(struct startupReport*, char*);
+
+// Function to print the timeline of the program start up to the first frame
+void printStartupReport(struct startupReport*);
+
+// Function to init the image loading on the first image import
+bool ensureImageLoading();
+
+// Function to create a directory on the first file written to it
+bool ensureDirectory(char*);
+
+// Function to select the font face before the first text is drawn
+void selectGameFont(cairo_t*, struct options*);
+
+//------------------------------------------------------------------------------
+// Flight recorder Functions
+
+// Function to start the flight recorder and dump it on crashes
+void initFlightRecorder(unsigned int);
+
+// Function to record an event which started at a performance counter value
+void recordFlightEvent(int, Uint64, int);
+
+// Function to count a frame of the main loop and start its timer
+void beginFlightFrame();
+
+// Function to stop the timer of the frame before the main loop idles and dump the recorder if it stalled
+void endFlightFrame();
+
+// Function to write the recorded events to a file, safe to call from a signal handler
+void dumpFlightRecorder(char*, char*);
+
+// Function to append a number to a line of the dump without printf
+void appendFlightNumber(char*, int*, unsigned long long);
+
+// Function to dump the flight recorder on SIGSEGV and SIGABRT
+void flightRecorderSignal(int);
+
+//------------------------------------------------------------------------------
+// Memory accounting Functions
+
+// Function to allocate memory accounted to a subsystem, like malloc
+void* memoryAllocate(int, size_t);
+
+// Function to allocate zeroed memory accounted to a subsystem, like calloc
+void* memoryAllocateZeroed(int, size_t, size_t);
+
+// Function to resize memory accounted to a subsystem, like realloc
+void* memoryResize(int, void*, size_t);
+
+// Function to free memory allocated by memoryAllocate, memoryAllocateZeroed or memoryResize
+void memoryFree(void*);
+
+// Function to account memory allocated by a library, like SDL surfaces, to a subsystem
+void memoryAccount(int, long long);
+
+// Function to format the current and peak bytes of a subsystem as one line
+void formatMemoryLine(char*, int);
+
+// Function to print the memory of every subsystem and the peak resident memory
+void printMemoryReport();
+
+//------------------------------------------------------------------------------
+// History Functions
+
+// Function to clear the game history
+bool clearHistory(struct gameHistoryGame*);
+
+// Function to add the playboard state to the history
+bool addHistory(struct gameHistoryGame*, struct playBoard*);
+
+bool historyBackwards(struct gameHistoryGame*, struct playBoard*);
+bool historyForwards(struct gameHistoryGame*, struct playBoard*);
+
+// Function to display history data on the playboard
+bool historyDisplayTurn(struct gameHistoryGame*, struct playBoard*);
+
+// Function to get the bytes of memory held by the history
+size_t historyMemory(struct gameHistoryGame*);
+
+//------------------------------------------------------------------------------
+// Pattern stamp functions
+
+// Function to allocate a cleared bit block of width x height cells
+bool createBitBlock(struct bitBlock*, int, int);
+
+// Function to free the storage of a bit block
+void freeBitBlock(struct bitBlock*);
+
+// Function to copy a bit block rotated clockwise by quarter turns and optionally mirrored
+bool transformBitBlock(struct bitBlock*, struct bitBlock*, int, bool);
+
+// Function to parse a run length encoded pattern into a bit block
+bool parseRLE(const char*, struct bitBlock*);
+
+// Function to fill the pattern library with the built-in catalog and the patterns directory
+bool initStampLibrary(struct stampLibrary*, char*);
+
+// Function to free the pattern library
+void freeStampLibrary(struct stampLibrary*);
+
+// Function to select a pattern and apply rotation and flip to it
+bool selectStamp(struct stampLibrary*, int, int, bool);
+
+// Function to or-blit a bit block onto the playboard, returns the number of born cells
+unsigned int stampBitBlock(struct bitBlock*, struct playBoard*, int, int);
+
+//------------------------------------------------------------------------------
+// Undo journal functions
+
+// Function to start recording the cells flipped by an edit
+bool beginEdit(struct editJournal*, struct playBoard*);
+
+// Function to record a cell which flips its living state in the running edit
+void journalCell(struct playBoard*, unsigned int);
+
+// Function to record the changed words of an edit, returns false if it was not recorded
+bool commitEdit(struct editJournal*, struct playBoard*);
+
+// Function to free the storage of one journal entry, returns the freed bytes
+size_t freeJournalEntry(struct editJournalEntry*);
+
+// Function to toggle the cells of the changed words of an edit
+void applyJournalEntry(struct editJournalEntry*, struct playBoard*);
+
+// Function to undo the last applied edit
+bool undoEdit(struct editJournal*, struct playBoard*);
+
+// Function to redo the last undone edit
+bool redoEdit(struct editJournal*, struct playBoard*);
+
+// Function to drop all recorded edits
+void clearJournal(struct editJournal*);
+
+// Function to free the journal with the storage of the running edit
+void freeJournal(struct editJournal*);
+
+//------------------------------------------------------------------------------
+// Object tracking functions
+
+// Function to allocate the object tracker for a playboard
+bool initObjectTracker(struct objectTracker*, struct playBoard*);
+
+// Function to free the object tracker
+void freeObjectTracker(struct objectTracker*);
+
+// Function to get the shortest distance of two locations on a wrapped axis
+int wrappedDistance(int, int, int);
+
+// Function to hash a cell of a shape, the hash of a shape is the sum over its cells
+uint64_t hashShapeCell(int, int);
+
+// Function to detect the active objects around the changed cells of the last turn and match them to the tracked ones
+void updateObjectTracker(struct objectTracker*, struct playBoard*);
+
+//------------------------------------------------------------------------------
+// Pattern search functions
+
+// Function to get 64 bits of a packed row starting at a bit offset
+uint64_t rowBitsAt(uint64_t*, int);
+
+// Function to find every occurrence of a pattern in all 8 orientations, returns the number of matches
+unsigned int findPatternMatches(struct playBoard*, struct bitBlock*, struct patternMatch**);
+
+// Function to remove the highlighted pattern matches
+void clearPatternMatches(struct options*);
+
+//------------------------------------------------------------------------------
+// Selection functions
+
+// Function to pack a rectangle of the playboard into a bit block
+bool readBitBlock(struct playBoard*, int, int, int, int, struct bitBlock*);
+
+// Function to replace a rectangle of the playboard with the cells of a bit block
+void writeBitBlock(struct bitBlock*, struct playBoard*, int, int);
+
+// Function to get a random word with each bit set by a probability of n/256
+uint64_t randomDensityWord(uint64_t*, unsigned int);
+
+// Function to set the selected rectangle spanned by two cells, clamped to the playboard
+void setSelection(struct options*, struct playBoard*, int, int, int, int);
+
+// Function to clear, invert or random fill the selected rectangle of the playboard
+bool applyRegionOperation(struct playBoard*, struct options*, int);
+
+// Function to copy the selected rectangle of the playboard into the clipboard pattern
+bool copySelection(struct playBoard*, struct options*, struct stampLibrary*);
+
+//------------------------------------------------------------------------------
+// Turn engines, the first is the reference all others are verified against
+//------------------------------------------------------------------------------
+struct turnEngine turnEngines[] = {
+  { "reference", applyTurn },
+  { "moore", applyTurnMoore },
+  { "isotropic", applyTurnIsotropic },
+  { "table", applyTurnStateTable },
+  { "list", applyTurnList },
+  { "auto", applyTurnAuto }
+};
+
+unsigned int turnEngineCount = sizeof(turnEngines) / sizeof(turnEngines[0]);
+
+//------------------------------------------------------------------------------
+// The turn engines the auto engine switches between, with the default cost of
+// a unit of their work in nanoseconds: a cell for the moore engine, a living
+// or changed cell for the list engine
+//------------------------------------------------------------------------------
+struct turnEngine autoEngines[2] = {
+  { "moore", applyTurnMoore },
+  { "list", applyTurnList }
+};
+
+double autoEngineCosts[2] = { 10, 100 };
+
+// The fixed turns between the switches of new auto engines, 0 to switch by the costs
+unsigned int autoEngineSwitchTurns = 0;
+
+//------------------------------------------------------------------------------
+// Neighbourhoods, indexed by NEIGHBOURHOODS. Moore defaults to Conway's B3/S23,
+// hexagonal to B2/S34 and von Neumann to B23/S2, which keeps random playboards
+// alive with only 4 neighbours.
+//------------------------------------------------------------------------------
+struct neighbourhoodKernel neighbourhoods[NEIGHBOURHOOD_COUNT] = {
+  { "moore", applyTurnMoore, 1 << 3, (1 << 2) | (1 << 3) },
+  { "hexagonal", applyTurnHexagonal, 1 << 2, (1 << 3) | (1 << 4) },
+  { "vonneumann", applyTurnVonNeumann, (1 << 2) | (1 << 3), 1 << 2 }
+};
+
+//------------------------------------------------------------------------------
+// Hensel notation of isotropic rules. Every letter stands for the neighbour
+// configurations of a count, which are equal under rotation and reflection.
+// One configuration per letter is listed for 1 to 4 neighbours, with bit 0 for
+// N going clockwise NE, E, SE, S, SW, W up to bit 7 for NW. 5 to 7 neighbours
+// use the letters of 3 to 1 neighbours for the complement configurations.
+//------------------------------------------------------------------------------
+char henselLetters[] = "cekainyqjrtwz";
+
+unsigned int henselLetterCount[9] = { 1, 2, 6, 10, 13, 10, 6, 2, 1 };
+
+unsigned char henselConfigurations[5][13] = {
+  { 0x00 },
+  { 0x02, 0x01 },
+  { 0x0A, 0x05, 0x09, 0x03, 0x11, 0x22 },
+  { 0x2A, 0x45, 0x25, 0x07, 0x0E, 0x0B, 0x29, 0x23, 0x43, 0x13 },
+  { 0xAA, 0x55, 0x4B, 0x0F, 0x1B, 0x8B, 0x2B, 0x27, 0x53, 0x17, 0x93, 0x63, 0x33 }
+};
+
+//------------------------------------------------------------------------------
+// Conway's game as a rule table, the table turn engine plays it on playboards
+// without a loaded rule table, so it is verified against the reference
+//------------------------------------------------------------------------------
+char conwayStateTableText[] =
+  "n_states:2\n"
+  "neighborhood:Moore\n"
+  "symmetries:permute\n"
+  "var a={0,1}\nvar b={a}\nvar c={a}\nvar d={a}\nvar e={a}\nvar f={a}\nvar g={a}\nvar h={a}\n"
+  "0,1,1,1,0,0,0,0,0,1\n"
+  "1,1,1,0,0,0,0,0,0,1\n"
+  "1,1,1,1,0,0,0,0,0,1\n"
+  "1,a,b,c,d,e,f,g,h,0\n";
+
+struct stateTable conwayStateTable;
+
+//------------------------------------------------------------------------------
+// Memory accounting of the subsystems, names indexed by MEMORYTAGS
+//------------------------------------------------------------------------------
+struct memoryAccounting memoryStats;
+
+char memoryTagNames[MEMORY_TAGS][16] = { "cells", "history", "undo journal", "bit blocks", "tracking", "pattern search", "surfaces", "rule tables" };
+
+//------------------------------------------------------------------------------
+// The flight recorder of the latest events, names indexed by FLIGHTEVENTS
+//------------------------------------------------------------------------------
+struct flightRecorder flightLog;
+
+char flightEventNames[8][8] = { "frame", "turn", "render", "history", "paint", "import", "save", "stall" };
+
+//------------------------------------------------------------------------------
+// Functions / Real function content
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Returns if a neighbour in "direction" (enum) is living
+//------------------------------------------------------------------------------
+bool get_neighbour_living(struct cell* gameCell, struct playBoard* gameBoard, int direction) {
+  // The x and y offset used to determine the index in the cell array, defaulted in case of no change
+  int limitX = gameCell->cellX;
+  int limitY = gameCell->cellY;
+
+  // Shift for the offset
+  short calcX = 0;
+  short calcY = 0;
+
+  // Check for the direction according to enum
+  switch (direction) {
+    case TOP:
+      calcY = -1;
+      break;
+    case TOP_RIGHT:
+      calcX = 1;
+      calcY = -1;
+      break;
+    case RIGHT:
+      calcX = 1;
+      break;
+    case BOTTOM_RIGHT:
+      calcX = 1;
+      calcY = 1;
+      break;
+    case BOTTOM:
+      calcY = 1;
+      break;
+    case BOTTOM_LEFT:
+      calcX = -1;
+      calcY = 1;
+      break;
+    case LEFT:
+      calcX = -1;
+      break;
+    case TOP_LEFT:
+      calcX = -1;
+      calcY = -1;
+      break;
+    default:
+      return false;
+  }
+
+  // Offset calculation in case shift is present in X
+  if (calcX == -1) {
+    limitX = gameCell->cellX == 0 ? gameBoard->cellsX - 1: gameCell->cellX - 1;
+  } else if (calcX == 1) {
+    limitX = gameCell->cellX == gameBoard->cellsX - 1 ? 0 : gameCell->cellX + 1;
+  }
+
+  // Offset calculation in case shift is present in Y
+  if (calcY == -1) {
+    limitY = gameCell->cellY == 0 ? gameBoard->cellsY - 1 : gameCell->cellY - 1;
+  } else if (calcY == 1) {
+    limitY = gameCell->cellY == gameBoard->cellsY - 1 ? 0 : gameCell->cellY + 1;
+  }
+
+  #ifdef DEBUG
+  // The location of a cell in an array, used for debugging only
+  int cellOffset = limitX + (limitY * gameBoard->cellsX);
+
+  // This displays, which fields are checked for each direction enum
+  printf("[%d x, %d y] = DIRECTION %d - STATUS: %d @ [%d x, %d y]\n", gameCell->cellX, gameCell->cellY, direction, gameBoard->cells[cellOffset].isLiving, gameBoard->cells[cellOffset].cellX, gameBoard->cells[cellOffset].cellY);
+  #endif
+
+  // Return the "isLiving" status of the particular cell in direction at offset in array
+  return gameBoard->cells[limitX + (limitY * gameBoard->cellsX)].isLiving;
+}
+
+//------------------------------------------------------------------------------
+// Draws the game board and living cells, without a window into the surface only
+//------------------------------------------------------------------------------
+bool drawGameBoard(SDL_Window* appWindow, SDL_Surface* drawingSurface, cairo_surface_t* cairoSurface, cairo_t* drawingContext, struct playBoard* gameBoard, struct options* gameOptions, struct gameHistoryGame* gameHistory) {
+
+  // Clear the drawing area with a white background
+  SDL_FillRect(drawingSurface, NULL, SDL_MapRGB(drawingSurface->format, 255, 255, 255));
+
+  // This might not be required, but keeps the SDL surface from changing
+  SDL_LockSurface(drawingSurface);
+
+  // Draw the game playBoard
+
+  // A hexagonal playboard draws its cells and grid as hexagons
+  bool isHexagonal = gameBoard->neighbourhood == HEXAGONAL;
+
+  // The cells of a rule table, Wireworld and Lenia have the colours of their states, the cells of Immigration and QuadLife of their planes
+  bool hasStates = (gameBoard->states != NULL && (gameBoard->stateTable != NULL || gameBoard->wireWorld != NULL)) || gameBoard->colourLife != NULL || gameBoard->lenia != NULL;
+
+  // Draw the grid lines
+  if (gameOptions->drawGrid && isHexagonal) {
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 0.2);
+
+    for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+      traceHexagon(drawingContext, gameBoard, &gameBoard->cells[i], 1);
+    }
+
+    cairo_stroke(drawingContext);
+  } else if (gameOptions->drawGrid) {
+    // Set the cairo drawing color as rgba value
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 0.2);
+
+    for (int x = gameBoard->cellWidth; x < gameBoard->width; x += gameBoard->cellWidth) {
+      cairo_move_to(drawingContext, x, 0);
+      cairo_line_to(drawingContext, x, gameBoard->width);
+    }
+
+    for (int y = gameBoard->cellHeight; y < gameBoard->height; y += gameBoard->cellHeight) {
+      cairo_move_to(drawingContext, 0, y);
+      cairo_line_to(drawingContext, gameBoard->height, y);
+    }
+
+    // Stroke the pathes created with line_to commands
+    cairo_stroke(drawingContext);
+  }
+
+  // Draw the living cells
+  bool isAnimating = false;   // Is any cell animating right now
+  float offX = 0.0;           // Offset in X for position and size when animating
+  float offY = 0.0;           // Offset in Y for postion and size when animating
+  int centerX = 0;
+  int centerY = 0;
+  float animationStepSize = 0.05;
+
+  if (!gameOptions->showAnimations) {
+    cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, 0.75);
+  }
+
+  // Draw the living cells as rectangles
+  for (int i = 0; i < gameBoard->cellCount; ++i) {
+    if (gameBoard->cells[i].isLiving) {
+      // The cell is living
+
+      // If we dont show animations simply draw the rectangle
+      if (!gameOptions->showAnimations) {
+        // The cells of a rule table, of Wireworld or of a colour game are filled one by one in their colour
+        if (hasStates) {
+          setCellColor(drawingContext, gameBoard, i, 0.75);
+        }
+
+        if (isHexagonal) {
+          traceHexagon(drawingContext, gameBoard, &gameBoard->cells[i], 1);
+        } else {
+          cairo_rectangle(drawingContext, gameBoard->cells[i].x, gameBoard->cells[i].y, gameBoard->cellWidth, gameBoard->cellHeight);
+        }
+
+        if (hasStates) {
+          cairo_fill(drawingContext);
+        }
+        continue;
+      }
+
+      // If we do animate, animate here
+      if (gameBoard->cells[i].size == 1) {
+        setCellColor(drawingContext, gameBoard, i, 0.75);
+
+        if (isHexagonal) {
+          traceHexagon(drawingContext, gameBoard, &gameBoard->cells[i], 1);
+        } else {
+          cairo_rectangle(drawingContext, gameBoard->cells[i].x, gameBoard->cells[i].y, gameBoard->cellWidth, gameBoard->cellHeight);
+        }
+
+        cairo_fill(drawingContext);
+      } else {
+        // Do the animation: Growing with increasing alpha
+        gameBoard->cells[i].size += animationStepSize;
+
+        if (gameBoard->cells[i].size >= 1) {
+          gameBoard->cells[i].size = 1;
+          gameBoard->cells[i].cellChanged = false;
+        }
+
+        // Set animations to be running
+        isAnimating = true;
+
+        // Animation offset in X and Y and center on cell center
+        offX = round(gameBoard->cellWidth * gameBoard->cells[i].size);
+        offY = round(gameBoard->cellHeight * gameBoard->cells[i].size);
+        centerX = (gameBoard->cellWidth - offX) * 0.5;
+        centerY = (gameBoard->cellHeight - offY) * 0.5;
+
+        setCellColor(drawingContext, gameBoard, i, (gameBoard->cells[i].size * 0.5) + 0.25);
+
+        if (isHexagonal) {
+          traceHexagon(drawingContext, gameBoard, &gameBoard->cells[i], gameBoard->cells[i].size);
+        } else {
+          cairo_rectangle(drawingContext, gameBoard->cells[i].x + centerX, gameBoard->cells[i].y + centerY, offX, offY);
+        }
+
+        // Fill the rectangles / living cells
+        cairo_fill(drawingContext);
+      }
+
+    } else if (gameOptions->showAnimations && !gameBoard->cells[i].isLiving && gameBoard->cells[i].cellChanged) {
+      // The cell died in an earlier or this turn, shrink animate it
+      gameBoard->cells[i].size -= animationStepSize;
+      isAnimating = true;
+
+      // Animation offset in X and Y and center on cell center
+      offX = round(gameBoard->cellWidth * gameBoard->cells[i].size);
+      offY = round(gameBoard->cellHeight * gameBoard->cells[i].size);
+      centerX = (gameBoard->cellWidth - offX) * 0.5;
+      centerY = (gameBoard->cellHeight - offY) * 0.5;
+
+      setCellColor(drawingContext, gameBoard, i, gameBoard->cells[i].size - 0.25);
+
+      if (isHexagonal) {
+        traceHexagon(drawingContext, gameBoard, &gameBoard->cells[i], gameBoard->cells[i].size);
+      } else {
+        cairo_rectangle(drawingContext, gameBoard->cells[i].x + centerX, gameBoard->cells[i].y + centerY, offX, offY);
+      }
+
+      cairo_fill(drawingContext);
+
+      if (gameBoard->cells[i].size <= 0) {
+        gameBoard->cells[i].size = 0;
+        gameBoard->cells[i].cellChanged = false;
+      }
+    }
+  }
+
+  // If we dont show animations fill the rectangles drawn earlier
+  if (!gameOptions->showAnimations) {
+    cairo_fill(drawingContext);
+  }
+
+  // Draw the pattern stamp preview under the mouse in paint mode
+  if (gameOptions->stampPreview != NULL) {
+    struct bitBlock* stamp = gameOptions->stampPreview;
+    int previewX = 0;
+    int previewY = 0;
+
+    cairo_set_source_rgba(drawingContext, 0.2, 0.2, 1, 0.45);
+
+    for (int y = 0; y < stamp->height; ++y) {
+      previewY = (((gameOptions->stampY + y) % gameBoard->cellsY) + gameBoard->cellsY) % gameBoard->cellsY;
+
+      for (int w = 0; w < stamp->wordsPerRow; ++w) {
+        uint64_t bits = stamp->words[(y * stamp->wordsPerRow) + w];
+
+        while (bits != 0) {
+          previewX = (((gameOptions->stampX + (w << 6) + __builtin_ctzll(bits)) % gameBoard->cellsX) + gameBoard->cellsX) % gameBoard->cellsX;
+          bits &= bits - 1;
+
+          cairo_rectangle(drawingContext, previewX * gameBoard->cellWidth, previewY * gameBoard->cellHeight, gameBoard->cellWidth, gameBoard->cellHeight);
+        }
+      }
+    }
+
+    cairo_fill(drawingContext);
+  }
+
+  // Draw the outline of the selected rectangle in paint mode
+  if (gameOptions->hasSelection) {
+    cairo_set_source_rgba(drawingContext, 0.2, 0.2, 1, 0.9);
+    cairo_rectangle(drawingContext, gameOptions->selectionX * gameBoard->cellWidth, gameOptions->selectionY * gameBoard->cellHeight, gameOptions->selectionWidth * gameBoard->cellWidth, gameOptions->selectionHeight * gameBoard->cellHeight);
+    cairo_stroke(drawingContext);
+  }
+
+  // Draw the outlines of the pattern matches found by the last search
+  if (gameOptions->matchCount != 0) {
+    cairo_set_source_rgba(drawingContext, 0, 0.6, 0, 0.9);
+
+    for (unsigned int i = 0; i < gameOptions->matchCount; ++i) {
+      cairo_rectangle(drawingContext, gameOptions->matches[i].x * gameBoard->cellWidth, gameOptions->matches[i].y * gameBoard->cellHeight, gameOptions->matches[i].width * gameBoard->cellWidth, gameOptions->matches[i].height * gameBoard->cellHeight);
+    }
+
+    cairo_stroke(drawingContext);
+  }
+
+  // Render turn stats and information panel
+  struct cell* activeCell = NULL;
+  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->currentTurn];
+
+  // TODO: Create the info panel display
+
+
+  if (gameOptions->drawInfoPanel && gameOptions->doRecordHistory && gameHistory->turns != 0) {
+
+    //--------------------------------------------------------------------------
+    if (gameOptions->activePanelItem >= STABLE && gameOptions->activePanelItem <= BORN) {
       switch (gameOptions->activePanelItem) {
         case STABLE:
           cairo_set_source_rgba(drawingContext, 0.3, 0.3, 0.45, 1);
           break;
-        case BORN:
-          cairo_set_source_rgba(drawingContext, 0.3, 0.3, 0.45, 1);
+        case BORN:
+          cairo_set_source_rgba(drawingContext, 0.3, 0.3, 0.45, 1);
+          break;
+        case DEAD:
+          cairo_set_source_rgba(drawingContext, 0.3, 0.3, 0.45, 1);
+          break;
+        default:
+          break;
+      }
+
+
+
+      for (unsigned int i = 0; i < currentTurn->records; ++i) {
+        if (currentTurn->state[i] == gameOptions->activePanelItem) {
+          activeCell = &gameBoard->cells[currentTurn->index[i]];
+          cairo_rectangle(drawingContext, activeCell->x, activeCell->y, gameBoard->cellWidth, gameBoard->cellHeight);
+        }
+      }
+
+      cairo_fill(drawingContext);
+    }
+
+    //--------------------------------------------------------------------------
+    cairo_set_source_rgba(drawingContext, 1, 1, 1, 0.35);
+    cairo_rectangle(drawingContext, 0, gameBoard->height-100, gameBoard->width, 100);
+    cairo_fill(drawingContext);
+
+    unsigned int highestNum = 0;
+    unsigned int currentNum = 0;
+
+    for (int i = 0; i < 3; ++i) {
+      switch (i) {
+        case 0:
+          currentNum = currentTurn->countBorn;
+          break;
+        case 1:
+          currentNum = currentTurn->countDeath;
+          break;
+        case 2:
+          currentNum = currentTurn->countStable;
+          break;
+        default:
+          break;
+      }
+
+      if (currentNum > highestNum) {
+        highestNum = currentNum;
+      }
+    }
+
+    unsigned int availableSpace = gameBoard->width - 30;
+    cairo_set_source_rgba(drawingContext, 1, 0, 0, 0.8);
+    cairo_rectangle(drawingContext, 15, gameBoard->height-90, availableSpace * ((double) currentTurn->countStable / highestNum), 20);
+    cairo_fill(drawingContext);
+
+    cairo_set_source_rgba(drawingContext, 0, 1, 0, 0.8);
+    cairo_rectangle(drawingContext, 15, gameBoard->height-60, availableSpace * ((double) currentTurn->countBorn / highestNum), 20);
+    cairo_fill(drawingContext);
+
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 0.8);
+    cairo_rectangle(drawingContext, 15, gameBoard->height-30, availableSpace * ((double) currentTurn->countDeath / highestNum), 20);
+    cairo_fill(drawingContext);
+
+    char numberToDisplay[32];
+
+
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
+
+    switch (gameOptions->activePanelItem) {
+      case STABLE:
+        cairo_rectangle(drawingContext, 14, gameBoard->height-91, gameBoard->width - 28, 22);
+        break;
+      case BORN:
+        cairo_rectangle(drawingContext, 14, gameBoard->height-61, gameBoard->width - 28, 22);
+        break;
+      case DEAD:
+        cairo_rectangle(drawingContext, 14, gameBoard->height-31, gameBoard->width - 28, 22);
+        break;
+      default:
+        break;
+    }
+
+    cairo_stroke(drawingContext);
+
+
+
+    //--------------------------------------------------------------------------
+    selectGameFont(drawingContext, gameOptions);
+    cairo_set_source_rgba(drawingContext, 1, 1, 1, 1);
+
+    sprintf(numberToDisplay, "%d stable cells", currentTurn->countStable);
+    cairo_move_to(drawingContext, 20, gameBoard->height-74);
+    cairo_show_text(drawingContext, numberToDisplay);
+
+    sprintf(numberToDisplay, "%d birth/s", currentTurn->countBorn);
+    cairo_move_to(drawingContext, 20, gameBoard->height-44);
+    cairo_show_text(drawingContext, numberToDisplay);
+
+    sprintf(numberToDisplay, "%d death/s", currentTurn->countDeath);
+    cairo_move_to(drawingContext, 20, gameBoard->height-14);
+    cairo_show_text(drawingContext, numberToDisplay);
+  }
+
+  // Show the object tracking summary above the info panel
+  if (gameOptions->drawInfoPanel && gameOptions->trackingSummary != NULL) {
+    int summaryY = gameBoard->height - 24;
+
+    if (gameOptions->doRecordHistory && gameHistory->turns != 0) {
+      summaryY -= 100;
+    }
+
+    cairo_set_source_rgba(drawingContext, 1, 1, 1, 0.35);
+    cairo_rectangle(drawingContext, 0, summaryY, gameBoard->width, 24);
+    cairo_fill(drawingContext);
+
+    selectGameFont(drawingContext, gameOptions);
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
+    cairo_move_to(drawingContext, 20, summaryY + 18);
+    cairo_show_text(drawingContext, gameOptions->trackingSummary);
+  }
+
+  // Show the memory of each subsystem in the top right corner
+  if (gameOptions->drawMemoryStats) {
+    char memoryLine[MEMORY_LINE_LENGTH];
+    int memoryX = gameBoard->width - 380;
+
+    cairo_set_source_rgba(drawingContext, 1, 1, 1, 0.75);
+    cairo_rectangle(drawingContext, memoryX - 10, 0, 390, (MEMORY_TAGS + 2) * 16 + 10);
+    cairo_fill(drawingContext);
+
+    selectGameFont(drawingContext, gameOptions);
+    cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
+    cairo_set_font_size(drawingContext, 12);
+
+    for (int tag = 0; tag <= MEMORY_TAGS; ++tag) {
+      formatMemoryLine(memoryLine, tag);
+      cairo_move_to(drawingContext, memoryX, 18 + tag * 16);
+      cairo_show_text(drawingContext, memoryLine);
+    }
+
+    snprintf(memoryLine, MEMORY_LINE_LENGTH, "%-15s %9ld kB", "peak resident", peakResidentKilobytes());
+    cairo_move_to(drawingContext, memoryX, 18 + (MEMORY_TAGS + 1) * 16);
+    cairo_show_text(drawingContext, memoryLine);
+
+    cairo_set_font_size(drawingContext, 16);
+  }
+
+  // Show a screen message in case we have one to display
+  if (gameOptions->hasMessage) {
+    gameOptions->messageTicks--;
+
+    if (gameOptions->messageTicks < 10) {
+      cairo_set_source_rgba(drawingContext, 0, 0, 0, gameOptions->messageTicks  * 0.1);
+
+      if (gameOptions->messageTicks == 0) {
+        gameOptions->messageTicks = 50;
+        gameOptions->hasMessage = false;
+      }
+    } else {
+      cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
+    }
+
+    selectGameFont(drawingContext, gameOptions);
+    cairo_move_to(drawingContext, 20, 20);
+    cairo_show_text(drawingContext, gameOptions->message);
+  }
+
+  // Paint all data on the cairo drawing surface to merge it into sdl
+  cairo_surface_flush(cairoSurface);
+
+  // Unlock the SDL surface
+  SDL_UnlockSurface(drawingSurface);
+
+  // Update and render the drawingSurface contents to the application window, no window renders offscreen
+  if (appWindow != NULL) {
+    SDL_UpdateWindowSurface(appWindow);
+  }
+
+  return isAnimating;
+}
+
+
+//------------------------------------------------------------------------------
+// Function to set the colour of a cell for drawing. Cells of a rule table or of
+// Wireworld take the colour of their state, cells of Immigration and QuadLife
+// the colour of their planes, cells of Lenia the colour of their state on a
+// ramp, others the red of living cells.
+//------------------------------------------------------------------------------
+void setCellColor(cairo_t* drawingContext, struct playBoard* gameBoard, unsigned int i, double alpha) {
+  // The states of Lenia are mixed between the colours of the ramp, painted cells are fully living
+  if (gameBoard->lenia != NULL) {
+    double state = gameBoard->lenia->states[i] >= LENIA_VISIBLE ? gameBoard->lenia->states[i] : 1;
+    int low = state < 0.5 ? 0 : 1;
+    double share = (state - (low * 0.5)) * 2;
+    float* from = leniaRamp[low];
+    float* to = leniaRamp[low + 1];
+
+    cairo_set_source_rgba(drawingContext, from[0] + ((to[0] - from[0]) * share), from[1] + ((to[1] - from[1]) * share), from[2] + ((to[2] - from[2]) * share), alpha);
+    return;
+  }
+
+  if (gameBoard->colourLife != NULL) {
+    float* color = colourLifeColors[getCellColour(gameBoard, i)];
+    cairo_set_source_rgba(drawingContext, color[0], color[1], color[2], alpha);
+    return;
+  }
+
+  // Wireworld cells painted since the last turn are copper
+  if (gameBoard->wireWorld != NULL && gameBoard->states != NULL) {
+    float* color = wireColors[gameBoard->states[i] != WIRE_EMPTY ? gameBoard->states[i] : WIRE_COPPER];
+    cairo_set_source_rgba(drawingContext, color[0], color[1], color[2], alpha);
+    return;
+  }
+
+  if (gameBoard->stateTable == NULL || gameBoard->states == NULL) {
+    cairo_set_source_rgba(drawingContext, 1, 0.2, 0.2, alpha);
+    return;
+  }
+
+  // Painted cells and dying cells have no living state yet or anymore
+  unsigned char* color = gameBoard->stateTable->colors[gameBoard->states[i] != 0 ? gameBoard->states[i] : 1];
+  cairo_set_source_rgba(drawingContext, color[0] / 255.0, color[1] / 255.0, color[2] / 255.0, alpha);
+}
+
+//------------------------------------------------------------------------------
+// Function to add the hexagon of a cell on a hexagonal playboard to the path.
+// Odd rows are shifted right by half a cell. The hexagons are a third higher
+// than the rows, so the pointed tops and bottoms fill the gaps between the rows.
+// The scale shrinks the hexagon around its center for the animations.
+//------------------------------------------------------------------------------
+void traceHexagon(cairo_t* drawingContext, struct playBoard* gameBoard, struct cell* gameCell, double scale) {
+  double centerX = gameCell->x + (gameBoard->cellWidth * ((gameCell->cellY & 1) ? 1.0 : 0.5));
+  double centerY = gameCell->y + (gameBoard->cellHeight * 0.5);
+  double halfWidth = gameBoard->cellWidth * 0.5 * scale;
+  double thirdHeight = gameBoard->cellHeight / 3.0 * scale;
+
+  cairo_move_to(drawingContext, centerX, centerY - (2 * thirdHeight));
+  cairo_line_to(drawingContext, centerX + halfWidth, centerY - thirdHeight);
+  cairo_line_to(drawingContext, centerX + halfWidth, centerY + thirdHeight);
+  cairo_line_to(drawingContext, centerX, centerY + (2 * thirdHeight));
+  cairo_line_to(drawingContext, centerX - halfWidth, centerY + thirdHeight);
+  cairo_line_to(drawingContext, centerX - halfWidth, centerY - thirdHeight);
+  cairo_close_path(drawingContext);
+}
+
+//------------------------------------------------------------------------------
+// Apply turn and ruleset, returns the number of changes
+//------------------------------------------------------------------------------
+void applyTurn(struct playBoard* gameBoard, bool isInHistory) {
+  gameBoard->isDirty = false;               // Do we have any changes in this round to the playboard? Set the gameboard as staled.
+  bool deathInRound[gameBoard->cellCount];  // Storage for: Which cells die in this turn?
+  bool bornInRound[gameBoard->cellCount];   // Storage for: Which cells start to live in this turn?
+
+  // Set everything to false of above containers
+  memset(deathInRound, false, gameBoard->cellCount);
+  memset(bornInRound, false, gameBoard->cellCount);
+
+  for (int i = 0; i < gameBoard->cellCount; ++i) {
+    int livingNeighbours = 0;   // The number of living neighbours of a cell
+
+    // Check each direction (TOP, TOP_RIGHT, RIGHT... ) round the clock
+    // for living neighbours of the current cell at "i"
+    for (int j = 0; j < 8; ++j) {
+      if (get_neighbour_living(&gameBoard->cells[i], gameBoard, j)) {
+        ++livingNeighbours;
+      }
+    }
+
+    if (gameBoard->cells[i].isLiving) {
+      // The cell is living, handle rule 1 to 3...
+      // Rule 1: Cell dies, if less then 2 living neighbours
+      // Rule 2: Cell continues to live, if 2 or 3 living neighbours
+      // Rule 3: Cell dies if more then 3 living neighbours
+      if (livingNeighbours < 2 || livingNeighbours > 3) {
+        deathInRound[i] = true;
+      }
+    } else if (livingNeighbours == 3) {
+      // Rule 4: Dead cell which has 3 living neighbours is born
+      bornInRound[i] = true;
+    }
+
+    #ifdef DEBUG
+    // Debug output, to print out how many neighbours a particular cell has all togheter
+    printf("[%d, %d] => %d\n", gameBoard->cells[i].cellX, gameBoard->cells[i].cellY, livingNeighbours);
+    #endif
+  }
+
+  #ifdef DEBUG
+  // Just a debug output separator
+  printf("########################################\n\n");
+  #endif
+
+  // Reset the change set of the turn
+  gameBoard->changedCount = 0;
+
+  // Set the status of the cells, according to values of "death" or "born" changes
+  for (int i = 0; i < gameBoard->cellCount; ++i) {
+    if (deathInRound[i]) {
+      gameBoard->cells[i].isLiving = false;   // Cell dies
+      gameBoard->cells[i].cellChanged = true; // The cell changed its status
+      --gameBoard->livingCells;               // Decrease the count of living cells on the playboard
+      gameBoard->isDirty = true;              // Do we have any changes in this round, yes!
+    } else if (bornInRound[i]) {
+      gameBoard->cells[i].isLiving = true;    // Living cell born
+      gameBoard->cells[i].cellChanged = true; // The cell changed its status
+      ++gameBoard->livingCells;               // Increase the count of living cells on the playboard
+      gameBoard->isDirty = true;              // Do we have any changes in this round, yes!
+    } else {
+      gameBoard->cells[i].cellChanged = false;
+      continue;
+    }
+
+    // Collect the changed cell for the analysis of the turn
+    if (gameBoard->changedIndex != NULL) {
+      gameBoard->changedIndex[gameBoard->changedCount++] = i;
+    }
+  }
+
+  // The noise flips cells as part of the turn
+  if (!isInHistory && (gameBoard->birthNoise != 0 || gameBoard->deathNoise != 0)) {
+    applyNoise(gameBoard);
+  }
+
+  // Increase the turn count of playboard by one and avoid overflow
+  if (!isInHistory && ++gameBoard->turns > TURN_LIMIT) {
+    gameBoard->turns = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to copy the living state of all cells into a byte per cell, the
+// kernels read the neighbours from these bytes instead of the large cells
+//------------------------------------------------------------------------------
+void gatherLiving(struct playBoard* gameBoard, unsigned char* living) {
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    living[i] = gameBoard->cells[i].isLiving;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to set the next living state of all cells, like the second pass of
+// applyTurn: the noise flips the next states first, changed cells are marked
+// for the animations and collected for the analysis of the turn, and the turn
+// is counted
+//------------------------------------------------------------------------------
+void commitTurn(struct playBoard* gameBoard, unsigned char* nextLiving, bool isInHistory) {
+  if (!isInHistory && (gameBoard->birthNoise != 0 || gameBoard->deathNoise != 0)) {
+    applyNoiseToTurn(gameBoard, nextLiving);
+  }
+
+  gameBoard->isDirty = false;
+  gameBoard->changedCount = 0;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (gameBoard->cells[i].isLiving == nextLiving[i]) {
+      gameBoard->cells[i].cellChanged = false;
+      continue;
+    }
+
+    // An edit can show cells by a turn, like the random voxels of 3D Life
+    if (gameBoard->journal != NULL) {
+      journalCell(gameBoard, i);
+    }
+
+    gameBoard->cells[i].isLiving = nextLiving[i];
+    gameBoard->cells[i].cellChanged = true;
+    gameBoard->livingCells += nextLiving[i] ? 1 : -1;
+    gameBoard->isDirty = true;
+
+    if (gameBoard->changedIndex != NULL) {
+      gameBoard->changedIndex[gameBoard->changedCount++] = i;
+    }
+  }
+
+  // Increase the turn count of playboard by one and avoid overflow
+  if (!isInHistory && ++gameBoard->turns > TURN_LIMIT) {
+    gameBoard->turns = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn with the rule of the playboard, counting the 8
+// surrounding cells. With the default rule it plays like applyTurn. The rows
+// above and below and the columns left and right are wrapped once per row and
+// cell, instead of per direction like get_neighbour_living.
+//------------------------------------------------------------------------------
+void applyTurnMoore(struct playBoard* gameBoard, bool isInHistory) {
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned char living[gameBoard->cellCount];
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  gatherLiving(gameBoard, living);
+
+  for (int y = 0; y < cellsY; ++y) {
+    unsigned char* above = &living[(y == 0 ? cellsY - 1 : y - 1) * cellsX];
+    unsigned char* row = &living[y * cellsX];
+    unsigned char* below = &living[(y == cellsY - 1 ? 0 : y + 1) * cellsX];
+
+    for (int x = 0; x < cellsX; ++x) {
+      int left = x == 0 ? cellsX - 1 : x - 1;
+      int right = x == cellsX - 1 ? 0 : x + 1;
+      int livingNeighbours = above[left] + above[x] + above[right] + row[left] + row[right] + below[left] + below[x] + below[right];
+      unsigned int rule = row[x] ? gameBoard->survivalRule : gameBoard->birthRule;
+
+      nextLiving[(y * cellsX) + x] = (rule >> livingNeighbours) & 1;
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn with the rule of the playboard on a hexagonal grid.
+// Odd rows are shifted right by half a cell, so a cell has its left and right
+// neighbour and two cells in the rows above and below: x - 1 and x in even
+// rows, x and x + 1 in odd rows. The playboard wraps cleanly with even rows,
+// main rounds an odd row count up.
+//------------------------------------------------------------------------------
+void applyTurnHexagonal(struct playBoard* gameBoard, bool isInHistory) {
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned char living[gameBoard->cellCount];
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  gatherLiving(gameBoard, living);
+
+  for (int y = 0; y < cellsY; ++y) {
+    unsigned char* above = &living[(y == 0 ? cellsY - 1 : y - 1) * cellsX];
+    unsigned char* row = &living[y * cellsX];
+    unsigned char* below = &living[(y == cellsY - 1 ? 0 : y + 1) * cellsX];
+
+    // The shift of the row picks the diagonal neighbours, decided once per row
+    int shift = y & 1;
+
+    for (int x = 0; x < cellsX; ++x) {
+      int left = x == 0 ? cellsX - 1 : x - 1;
+      int right = x == cellsX - 1 ? 0 : x + 1;
+      int diagonalLeft = shift ? x : left;
+      int diagonalRight = shift ? right : x;
+      int livingNeighbours = row[left] + row[right] + above[diagonalLeft] + above[diagonalRight] + below[diagonalLeft] + below[diagonalRight];
+      unsigned int rule = row[x] ? gameBoard->survivalRule : gameBoard->birthRule;
+
+      nextLiving[(y * cellsX) + x] = (rule >> livingNeighbours) & 1;
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn with the rule of the playboard, counting the 4 cells
+// sharing an edge with the cell
+//------------------------------------------------------------------------------
+void applyTurnVonNeumann(struct playBoard* gameBoard, bool isInHistory) {
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned char living[gameBoard->cellCount];
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  gatherLiving(gameBoard, living);
+
+  for (int y = 0; y < cellsY; ++y) {
+    unsigned char* above = &living[(y == 0 ? cellsY - 1 : y - 1) * cellsX];
+    unsigned char* row = &living[y * cellsX];
+    unsigned char* below = &living[(y == cellsY - 1 ? 0 : y + 1) * cellsX];
+
+    for (int x = 0; x < cellsX; ++x) {
+      int left = x == 0 ? cellsX - 1 : x - 1;
+      int right = x == cellsX - 1 ? 0 : x + 1;
+      int livingNeighbours = above[x] + row[left] + row[right] + below[x];
+      unsigned int rule = row[x] ? gameBoard->survivalRule : gameBoard->birthRule;
+
+      nextLiving[(y * cellsX) + x] = (rule >> livingNeighbours) & 1;
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to parse a rule like B3/S23 into birth and survival bits, bit n is
+// set for n living neighbours. Lower case and a missing part are accepted.
+//------------------------------------------------------------------------------
+bool parseRule(char* ruleText, unsigned int* birthRule, unsigned int* survivalRule) {
+  unsigned int* target = NULL;
+
+  *birthRule = 0;
+  *survivalRule = 0;
+
+  for (int i = 0; ruleText[i] != '\0'; ++i) {
+    char c = toupper(ruleText[i]);
+
+    if (c == 'B') {
+      target = birthRule;
+    } else if (c == 'S') {
+      target = survivalRule;
+    } else if (c >= '0' && c <= '8' && target != NULL) {
+      *target |= 1 << (c - '0');
+    } else if (c != '/') {
+      return false;
+    }
+  }
+
+  return target != NULL;
+}
+
+//------------------------------------------------------------------------------
+// Function to write the birth and survival bits as a rule like B3/S23, the
+// text needs room for 21 characters
+//------------------------------------------------------------------------------
+void formatRule(char* ruleText, unsigned int birthRule, unsigned int survivalRule) {
+  int length = 0;
+
+  ruleText[length++] = 'B';
+
+  for (int n = 0; n <= 8; ++n) {
+    if (birthRule & (1 << n)) {
+      ruleText[length++] = '0' + n;
+    }
+  }
+
+  ruleText[length++] = '/';
+  ruleText[length++] = 'S';
+
+  for (int n = 0; n <= 8; ++n) {
+    if (survivalRule & (1 << n)) {
+      ruleText[length++] = '0' + n;
+    }
+  }
+
+  ruleText[length] = '\0';
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn by looking up the next state of each 3x3 block in
+// the rule table of the playboard, which can hold any isotropic rule. The 9 bit
+// index slides along the row: one shift drops the left column and the column
+// right of the cell is added, so a cell costs three reads and a table lookup.
+//------------------------------------------------------------------------------
+void applyTurnIsotropic(struct playBoard* gameBoard, bool isInHistory) {
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned char living[gameBoard->cellCount];
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  gatherLiving(gameBoard, living);
+
+  for (int y = 0; y < cellsY; ++y) {
+    unsigned char* above = &living[(y == 0 ? cellsY - 1 : y - 1) * cellsX];
+    unsigned char* row = &living[y * cellsX];
+    unsigned char* below = &living[(y == cellsY - 1 ? 0 : y + 1) * cellsX];
+
+    // Start with the wrapped last column in the middle and the first column on the right
+    unsigned int index = (above[cellsX - 1] << 7) | (row[cellsX - 1] << 4) | (below[cellsX - 1] << 1) | (above[0] << 6) | (row[0] << 3) | below[0];
+
+    for (int x = 0; x < cellsX; ++x) {
+      int right = x == cellsX - 1 ? 0 : x + 1;
+
+      index = ((index << 1) & 0x1B6) | (above[right] << 6) | (row[right] << 3) | below[right];
+      nextLiving[(y * cellsX) + x] = gameBoard->ruleTable[index];
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to fill a rule table from birth and survival bits of neighbour
+// counts, the table then plays the totalistic rule
+//------------------------------------------------------------------------------
+void fillTotalisticTable(unsigned char* ruleTable, unsigned int birthRule, unsigned int survivalRule) {
+  for (unsigned int index = 0; index < 512; ++index) {
+    int livingNeighbours = __builtin_popcount(index & ~0x10u);
+    unsigned int rule = (index & 0x10) ? survivalRule : birthRule;
+
+    ruleTable[index] = (rule >> livingNeighbours) & 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to get the Hensel letter of the living neighbours, as index in
+// henselLetters. Bit 0 is N going clockwise up to bit 7 for NW. The listed
+// configuration of each letter is compared in all 4 rotations, mirrored and not.
+//------------------------------------------------------------------------------
+int henselLetterIndex(unsigned int neighbours) {
+  int count = __builtin_popcount(neighbours);
+
+  if (count == 0 || count == 8) {
+    return 0;
+  }
+
+  // More than 4 neighbours take the letter of the dead neighbours
+  if (count > 4) {
+    neighbours = ~neighbours & 0xFF;
+    count = 8 - count;
+  }
+
+  for (unsigned int letter = 0; letter < henselLetterCount[count]; ++letter) {
+    unsigned int configuration = henselConfigurations[count][letter];
+
+    for (int rotation = 0; rotation < 4; ++rotation) {
+      unsigned int mirrored = 0;
+
+      // Mirror on the N-S axis: bit i goes to bit (8 - i) % 8
+      for (int i = 0; i < 8; ++i) {
+        mirrored |= ((configuration >> i) & 1) << ((8 - i) & 7);
+      }
+
+      if (neighbours == configuration || neighbours == mirrored) {
+        return letter;
+      }
+
+      // Rotate by a quarter turn, two steps around the ring
+      configuration = ((configuration << 2) | (configuration >> 6)) & 0xFF;
+    }
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Function to compile a rule in Hensel notation into a rule table. A count
+// without letters takes all its configurations, letters take only those and
+// letters after a minus take all but those: B2-a3/S12 is born with 2 living
+// neighbours except the adjacent ones and with 3, survives with 1 and 2.
+// Totalistic rules like B3/S23 are Hensel rules without letters.
+//------------------------------------------------------------------------------
+bool compileRuleTable(char* ruleText, unsigned char* ruleTable) {
+  unsigned int allowed[2][9];   // Per birth and survival and count, bit l is set if letter l is included
+  int part = -1;                // 0 while reading the birth part, 1 for survival
+  int count = -1;               // The count the letters belong to, -1 before the first digit
+  unsigned int letters = 0;     // The letters read for the count
+  bool isNegated = false;       // Was there a minus after the count?
+
+  memset(allowed, 0, sizeof(allowed));
+
+  for (int i = 0; ; ++i) {
+    char c = ruleText[i];
+    char* letter = c != '\0' ? strchr(henselLetters, c) : NULL;
+
+    if (letter != NULL && count != -1 && (unsigned int) (letter - henselLetters) < henselLetterCount[count]) {
+      letters |= 1 << (letter - henselLetters);
+      continue;
+    }
+
+    if (c == '-' && count != -1 && letters == 0 && !isNegated) {
+      isNegated = true;
+      continue;
+    }
+
+    // Any other character ends the letters of the count
+    if (count != -1) {
+      unsigned int all = (1 << henselLetterCount[count]) - 1;
+
+      if (isNegated && letters == 0) {
+        return false;
+      }
+
+      allowed[part][count] |= letters == 0 ? all : isNegated ? all & ~letters : letters;
+      count = -1;
+    }
+
+    if (c == '\0') {
+      break;
+    } else if (c == 'B' || c == 'b') {
+      part = 0;
+    } else if (c == 'S' || c == 's') {
+      part = 1;
+    } else if (c >= '0' && c <= '8' && part != -1) {
+      count = c - '0';
+      letters = 0;
+      isNegated = false;
+    } else if (c != '/') {
+      return false;
+    }
+  }
+
+  if (part == -1) {
+    return false;
+  }
+
+  for (unsigned int index = 0; index < 512; ++index) {
+    // Bits NW N NE W C E SW S SE of the index to the clockwise ring from N
+    unsigned int neighbours = ((index >> 7) & 1) | (((index >> 6) & 1) << 1) | (((index >> 3) & 1) << 2) | ((index & 1) << 3) | (((index >> 1) & 1) << 4) | (((index >> 2) & 1) << 5) | (((index >> 5) & 1) << 6) | (((index >> 8) & 1) << 7);
+
+    ruleTable[index] = (allowed[(index >> 4) & 1][__builtin_popcount(neighbours)] >> henselLetterIndex(neighbours)) & 1;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to prepare a rule table with its name and default colours: dead
+// cells are white, state 1 has the red of living cells and the further states
+// are spread around the colour wheel
+//------------------------------------------------------------------------------
+void initStateTable(struct stateTable* table, char* name) {
+  memset(table, 0, sizeof(struct stateTable));
+  snprintf(table->name, 64, "%s", name);
+  table->neighbourhood = MOORE;
+  table->inputCount = 9;
+
+  table->colors[0][0] = table->colors[0][1] = table->colors[0][2] = 255;
+  table->colors[1][0] = 255;
+  table->colors[1][1] = table->colors[1][2] = 51;
+
+  for (int state = 2; state < 256; ++state) {
+    double hue = fmod(state * 0.618034, 1.0) * 6;
+    double fraction = hue - floor(hue);
+    unsigned char high = 230;
+    unsigned char low = 69;
+    unsigned char rising = low + (high - low) * fraction;
+    unsigned char falling = high - (high - low) * fraction;
+    unsigned char rgb[6][3] = {
+      { high, rising, low }, { falling, high, low }, { low, high, rising },
+      { low, falling, high }, { rising, low, high }, { high, low, falling }
+    };
+
+    memcpy(table->colors[state], rgb[(int) hue], 3);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to free the transitions of a rule table
+//------------------------------------------------------------------------------
+void freeStateTable(struct stateTable* table) {
+  memoryFree(table->transitions);
+  table->transitions = NULL;
+}
+
+//------------------------------------------------------------------------------
+// Function to load a Golly .rule file with a @TABLE section or a .table file
+//------------------------------------------------------------------------------
+bool loadStateTable(char* filename, struct stateTable* table) {
+  FILE* tableFile = fopen(filename, "rb");
+
+  if (tableFile == NULL) {
+    printf("[ERROR] Could not open the rule table \"%s\".\n", filename);
+    return false;
+  }
+
+  // Read in the complete file
+  fseek(tableFile, 0, SEEK_END);
+  long fileSize = ftell(tableFile);
+  fseek(tableFile, 0, SEEK_SET);
+
+  if (fileSize <= 0 || fileSize > PATTERN_FILE_LIMIT) {
+    printf("[ERROR] The rule table \"%s\" is empty or too large.\n", filename);
+    fclose(tableFile);
+    return false;
+  }
+
+  char* tableText = malloc(fileSize + 1);
+
+  if (tableText == NULL) {
+    fclose(tableFile);
+    return false;
+  }
+
+  tableText[fread(tableText, 1, fileSize, tableFile)] = '\0';
+  fclose(tableFile);
+
+  // The filename without folder and extension is the name, unless there is a @RULE
+  char* name = strrchr(filename, '/') != NULL ? strrchr(filename, '/') + 1 : filename;
+  char* fileType = strrchr(name, '.');
+
+  initStateTable(table, "");
+  snprintf(table->name, 64, "%.*s", fileType != NULL ? (int) (fileType - name) : (int) strlen(name), name);
+
+  bool isParsed = parseStateTable(tableText, table);
+
+  if (!isParsed) {
+    printf("[ERROR] The rule table \"%s\" could not be read.\n", filename);
+  }
+
+  free(tableText);
+
+  return isParsed;
+}
+
+//------------------------------------------------------------------------------
+// Function to parse the text of a rule table, the transitions are expanded in
+// the order of the file, so the first transition matching a neighbourhood
+// wins. Neighbourhoods without a transition keep the state of the cell.
+//------------------------------------------------------------------------------
+bool parseStateTable(char* tableText, struct stateTable* table) {
+  struct stateTableReader* reader = malloc(sizeof(struct stateTableReader));
+  unsigned int lineNumber = 0;
+  char* line = tableText;
+
+  if (reader == NULL) {
+    return false;
+  }
+
+  memset(reader, 0, sizeof(struct stateTableReader));
+  reader->section = 1;
+  snprintf(reader->symmetries, 32, "none");
+
+  while (line != NULL) {
+    char* lineEnd = strchr(line, '\n');
+
+    if (lineEnd != NULL) {
+      *lineEnd = '\0';
+    }
+
+    ++lineNumber;
+
+    if (!readStateTableLine(table, reader, line)) {
+      printf("[ERROR] Rule table line %u is not valid.\n", lineNumber);
+      free(reader);
+      freeStateTable(table);
+      return false;
+    }
+
+    line = lineEnd != NULL ? lineEnd + 1 : NULL;
+  }
+
+  free(reader);
+
+  if (table->transitions == NULL) {
+    printf("[ERROR] The rule table has no @TABLE transitions.\n");
+    return false;
+  }
+
+  // Neighbourhoods without a transition keep the state of their center cell
+  unsigned int n = table->stateCount;
+
+  for (unsigned int key = 0; key < table->entryCount; ++key) {
+    if (table->transitions[key] == 0xFF) {
+      table->transitions[key] = table->neighbourhood == VON_NEUMANN ? (key / (n * n)) % n : ((key / (n * n * n)) / n) % n;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to read a line of a rule table: the sections of a .rule file, the
+// colours, the settings, the variables and the transitions
+//------------------------------------------------------------------------------
+bool readStateTableLine(struct stateTable* table, struct stateTableReader* reader, char* line) {
+  // Cut the comment and the line end
+  line[strcspn(line, "#\r")] = '\0';
+
+  if (line[0] == '@') {
+    if (strncmp(line, "@RULE", 5) == 0) {
+      sscanf(line + 5, " %63s", table->name);
+      reader->section = 0;
+    } else {
+      reader->section = strncmp(line, "@TABLE", 6) == 0 ? 1 : strncmp(line, "@COLORS", 7) == 0 ? 2 : 0;
+    }
+
+    return true;
+  }
+
+  if (reader->section == 2) {
+    unsigned int state, red, green, blue;
+
+    if (sscanf(line, "%u %u %u %u", &state, &red, &green, &blue) == 4 && state < 256) {
+      table->colors[state][0] = red < 255 ? red : 255;
+      table->colors[state][1] = green < 255 ? green : 255;
+      table->colors[state][2] = blue < 255 ? blue : 255;
+    }
+
+    return true;
+  }
+
+  if (reader->section != 1) {
+    return true;
+  }
+
+  // Spaces are not significant inside a table
+  int length = 0;
+
+  for (int i = 0; line[i] != '\0'; ++i) {
+    if (!isspace((unsigned char) line[i])) {
+      line[length++] = line[i];
+    }
+  }
+
+  line[length] = '\0';
+
+  if (length == 0) {
+    return true;
+  }
+
+  // The settings come before the first transition
+  if (strncmp(line, "n_states:", 9) == 0) {
+    table->stateCount = strtoul(line + 9, NULL, 10);
+    return table->transitions == NULL;
+  } else if (strncmp(line, "neighborhood:", 13) == 0) {
+    if (strcmp(line + 13, "Moore") == 0) {
+      table->neighbourhood = MOORE;
+      table->inputCount = 9;
+    } else if (strcmp(line + 13, "vonNeumann") == 0) {
+      table->neighbourhood = VON_NEUMANN;
+      table->inputCount = 5;
+    } else {
+      printf("[ERROR] The neighborhood \"%s\" of the rule table is not supported, only Moore and vonNeumann.\n", line + 13);
+      return false;
+    }
+
+    return table->transitions == NULL;
+  } else if (strncmp(line, "symmetries:", 11) == 0) {
+    snprintf(reader->symmetries, 32, "%s", line + 11);
+    return table->transitions == NULL;
+  } else if (strncmp(line, "var", 3) == 0 && strchr(line, '=') != NULL) {
+    return readStateVariable(reader, line + 3);
+  }
+
+  if (table->transitions == NULL && !prepareStateTable(table, reader)) {
+    return false;
+  }
+
+  return readStateTransition(table, reader, line);
+}
+
+//------------------------------------------------------------------------------
+// Function to read a variable like a={0,1,2}, its states can also be given by
+// variables defined before
+//------------------------------------------------------------------------------
+bool readStateVariable(struct stateTableReader* reader, char* text) {
+  char* assignment = strchr(text, '=');
+  size_t textLength = strlen(text);
+
+  if (reader->variableCount == STATE_TABLE_VARIABLES || assignment == text || assignment - text >= 32 || assignment[1] != '{' || text[textLength - 1] != '}') {
+    return false;
+  }
+
+  struct stateVariable* variable = &reader->variables[reader->variableCount];
+  snprintf(variable->name, 32, "%.*s", (int) (assignment - text), text);
+  variable->valueCount = 0;
+  text[textLength - 1] = '\0';
+
+  for (char* element = strtok(assignment + 2, ","); element != NULL; element = strtok(NULL, ",")) {
+    int known = findStateVariable(reader, element);
+
+    if (isdigit((unsigned char) element[0])) {
+      unsigned long state = strtoul(element, NULL, 10);
+
+      if (state > 255 || variable->valueCount == 256) {
+        return false;
+      }
+
+      variable->values[variable->valueCount++] = state;
+    } else if (known != -1 && variable->valueCount + reader->variables[known].valueCount <= 256) {
+      memcpy(&variable->values[variable->valueCount], reader->variables[known].values, reader->variables[known].valueCount);
+      variable->valueCount += reader->variables[known].valueCount;
+    } else {
+      return false;
+    }
+  }
+
+  ++reader->variableCount;
+
+  return variable->valueCount > 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to find a variable of a rule table by its name, the latest
+// definition counts. Returns -1 if there is none.
+//------------------------------------------------------------------------------
+int findStateVariable(struct stateTableReader* reader, char* name) {
+  for (int v = reader->variableCount - 1; v >= 0; --v) {
+    if (strcmp(reader->variables[v].name, name) == 0) {
+      return v;
+    }
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Function to reserve the transitions of a rule table and to prepare the
+// orientations of its symmetries, once the settings are read
+//------------------------------------------------------------------------------
+bool prepareStateTable(struct stateTable* table, struct stateTableReader* reader) {
+  unsigned int ringSize = table->inputCount - 1;
+  unsigned int rotations = 1;
+  unsigned int rotationStep = 0;
+  bool isReflected = false;
+  unsigned long long entryCount = 1;
+
+  if (table->stateCount < 2 || table->stateCount > 255) {
+    printf("[ERROR] The rule table needs n_states from 2 to 255.\n");
+    return false;
+  }
+
+  for (unsigned int i = 0; i < table->inputCount; ++i) {
+    entryCount *= table->stateCount;
+  }
+
+  if (entryCount > STATE_TABLE_ENTRY_LIMIT) {
+    printf("[ERROR] The rule table needs %llu transitions, more than the limit of %d.\n", entryCount, STATE_TABLE_ENTRY_LIMIT);
+    return false;
+  }
+
+  if (strcmp(reader->symmetries, "rotate4") == 0 || strcmp(reader->symmetries, "rotate4reflect") == 0) {
+    rotations = 4;
+    rotationStep = ringSize / 4;
+  } else if (ringSize == 8 && (strcmp(reader->symmetries, "rotate8") == 0 || strcmp(reader->symmetries, "rotate8reflect") == 0)) {
+    rotations = 8;
+    rotationStep = 1;
+  } else if (strcmp(reader->symmetries, "permute") == 0) {
+    reader->isPermuted = true;
+  } else if (strcmp(reader->symmetries, "none") != 0 && strcmp(reader->symmetries, "reflect_horizontal") != 0) {
+    printf("[ERROR] The symmetries \"%s\" of the rule table are not supported.\n", reader->symmetries);
+    return false;
+  }
+
+  isReflected = strstr(reader->symmetries, "reflect") != NULL;
+
+  // Every orientation reads the neighbours rotated and mirrored on the N-S axis
+  reader->symmetryCount = 0;
+
+  for (int reflection = 0; reflection <= (int) isReflected; ++reflection) {
+    for (unsigned int rotation = 0; rotation < rotations; ++rotation) {
+      unsigned char* order = reader->symmetry[reader->symmetryCount++];
+
+      for (unsigned int i = 0; i < ringSize; ++i) {
+        unsigned int from = (i + (rotation * rotationStep)) % ringSize;
+        order[i] = reflection ? (ringSize - from) % ringSize : from;
+      }
+    }
+  }
+
+  table->entryCount = entryCount;
+  table->transitions = memoryAllocate(MEMORY_RULES, table->entryCount);
+
+  if (table->transitions == NULL) {
+    printf("[ERROR] Could not reserve memory for the rule table.\n");
+    return false;
+  }
+
+  // Marks the neighbourhoods without a transition yet
+  memset(table->transitions, 0xFF, table->entryCount);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to read a transition: the center cell, the neighbours clockwise
+// from N and the next state, separated by commas or as single digits. A
+// variable used more than once takes the same state everywhere, the
+// transition is expanded for every combination of its variables.
+//------------------------------------------------------------------------------
+bool readStateTransition(struct stateTable* table, struct stateTableReader* reader, char* line) {
+  char tokens[10][32];
+  unsigned int tokenCount = 0;
+  int variableOf[10];           // The variable of each token, -1 for a state
+  unsigned int slotOf[10];      // The slot of the variable of each token in bound
+  unsigned int bound[10];       // The variables of the transition
+  unsigned int boundCount = 0;
+  unsigned int choice[10];      // The value chosen of each variable
+  unsigned char cells[10];
+
+  if (strchr(line, ',') != NULL) {
+    for (char* token = strtok(line, ","); token != NULL; token = strtok(NULL, ",")) {
+      if (tokenCount == table->inputCount + 1) {
+        return false;
+      }
+
+      snprintf(tokens[tokenCount++], 32, "%s", token);
+    }
+  } else if (strlen(line) == table->inputCount + 1) {
+    for (int i = 0; line[i] != '\0'; ++i) {
+      snprintf(tokens[tokenCount++], 32, "%c", line[i]);
+    }
+  }
+
+  if (tokenCount != table->inputCount + 1) {
+    return false;
+  }
+
+  for (unsigned int t = 0; t < tokenCount; ++t) {
+    variableOf[t] = -1;
+
+    if (isdigit((unsigned char) tokens[t][0])) {
+      unsigned long state = strtoul(tokens[t], NULL, 10);
+
+      if (state >= table->stateCount) {
+        return false;
+      }
+
+      cells[t] = state;
+      continue;
+    }
+
+    variableOf[t] = findStateVariable(reader, tokens[t]);
+
+    if (variableOf[t] == -1) {
+      return false;
+    }
+
+    for (unsigned int v = 0; v < reader->variables[variableOf[t]].valueCount; ++v) {
+      if (reader->variables[variableOf[t]].values[v] >= table->stateCount) {
+        return false;
+      }
+    }
+
+    for (slotOf[t] = 0; slotOf[t] < boundCount && bound[slotOf[t]] != (unsigned int) variableOf[t]; ++slotOf[t]);
+
+    if (slotOf[t] == boundCount) {
+      // The next state can only take a variable of the neighbourhood
+      if (t == table->inputCount) {
+        return false;
+      }
+
+      choice[boundCount] = 0;
+      bound[boundCount++] = variableOf[t];
+    }
+  }
+
+  while (true) {
+    for (unsigned int t = 0; t < tokenCount; ++t) {
+      if (variableOf[t] != -1) {
+        cells[t] = reader->variables[variableOf[t]].values[choice[slotOf[t]]];
+      }
+    }
+
+    storeStateTransition(table, reader, cells);
+
+    // Count through the combinations of the variables
+    unsigned int slot = 0;
+
+    while (slot < boundCount && ++choice[slot] == reader->variables[bound[slot]].valueCount) {
+      choice[slot++] = 0;
+    }
+
+    if (slot == boundCount) {
+      return true;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to store a transition of states in every orientation of the
+// symmetries, neighbourhoods set by an earlier transition are kept
+//------------------------------------------------------------------------------
+void storeStateTransition(struct stateTable* table, struct stateTableReader* reader, unsigned char* cells) {
+  unsigned int ringSize = table->inputCount - 1;
+  unsigned char nextState = cells[table->inputCount];
+  unsigned char ring[8];
+  unsigned char* entry = NULL;
+
+  if (reader->isPermuted) {
+    // Every distinct order of the neighbours, starting with the sorted one
+    memcpy(ring, &cells[1], ringSize);
+
+    for (unsigned int i = 1; i < ringSize; ++i) {
+      for (unsigned int j = i; j > 0 && ring[j - 1] > ring[j]; --j) {
+        unsigned char swap = ring[j];
+        ring[j] = ring[j - 1];
+        ring[j - 1] = swap;
+      }
+    }
+
+    do {
+      entry = &table->transitions[packNeighbourhood(table, cells[0], ring)];
+      *entry = *entry == 0xFF ? nextState : *entry;
+    } while (nextPermutation(ring, ringSize));
+
+    return;
+  }
+
+  for (unsigned int s = 0; s < reader->symmetryCount; ++s) {
+    for (unsigned int i = 0; i < ringSize; ++i) {
+      ring[i] = cells[1 + reader->symmetry[s][i]];
+    }
+
+    entry = &table->transitions[packNeighbourhood(table, cells[0], ring)];
+    *entry = *entry == 0xFF ? nextState : *entry;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to step to the next greater order of the values, returns false
+// after the greatest order
+//------------------------------------------------------------------------------
+bool nextPermutation(unsigned char* values, unsigned int count) {
+  int i = count - 2;
+
+  while (i >= 0 && values[i] >= values[i + 1]) {
+    --i;
+  }
+
+  if (i < 0) {
+    return false;
+  }
+
+  int j = count - 1;
+
+  while (values[j] <= values[i]) {
+    --j;
+  }
+
+  unsigned char swap = values[i];
+  values[i] = values[j];
+  values[j] = swap;
+
+  for (int low = i + 1, high = count - 1; low < high; ++low, --high) {
+    swap = values[low];
+    values[low] = values[high];
+    values[high] = swap;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to pack the center and the neighbours clockwise from N into the
+// index of the transitions, see stateTable
+//------------------------------------------------------------------------------
+unsigned int packNeighbourhood(struct stateTable* table, unsigned int center, unsigned char* ring) {
+  unsigned int n = table->stateCount;
+
+  if (table->neighbourhood == VON_NEUMANN) {
+    return (((((ring[0] * n) + ring[3]) * n + center) * n + ring[1]) * n) + ring[2];
+  }
+
+  unsigned int left = (((ring[7] * n) + ring[6]) * n) + ring[5];
+  unsigned int middle = (((ring[0] * n) + center) * n) + ring[4];
+  unsigned int right = (((ring[1] * n) + ring[2]) * n) + ring[3];
+
+  return (((left * n * n * n) + middle) * n * n * n) + right;
+}
+
+//------------------------------------------------------------------------------
+// Function to run the work of a count of items, like the bands of a turn. The
+// items follow each other in an array, itemSize bytes apart. The first item is
+// run here, each other on its own thread, or here too if the thread can not be
+// created, and all threads are waited for.
+//------------------------------------------------------------------------------
+void runInThreads(int (*work)(void*), const char* name, void* items, size_t itemSize, int count) {
+  SDL_Thread* threads[count];
+
+  for (int t = 1; t < count; ++t) {
+    threads[t] = SDL_CreateThread(work, name, (char*) items + (t * itemSize));
+
+    if (threads[t] == NULL) {
+      work((char*) items + (t * itemSize));
+    }
+  }
+
+  work(items);
+
+  for (int t = 1; t < count; ++t) {
+    if (threads[t] != NULL) {
+      SDL_WaitThread(threads[t], NULL);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a rule table to the rows of a band. A Moore row packs the
+// columns of the three rows once, then every cell combines three of them.
+//------------------------------------------------------------------------------
+int applyStateTableBand(void* data) {
+  struct stateTableBand* band = data;
+  struct stateTable* table = band->table;
+  int cellsX = band->gameBoard->cellsX;
+  int cellsY = band->gameBoard->cellsY;
+  unsigned char* states = band->gameBoard->states;
+  unsigned int n = table->stateCount;
+  unsigned int columnStates = n * n * n;
+  unsigned int columns[cellsX];
+
+  for (int y = band->firstRow; y < band->endRow; ++y) {
+    unsigned char* above = &states[(y == 0 ? cellsY - 1 : y - 1) * cellsX];
+    unsigned char* row = &states[y * cellsX];
+    unsigned char* below = &states[(y == cellsY - 1 ? 0 : y + 1) * cellsX];
+    unsigned char* nextRow = &band->nextStates[y * cellsX];
+
+    if (table->neighbourhood == VON_NEUMANN) {
+      for (int x = 0; x < cellsX; ++x) {
+        int left = x == 0 ? cellsX - 1 : x - 1;
+        int right = x == cellsX - 1 ? 0 : x + 1;
+
+        nextRow[x] = table->transitions[(((((above[x] * n) + row[left]) * n + row[x]) * n + row[right]) * n) + below[x]];
+      }
+
+      continue;
+    }
+
+    for (int x = 0; x < cellsX; ++x) {
+      columns[x] = (((above[x] * n) + row[x]) * n) + below[x];
+    }
+
+    for (int x = 0; x < cellsX; ++x) {
+      int left = x == 0 ? cellsX - 1 : x - 1;
+      int right = x == cellsX - 1 ? 0 : x + 1;
+
+      nextRow[x] = table->transitions[(((columns[left] * columnStates) + columns[x]) * columnStates) + columns[right]];
+    }
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn with the rule table of the playboard, Conway's game
+// as a table if it has none. The rows are split into bands applied by their
+// own threads on large playboards.
+//------------------------------------------------------------------------------
+void applyTurnStateTable(struct playBoard* gameBoard, bool isInHistory) {
+  struct stateTable* table = gameBoard->stateTable;
+
+  if (table == NULL) {
+    if (conwayStateTable.transitions == NULL) {
+      char tableText[sizeof(conwayStateTableText)];
+
+      memcpy(tableText, conwayStateTableText, sizeof(conwayStateTableText));
+      initStateTable(&conwayStateTable, "conway");
+
+      if (!parseStateTable(tableText, &conwayStateTable)) {
+        return;
+      }
+    }
+
+    table = &conwayStateTable;
+  }
+
+  if (gameBoard->states == NULL) {
+    gameBoard->states = memoryAllocateZeroed(MEMORY_CELLS, gameBoard->cellCount, 1);
+
+    if (gameBoard->states == NULL) {
+      printf("[ERROR] Could not reserve memory for the cell states.\n");
+      return;
+    }
+  }
+
+  // Cells painted, dropped or taken from the history only tell if they are living
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (!gameBoard->cells[i].isLiving) {
+      gameBoard->states[i] = 0;
+    } else if (gameBoard->states[i] == 0) {
+      gameBoard->states[i] = 1;
+    }
+  }
+
+  unsigned char nextStates[gameBoard->cellCount];
+  unsigned char nextLiving[gameBoard->cellCount];
+  struct stateTableBand bands[STATE_TABLE_THREADS];
+  int bandCount = SDL_GetCPUCount();
+
+  if (bandCount > STATE_TABLE_THREADS) {
+    bandCount = STATE_TABLE_THREADS;
+  }
+
+  if (bandCount > (int) (gameBoard->cellCount / STATE_TABLE_BAND_CELLS)) {
+    bandCount = gameBoard->cellCount / STATE_TABLE_BAND_CELLS;
+  }
+
+  if (bandCount < 1) {
+    bandCount = 1;
+  }
+
+  for (int b = 0; b < bandCount; ++b) {
+    bands[b].gameBoard = gameBoard;
+    bands[b].table = table;
+    bands[b].nextStates = nextStates;
+    bands[b].firstRow = gameBoard->cellsY * b / bandCount;
+    bands[b].endRow = gameBoard->cellsY * (b + 1) / bandCount;
+  }
+
+  runInThreads(applyStateTableBand, "stateTableBand", bands, sizeof(bands[0]), bandCount);
+
+  bool isStateChanged = false;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    isStateChanged = isStateChanged || gameBoard->states[i] != nextStates[i];
+    gameBoard->states[i] = nextStates[i];
+    nextLiving[i] = nextStates[i] != 0;
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+
+  // A cell changing between two living states changes the playboard too
+  if (isStateChanged) {
+    gameBoard->isDirty = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to draw a random number from a counter: the same seed, generation
+// and cell always give the same number, no matter in which order or on which
+// thread the cells are drawn. The counters are mixed by the finalizer of
+// SplitMix64, once for the generation and once for the cell.
+//------------------------------------------------------------------------------
+uint64_t counterRandom(uint64_t seed, uint64_t generation, uint64_t cell) {
+  uint64_t x = mixBits(seed + (generation * 0x9E3779B97F4A7C15ull));
+
+  return mixBits(x ^ (cell * 0xD1B54A32D192ED03ull));
+}
+
+//------------------------------------------------------------------------------
+// Function to mix the bits of a number, the finalizer of SplitMix64
+//------------------------------------------------------------------------------
+uint64_t mixBits(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ull;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBull;
+  x ^= x >> 31;
+
+  return x;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the draw below which an event of a probability happens
+//------------------------------------------------------------------------------
+uint64_t probabilityThreshold(double probability) {
+  if (probability <= 0) {
+    return 0;
+  } else if (probability >= 1) {
+    return UINT64_MAX;
+  }
+
+  return (uint64_t) (probability * 18446744073709551616.0);
+}
+
+//------------------------------------------------------------------------------
+// Function to flip the next living states of a turn by the noise of the
+// playboard: a dead cell is born and a living cell dies with the probability
+// of its threshold. The draws depend on the seed, the turn and the cell index
+// only, so the loop has no state between the cells and a run repeats with the
+// same seed. commitTurn applies it, so the noise is part of the turn.
+//------------------------------------------------------------------------------
+void applyNoiseToTurn(struct playBoard* gameBoard, unsigned char* nextLiving) {
+  uint64_t seed = gameBoard->noiseSeed;
+  uint64_t generation = gameBoard->turns;
+  uint64_t birthNoise = gameBoard->birthNoise;
+  uint64_t deathNoise = gameBoard->deathNoise;
+  unsigned int flipCount = 0;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    uint64_t draw = counterRandom(seed, generation, i);
+    unsigned char flip = draw < (nextLiving[i] ? deathNoise : birthNoise);
+
+    nextLiving[i] ^= flip;
+    flipCount += flip;
+  }
+
+  // Engines with own lists or states rebuild them from the flipped cells
+  if (flipCount != 0) {
+    gameBoard->isEdited = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to flip cells by the noise of the playboard at the end of a turn
+// which sets the cells itself instead of by commitTurn, with the same draws as
+// applyNoiseToTurn. A flip adds to the changes the turn reported: a flipped
+// cell is added to the changed cells, or removed if the flip undid its change.
+//------------------------------------------------------------------------------
+void applyNoise(struct playBoard* gameBoard) {
+  unsigned char flips[gameBoard->cellCount];
+  uint64_t seed = gameBoard->noiseSeed;
+  uint64_t generation = gameBoard->turns;
+  uint64_t birthNoise = gameBoard->birthNoise;
+  uint64_t deathNoise = gameBoard->deathNoise;
+  bool isUndone = false;
+
+  // Bit 0 flips a dead cell, bit 1 a living one
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    uint64_t draw = counterRandom(seed, generation, i);
+    flips[i] = (draw < birthNoise) | ((draw < deathNoise) << 1);
+  }
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    struct cell* gameCell = &gameBoard->cells[i];
+
+    if (!(flips[i] & (gameCell->isLiving ? 2 : 1))) {
+      flips[i] = 0;
+      continue;
+    }
+
+    gameCell->isLiving = !gameCell->isLiving;
+    gameCell->cellChanged = !gameCell->cellChanged;
+    gameBoard->livingCells += gameCell->isLiving ? 1 : -1;
+    gameBoard->isEdited = true;
+    gameBoard->isDirty = true;
+
+    // Bit 2 marks a change of the turn undone by the flip
+    flips[i] = gameCell->cellChanged ? 0 : 4;
+    isUndone = isUndone || !gameCell->cellChanged;
+
+    if (gameCell->cellChanged && gameBoard->changedIndex != NULL) {
+      gameBoard->changedIndex[gameBoard->changedCount++] = i;
+    }
+  }
+
+  if (isUndone && gameBoard->changedIndex != NULL) {
+    unsigned int kept = 0;
+
+    for (unsigned int c = 0; c < gameBoard->changedCount; ++c) {
+      if (flips[gameBoard->changedIndex[c]] != 4) {
+        gameBoard->changedIndex[kept++] = gameBoard->changedIndex[c];
+      }
+    }
+
+    gameBoard->changedCount = kept;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to rebuild the states and electron lists of a Wireworld playboard,
+// after the cells were edited. A living cell without a state is copper, a
+// cell which is not living anymore is empty.
+//------------------------------------------------------------------------------
+bool rebuildWireWorld(struct playBoard* gameBoard) {
+  struct wireWorld* wire = gameBoard->wireWorld;
+
+  if (wire->heads == NULL) {
+    wire->heads = memoryAllocate(MEMORY_CELLS, sizeof(unsigned int) * gameBoard->cellCount);
+    wire->tails = memoryAllocate(MEMORY_CELLS, sizeof(unsigned int) * gameBoard->cellCount);
+    wire->reached = memoryAllocate(MEMORY_CELLS, sizeof(unsigned int) * gameBoard->cellCount);
+    wire->headNeighbours = memoryAllocateZeroed(MEMORY_CELLS, gameBoard->cellCount, 1);
+  }
+
+  if (gameBoard->states == NULL) {
+    gameBoard->states = memoryAllocateZeroed(MEMORY_CELLS, gameBoard->cellCount, 1);
+  }
+
+  if (wire->heads == NULL || wire->tails == NULL || wire->reached == NULL || wire->headNeighbours == NULL || gameBoard->states == NULL) {
+    printf("[ERROR] Could not reserve memory for the Wireworld electrons.\n");
+    return false;
+  }
+
+  wire->headCount = 0;
+  wire->tailCount = 0;
+
+  // The cells stay living, so no cell changes by a turn
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    gameBoard->cells[i].cellChanged = false;
+
+    if (!gameBoard->cells[i].isLiving) {
+      gameBoard->states[i] = WIRE_EMPTY;
+    } else if (gameBoard->states[i] == WIRE_EMPTY) {
+      gameBoard->states[i] = WIRE_COPPER;
+    } else if (gameBoard->states[i] == WIRE_HEAD) {
+      wire->heads[wire->headCount++] = i;
+    } else if (gameBoard->states[i] == WIRE_TAIL) {
+      wire->tails[wire->tailCount++] = i;
+    }
+  }
+
+  gameBoard->isEdited = false;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a Wireworld turn: heads become tails, tails become copper
+// and copper next to one or two heads becomes a head. Only the neighbours of
+// the heads are visited, so a turn costs by the electrons, not by the copper.
+// The cells stay living, the changed states are collected like a turn.
+//------------------------------------------------------------------------------
+void applyTurnWireWorld(struct playBoard* gameBoard, bool isInHistory) {
+  struct wireWorld* wire = gameBoard->wireWorld;
+
+  if ((gameBoard->isEdited || wire->heads == NULL) && !rebuildWireWorld(gameBoard)) {
+    return;
+  }
+
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned char* states = gameBoard->states;
+  unsigned int reachedCount = 0;
+
+  // Count the heads next to each copper cell, collecting the copper reached
+  for (unsigned int h = 0; h < wire->headCount; ++h) {
+    int x = wire->heads[h] % cellsX;
+    int y = wire->heads[h] / cellsX;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+      int row = (y + dy + cellsY) % cellsY;
+
+      for (int dx = -1; dx <= 1; ++dx) {
+        unsigned int neighbour = (row * cellsX) + ((x + dx + cellsX) % cellsX);
+
+        if (states[neighbour] == WIRE_COPPER && wire->headNeighbours[neighbour]++ == 0) {
+          wire->reached[reachedCount++] = neighbour;
+        }
+      }
+    }
+  }
+
+  gameBoard->changedCount = 0;
+
+  // Tails become copper and heads become tails
+  for (unsigned int t = 0; t < wire->tailCount; ++t) {
+    states[wire->tails[t]] = WIRE_COPPER;
+    gameBoard->changedIndex[gameBoard->changedCount++] = wire->tails[t];
+  }
+
+  for (unsigned int h = 0; h < wire->headCount; ++h) {
+    states[wire->heads[h]] = WIRE_TAIL;
+    gameBoard->changedIndex[gameBoard->changedCount++] = wire->heads[h];
+  }
+
+  unsigned int* tails = wire->tails;
+  wire->tails = wire->heads;
+  wire->tailCount = wire->headCount;
+  wire->heads = tails;
+  wire->headCount = 0;
+
+  // Copper next to one or two heads becomes a head
+  for (unsigned int r = 0; r < reachedCount; ++r) {
+    unsigned int cell = wire->reached[r];
+
+    if (wire->headNeighbours[cell] <= 2) {
+      states[cell] = WIRE_HEAD;
+      wire->heads[wire->headCount++] = cell;
+      gameBoard->changedIndex[gameBoard->changedCount++] = cell;
+    }
+
+    wire->headNeighbours[cell] = 0;
+  }
+
+  gameBoard->isDirty = gameBoard->changedCount > 0;
+
+  // Increase the turn count of playboard by one and avoid overflow
+  if (!isInHistory && ++gameBoard->turns > TURN_LIMIT) {
+    gameBoard->turns = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to free the electron lists of a Wireworld playboard
+//------------------------------------------------------------------------------
+void freeWireWorld(struct wireWorld* wire) {
+  memoryFree(wire->heads);
+  memoryFree(wire->tails);
+  memoryFree(wire->reached);
+  memoryFree(wire->headNeighbours);
+  memset(wire, 0, sizeof(struct wireWorld));
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the colour planes of Immigration, with 2 colours, or
+// QuadLife, with 4 colours, and attach them to the playboard
+//------------------------------------------------------------------------------
+bool initColourLife(struct playBoard* gameBoard, struct colourLife* colours, unsigned int colourCount) {
+  colours->colourCount = colourCount;
+  colours->wordsPerRow = (gameBoard->cellsX + 63) >> 6;
+  colours->wordCount = colours->wordsPerRow * gameBoard->cellsY;
+  colours->imports = 0;
+  colours->pen = 0;
+  colours->words = memoryAllocateZeroed(MEMORY_CELLS, (size_t) colours->wordCount * 12, sizeof(uint64_t));
+
+  if (colours->words == NULL) {
+    printf("[ERROR] Could not reserve memory for the colour planes.\n");
+    return false;
+  }
+
+  colours->living = colours->words;
+  colours->planes[0] = colours->words + colours->wordCount;
+  colours->planes[1] = colours->words + (2 * colours->wordCount);
+
+  for (int p = 0; p < 3; ++p) {
+    colours->west[p] = colours->words + ((3 + p) * colours->wordCount);
+    colours->east[p] = colours->words + ((6 + p) * colours->wordCount);
+    colours->next[p] = colours->words + ((9 + p) * colours->wordCount);
+  }
+
+  gameBoard->colourLife = colours;
+  gameBoard->isEdited = true;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the colour planes of Immigration or QuadLife
+//------------------------------------------------------------------------------
+void freeColourLife(struct colourLife* colours) {
+  memoryFree(colours->words);
+  memset(colours, 0, sizeof(struct colourLife));
+}
+
+//------------------------------------------------------------------------------
+// Function to get the colour of a cell of Immigration or QuadLife. Cells which
+// became living outside of a turn have the pen colour until the next turn.
+//------------------------------------------------------------------------------
+unsigned int getCellColour(struct playBoard* gameBoard, unsigned int i) {
+  struct colourLife* colours = gameBoard->colourLife;
+  unsigned int word = ((i / gameBoard->cellsX) * colours->wordsPerRow) + ((i % gameBoard->cellsX) >> 6);
+  unsigned int bit = (i % gameBoard->cellsX) & 63;
+
+  if (!((colours->living[word] >> bit) & 1)) {
+    return colours->pen;
+  }
+
+  return ((colours->planes[0][word] >> bit) & 1) | (((colours->planes[1][word] >> bit) & 1) << 1);
+}
+
+//------------------------------------------------------------------------------
+// Function to set a cell of Immigration or QuadLife living in a colour
+//------------------------------------------------------------------------------
+void setCellColour(struct playBoard* gameBoard, unsigned int i, unsigned int colour) {
+  struct colourLife* colours = gameBoard->colourLife;
+  unsigned int word = ((i / gameBoard->cellsX) * colours->wordsPerRow) + ((i % gameBoard->cellsX) >> 6);
+  uint64_t bit = 1ull << ((i % gameBoard->cellsX) & 63);
+
+  if (!gameBoard->cells[i].isLiving) {
+    journalCell(gameBoard, i);
+    gameBoard->cells[i].isLiving = true;
+    gameBoard->cells[i].cellChanged = true;
+    ++gameBoard->livingCells;
+  }
+
+  colours->living[word] |= bit;
+  colours->planes[0][word] = (colour & 1) ? colours->planes[0][word] | bit : colours->planes[0][word] & ~bit;
+  colours->planes[1][word] = (colour & 2) ? colours->planes[1][word] | bit : colours->planes[1][word] & ~bit;
+}
+
+//------------------------------------------------------------------------------
+// Function to update the colour planes after the cells were edited. Cells
+// which became living take the pen colour, dead cells lose their colour.
+//------------------------------------------------------------------------------
+void rebuildColourLife(struct playBoard* gameBoard) {
+  struct colourLife* colours = gameBoard->colourLife;
+  uint64_t penPlanes[2] = { (colours->pen & 1) ? ~0ull : 0, (colours->pen & 2) ? ~0ull : 0 };
+
+  for (int y = 0; y < gameBoard->cellsY; ++y) {
+    for (unsigned int w = 0; w < colours->wordsPerRow; ++w) {
+      unsigned int word = (y * colours->wordsPerRow) + w;
+      uint64_t living = 0;
+
+      for (int x = w << 6; x < gameBoard->cellsX && x < (int) (w + 1) << 6; ++x) {
+        living |= (uint64_t) gameBoard->cells[(y * gameBoard->cellsX) + x].isLiving << (x & 63);
+      }
+
+      uint64_t added = living & ~colours->living[word];
+
+      for (int p = 0; p < 2; ++p) {
+        colours->planes[p][word] = (colours->planes[p][word] & living & ~added) | (penPlanes[p] & added);
+      }
+
+      colours->living[word] = living;
+    }
+  }
+
+  gameBoard->isEdited = false;
+}
+
+//------------------------------------------------------------------------------
+// Function to shift a row of cells, 64 a word, by one cell to the east, so every
+// bit holds its west neighbour, and by one cell to the west, so every bit holds
+// its east neighbour. The cells leaving the row come back at its other end.
+//------------------------------------------------------------------------------
+void shiftRow(uint64_t* source, uint64_t* west, uint64_t* east, unsigned int words, int cellsX) {
+  unsigned int last = words - 1;
+  unsigned int lastBit = (cellsX - 1) & 63;
+  uint64_t lastMask = lastBit == 63 ? ~0ull : (1ull << (lastBit + 1)) - 1;
+
+  for (unsigned int w = 0; w < words; ++w) {
+    west[w] = (source[w] << 1) | (w > 0 ? source[w - 1] >> 63 : 0);
+    east[w] = (source[w] >> 1) | (w < last ? source[w + 1] << 63 : 0);
+  }
+
+  west[last] &= lastMask;
+  west[0] |= (source[last] >> lastBit) & 1;
+  east[last] |= (source[0] & 1) << lastBit;
+}
+
+//------------------------------------------------------------------------------
+// Function to shift all rows of a colour plane, see shiftRow
+//------------------------------------------------------------------------------
+void shiftPlaneRows(struct colourLife* colours, int cellsX, uint64_t* plane, uint64_t* west, uint64_t* east) {
+  for (unsigned int row = 0; row < colours->wordCount; row += colours->wordsPerRow) {
+    shiftRow(&plane[row], &west[row], &east[row], colours->wordsPerRow, cellsX);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to add eight words bitwise with full adders, every bit position is
+// counted on its own. The sums are the four bit planes of the counts 0 to 8.
+//------------------------------------------------------------------------------
+void addEightWords(uint64_t* words, uint64_t* sums) {
+  // Three groups of ones, each giving a one and a two
+  uint64_t onesA = words[0] ^ words[1] ^ words[2];
+  uint64_t twosA = (words[0] & words[1]) | (words[2] & (words[0] ^ words[1]));
+  uint64_t onesB = words[3] ^ words[4] ^ words[5];
+  uint64_t twosB = (words[3] & words[4]) | (words[5] & (words[3] ^ words[4]));
+  uint64_t onesC = words[6] ^ words[7];
+  uint64_t twosC = words[6] & words[7];
+
+  // The ones of the groups, carrying a two
+  uint64_t twosD = (onesA & onesB) | (onesC & (onesA ^ onesB));
+  sums[0] = onesA ^ onesB ^ onesC;
+
+  // The twos of the groups and the carry, carrying fours
+  uint64_t twosE = twosA ^ twosB ^ twosC;
+  uint64_t foursA = (twosA & twosB) | (twosC & (twosA ^ twosB));
+  uint64_t foursB = twosE & twosD;
+  sums[1] = twosE ^ twosD;
+
+  sums[2] = foursA ^ foursB;
+  sums[3] = foursA & foursB;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn of Immigration or QuadLife. The living cells play
+// the rule of the playboard, 64 cells a word: the living neighbours are counted
+// with full adders over the shifted living planes. A cell is born by three
+// parents, it takes the colour most of them have, which is the majority of
+// each colour bit. Three parents of different colours in QuadLife give the
+// fourth colour, the exclusive or of their colours. The parents of each colour
+// are counted like the neighbours, modulo 4, in the same pass.
+//------------------------------------------------------------------------------
+void applyTurnColourLife(struct playBoard* gameBoard, bool isInHistory) {
+  struct colourLife* colours = gameBoard->colourLife;
+
+  if (gameBoard->isEdited) {
+    rebuildColourLife(gameBoard);
+  }
+
+  int cellsX = gameBoard->cellsX;
+  int cellsY = gameBoard->cellsY;
+  unsigned int words = colours->wordsPerRow;
+  unsigned int lastBit = (cellsX - 1) & 63;
+  uint64_t lastMask = lastBit == 63 ? ~0ull : (1ull << (lastBit + 1)) - 1;
+  uint64_t* center[3] = { colours->living, colours->planes[0], colours->planes[1] };
+
+  for (int p = 0; p < 3; ++p) {
+    shiftPlaneRows(colours, cellsX, center[p], colours->west[p], colours->east[p]);
+  }
+
+  for (int y = 0; y < cellsY; ++y) {
+    unsigned int above = (y == 0 ? cellsY - 1 : y - 1) * words;
+    unsigned int row = y * words;
+    unsigned int below = (y == cellsY - 1 ? 0 : y + 1) * words;
+
+    for (unsigned int w = 0; w < words; ++w) {
+      unsigned int neighbours[8] = { above + w, above + w, above + w, row + w, row + w, below + w, below + w, below + w };
+      uint64_t* sources[3][8];
+      uint64_t living[8];
+      uint64_t parents[3][8];
+      uint64_t count[4];
+      uint64_t parentCount[3][4];
+
+      // The eight neighbours of the bits in the word: west, center and east above, west and east in the row, west, center and east below
+      for (int p = 0; p < 3; ++p) {
+        uint64_t* planes[8] = { colours->west[p], center[p], colours->east[p], colours->west[p], colours->east[p], colours->west[p], center[p], colours->east[p] };
+        memcpy(sources[p], planes, sizeof(planes));
+      }
+
+      for (int n = 0; n < 8; ++n) {
+        uint64_t bit0 = sources[1][n][neighbours[n]];
+        uint64_t bit1 = sources[2][n][neighbours[n]];
+
+        living[n] = sources[0][n][neighbours[n]];
+        parents[0][n] = bit0 & ~bit1;
+        parents[1][n] = ~bit0 & bit1;
+        parents[2][n] = bit0 & bit1;
+      }
+
+      addEightWords(living, count);
+
+      for (int c = 0; c < 3; ++c) {
+        addEightWords(parents[c], parentCount[c]);
+      }
+
+      // The cells with a neighbour count the birth or survival rule has
+      uint64_t birth = 0;
+      uint64_t survival = 0;
+
+      for (int k = 0; k <= 8; ++k) {
+        uint64_t isCount = ((k & 1) ? count[0] : ~count[0]) & ((k & 2) ? count[1] : ~count[1]) & ((k & 4) ? count[2] : ~count[2]) & ((k & 8) ? count[3] : ~count[3]);
+
+        birth |= ((gameBoard->birthRule >> k) & 1) ? isCount : 0;
+        survival |= ((gameBoard->survivalRule >> k) & 1) ? isCount : 0;
+      }
+
+      uint64_t isLiving = center[0][row + w];
+      uint64_t next = ((isLiving & survival) | (~isLiving & birth)) & (w == words - 1 ? lastMask : ~0ull);
+      uint64_t born = next & ~isLiving;
+      uint64_t kept = next & isLiving;
+
+      // Two or three parents of a colour have bit 1 of its count, all colours different have bit 0 of two counts
+      uint64_t isMixed = ~(parentCount[0][1] | parentCount[1][1] | parentCount[2][1]) & ((parentCount[0][0] & parentCount[1][0]) | (parentCount[0][0] & parentCount[2][0]) | (parentCount[1][0] & parentCount[2][0]));
+      uint64_t majority0 = parentCount[0][1] | parentCount[2][1];
+      uint64_t majority1 = parentCount[1][1] | parentCount[2][1];
+      uint64_t fourth0 = parentCount[0][0] ^ parentCount[2][0];
+      uint64_t fourth1 = parentCount[1][0] ^ parentCount[2][0];
+
+      colours->next[0][row + w] = next;
+      colours->next[1][row + w] = (kept & center[1][row + w]) | (born & ((isMixed & fourth0) | (~isMixed & majority0)));
+      colours->next[2][row + w] = (kept & center[2][row + w]) | (born & ((isMixed & fourth1) | (~isMixed & majority1)));
+    }
+  }
+
+  memcpy(colours->living, colours->next[0], sizeof(uint64_t) * colours->wordCount * 3);
+
+  // The cells follow the living plane, for drawing and the analysis of the turn
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  for (int y = 0; y < cellsY; ++y) {
+    for (int x = 0; x < cellsX; ++x) {
+      nextLiving[(y * cellsX) + x] = (colours->living[(y * words) + (x >> 6)] >> (x & 63)) & 1;
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to parse a 3D Life rule in Bays notation: the least and most
+// neighbours a living voxel survives with, then the least and most a voxel is
+// born with, as four digits like 4555 or separated by commas like 5,7,6,6
+//------------------------------------------------------------------------------
+bool parseCubeRule(char* ruleText, struct lifeCube* cube) {
+  unsigned int values[4];
+  int length = 0;
+
+  if (strlen(ruleText) == 4 && strspn(ruleText, "0123456789") == 4) {
+    for (int i = 0; i < 4; ++i) {
+      values[i] = ruleText[i] - '0';
+    }
+  } else if (sscanf(ruleText, "%u,%u,%u,%u%n", &values[0], &values[1], &values[2], &values[3], &length) != 4 || ruleText[length] != '\0') {
+    printf("[ERROR] The 3D Life rule \"%s\" is not like 4555 or 5,7,6,6.\n", ruleText);
+    return false;
+  }
+
+  if (values[0] > values[1] || values[2] > values[3] || values[1] > 26 || values[3] > 26 || values[2] == 0) {
+    printf("[ERROR] The ranges of the 3D Life rule \"%s\" must be low to high within 0 to 26, births need a neighbour.\n", ruleText);
+    return false;
+  }
+
+  cube->survivalLow = values[0];
+  cube->survivalHigh = values[1];
+  cube->birthLow = values[2];
+  cube->birthHigh = values[3];
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the voxels of 3D Life for a square playboard, the cube
+// has the cells of the playboard as edge. The middle slice is shown first.
+//------------------------------------------------------------------------------
+bool initLifeCube(struct playBoard* gameBoard, struct lifeCube* cube) {
+  if (gameBoard->cellsX != gameBoard->cellsY) {
+    printf("[ERROR] 3D Life needs a square playboard.\n");
+    return false;
+  }
+
+  cube->size = gameBoard->cellsX;
+  cube->wordsPerRow = (cube->size + 63) >> 6;
+  cube->wordCount = cube->wordsPerRow * cube->size * cube->size;
+  cube->voxels = memoryAllocateZeroed(MEMORY_CELLS, cube->wordCount, sizeof(uint64_t));
+  cube->next = memoryAllocateZeroed(MEMORY_CELLS, cube->wordCount, sizeof(uint64_t));
+  cube->rowSums[0] = memoryAllocateZeroed(MEMORY_CELLS, cube->wordCount, sizeof(uint64_t));
+  cube->rowSums[1] = memoryAllocateZeroed(MEMORY_CELLS, cube->wordCount, sizeof(uint64_t));
+  cube->shown = memoryAllocateZeroed(MEMORY_CELLS, cube->wordsPerRow * cube->size, sizeof(uint64_t));
+  cube->slice = cube->size / 2;
+  cube->isProjected = false;
+  cube->livingVoxels = 0;
+
+  if (cube->voxels == NULL || cube->next == NULL || cube->rowSums[0] == NULL || cube->rowSums[1] == NULL || cube->shown == NULL) {
+    printf("[ERROR] Could not reserve memory for the %d^3 voxels of 3D Life.\n", cube->size);
+    freeLifeCube(cube);
+    return false;
+  }
+
+  gameBoard->lifeCube = cube;
+  gameBoard->isEdited = true;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the voxels of 3D Life
+//------------------------------------------------------------------------------
+void freeLifeCube(struct lifeCube* cube) {
+  memoryFree(cube->voxels);
+  memoryFree(cube->next);
+  memoryFree(cube->rowSums[0]);
+  memoryFree(cube->rowSums[1]);
+  memoryFree(cube->shown);
+  memset(cube, 0, sizeof(struct lifeCube));
+}
+
+//------------------------------------------------------------------------------
+// Function to clear all voxels of the cube, not only the shown slice
+//------------------------------------------------------------------------------
+void resetLifeCube(struct lifeCube* cube) {
+  memset(cube->voxels, 0, sizeof(uint64_t) * cube->wordCount);
+  memset(cube->shown, 0, sizeof(uint64_t) * cube->wordsPerRow * cube->size);
+  cube->livingVoxels = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to count the living voxels of all planes of the cube, after they
+// were filled or edited. Turns count them by their slabs.
+//------------------------------------------------------------------------------
+void countLifeCube(struct lifeCube* cube) {
+  cube->livingVoxels = 0;
+
+  for (unsigned int w = 0; w < cube->wordCount; ++w) {
+    cube->livingVoxels += __builtin_popcountll(cube->voxels[w]);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to fill the cube with random voxels, each living if its draw of the
+// seed and counter is below the threshold, and show them on the playboard
+//------------------------------------------------------------------------------
+void fillLifeCube(struct playBoard* gameBoard, uint64_t seed, uint64_t counter, uint64_t threshold) {
+  struct lifeCube* cube = gameBoard->lifeCube;
+  unsigned int voxel = 0;
+
+  for (unsigned int row = 0; row < cube->wordCount; row += cube->wordsPerRow) {
+    for (int x = 0; x < cube->size; ++x) {
+      uint64_t bit = 1ull << (x & 63);
+
+      cube->voxels[row + (x >> 6)] = counterRandom(seed, counter, voxel++) < threshold ? cube->voxels[row + (x >> 6)] | bit : cube->voxels[row + (x >> 6)] & ~bit;
+    }
+  }
+
+  countLifeCube(cube);
+  showLifeCube(gameBoard, true);
+}
+
+//------------------------------------------------------------------------------
+// Function to apply the edits of the shown cells to the voxels. A cell which
+// became living sets the voxel of the slice, a cell which died clears it, or
+// the whole column of voxels under it, when the projection is shown.
+//------------------------------------------------------------------------------
+void applyLifeCubeEdits(struct playBoard* gameBoard) {
+  struct lifeCube* cube = gameBoard->lifeCube;
+  unsigned int planeWords = cube->wordsPerRow * cube->size;
+
+  for (int y = 0; y < cube->size; ++y) {
+    for (int x = 0; x < cube->size; ++x) {
+      unsigned int word = (y * cube->wordsPerRow) + (x >> 6);
+      uint64_t bit = 1ull << (x & 63);
+      bool isLiving = gameBoard->cells[(y * cube->size) + x].isLiving;
+
+      if (isLiving == ((cube->shown[word] & bit) != 0)) {
+        continue;
+      }
+
+      if (isLiving) {
+        cube->voxels[(cube->slice * planeWords) + word] |= bit;
+      } else {
+        for (int z = 0; z < cube->size; ++z) {
+          if (z == cube->slice || cube->isProjected) {
+            cube->voxels[(z * planeWords) + word] &= ~bit;
+          }
+        }
+      }
+
+      cube->shown[word] ^= bit;
+    }
+  }
+
+  countLifeCube(cube);
+  gameBoard->isEdited = false;
+}
+
+//------------------------------------------------------------------------------
+// Function to show the slice of the cube on the playboard, or the projection
+// of all planes, where a cell lives if any voxel under it lives. Like a turn
+// the changed cells are marked, it is only counted as turn if asked for.
+//------------------------------------------------------------------------------
+void showLifeCube(struct playBoard* gameBoard, bool isInHistory) {
+  struct lifeCube* cube = gameBoard->lifeCube;
+  unsigned int planeWords = cube->wordsPerRow * cube->size;
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  if (cube->isProjected) {
+    memset(cube->shown, 0, sizeof(uint64_t) * planeWords);
+
+    for (int z = 0; z < cube->size; ++z) {
+      for (unsigned int w = 0; w < planeWords; ++w) {
+        cube->shown[w] |= cube->voxels[(z * planeWords) + w];
+      }
+    }
+  } else {
+    memcpy(cube->shown, &cube->voxels[cube->slice * planeWords], sizeof(uint64_t) * planeWords);
+  }
+
+  for (int y = 0; y < cube->size; ++y) {
+    for (int x = 0; x < cube->size; ++x) {
+      nextLiving[(y * cube->size) + x] = (cube->shown[(y * cube->wordsPerRow) + (x >> 6)] >> (x & 63)) & 1;
+    }
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+  gameBoard->isEdited = false;
+}
+
+//------------------------------------------------------------------------------
+// Function to add a number of bit planes to another, with the carry rippling
+// from bit to bit of the total, 64 bits a word at once. The total has to have
+// enough planes for the sum.
+//------------------------------------------------------------------------------
+void addBitPlanes(uint64_t* total, int totalBits, uint64_t* addend, int addendBits) {
+  uint64_t carry = 0;
+
+  for (int b = 0; b < totalBits; ++b) {
+    uint64_t bit = b < addendBits ? addend[b] : 0;
+    uint64_t sum = total[b] ^ bit ^ carry;
+
+    carry = (total[b] & bit) | (carry & (total[b] ^ bit));
+    total[b] = sum;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to run a phase of a 3D Life turn on a slab of planes. Summing, each
+// voxel gets the living voxels of itself and its west and east neighbour in
+// two bit planes. Counting, the row sums of the 9 rows around each row are
+// added to the count of the 27 voxels around each voxel, itself included, so a
+// living voxel survives with one more than its neighbours.
+//------------------------------------------------------------------------------
+int applyLifeCubeSlab(void* data) {
+  struct lifeCubeSlab* slab = data;
+  struct lifeCube* cube = slab->cube;
+  unsigned int words = cube->wordsPerRow;
+  unsigned int planeWords = words * cube->size;
+  uint64_t lastMask = (cube->size & 63) == 0 ? ~0ull : (1ull << (cube->size & 63)) - 1;
+
+  if (slab->isSumming) {
+    uint64_t west[words];
+    uint64_t east[words];
+
+    for (unsigned int row = slab->firstPlane * planeWords; row < slab->endPlane * planeWords; row += words) {
+      shiftRow(&cube->voxels[row], west, east, words, cube->size);
+
+      for (unsigned int w = 0; w < words; ++w) {
+        uint64_t center = cube->voxels[row + w];
+
+        cube->rowSums[0][row + w] = west[w] ^ center ^ east[w];
+        cube->rowSums[1][row + w] = (west[w] & center) | (east[w] & (west[w] ^ center));
+      }
+    }
+
+    return 0;
+  }
+
+  for (int z = slab->firstPlane; z < slab->endPlane; ++z) {
+    int planes[3] = { z == 0 ? cube->size - 1 : z - 1, z, z == cube->size - 1 ? 0 : z + 1 };
+
+    for (int y = 0; y < cube->size; ++y) {
+      int rows[3] = { y == 0 ? cube->size - 1 : y - 1, y, y == cube->size - 1 ? 0 : y + 1 };
+
+      for (unsigned int w = 0; w < words; ++w) {
+        uint64_t count[5] = { 0 };
+
+        for (int p = 0; p < 3; ++p) {
+          for (int r = 0; r < 3; ++r) {
+            unsigned int word = (planes[p] * planeWords) + (rows[r] * words) + w;
+            uint64_t rowSum[2] = { cube->rowSums[0][word], cube->rowSums[1][word] };
+
+            addBitPlanes(count, 5, rowSum, 2);
+          }
+        }
+
+        // The voxels with a count within the range of survival or birth
+        uint64_t survival = 0;
+        uint64_t birth = 0;
+
+        for (unsigned int k = 0; k <= 27; ++k) {
+          bool isSurvival = k >= cube->survivalLow + 1 && k <= cube->survivalHigh + 1;
+          bool isBirth = k >= cube->birthLow && k <= cube->birthHigh;
+
+          if (!isSurvival && !isBirth) {
+            continue;
+          }
+
+          uint64_t isCount = ~0ull;
+
+          for (int b = 0; b < 5; ++b) {
+            isCount &= ((k >> b) & 1) ? count[b] : ~count[b];
+          }
+
+          survival |= isSurvival ? isCount : 0;
+          birth |= isBirth ? isCount : 0;
+        }
+
+        unsigned int word = (z * planeWords) + (y * words) + w;
+        uint64_t isLiving = cube->voxels[word];
+
+        cube->next[word] = ((isLiving & survival) | (~isLiving & birth)) & (w == words - 1 ? lastMask : ~0ull);
+        slab->livingVoxels += __builtin_popcountll(cube->next[word]);
+        slab->isChanged |= cube->next[word] != isLiving;
+      }
+    }
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn of 3D Life. The edits of the shown cells are taken
+// into the voxels first. The rows are summed and then the neighbours counted,
+// each phase on slabs of planes in their own threads, and the slice or the
+// projection is shown as the turn of the playboard. The playboard is dirty
+// if any voxel changed, also outside of the shown slice.
+//------------------------------------------------------------------------------
+void applyTurnLifeCube(struct playBoard* gameBoard, bool isInHistory) {
+  struct lifeCube* cube = gameBoard->lifeCube;
+
+  if (gameBoard->isEdited) {
+    applyLifeCubeEdits(gameBoard);
+  }
+
+  struct lifeCubeSlab slabs[LIFE_CUBE_THREADS];
+  int slabCount = SDL_GetCPUCount();
+
+  if (slabCount > LIFE_CUBE_THREADS) {
+    slabCount = LIFE_CUBE_THREADS;
+  }
+
+  if (slabCount > cube->size) {
+    slabCount = cube->size;
+  }
+
+  if (slabCount < 1) {
+    slabCount = 1;
+  }
+
+  for (int phase = 0; phase < 2; ++phase) {
+    for (int s = 0; s < slabCount; ++s) {
+      slabs[s].cube = cube;
+      slabs[s].firstPlane = cube->size * s / slabCount;
+      slabs[s].endPlane = cube->size * (s + 1) / slabCount;
+      slabs[s].isSumming = phase == 0;
+      slabs[s].livingVoxels = 0;
+      slabs[s].isChanged = false;
+    }
+
+    runInThreads(applyLifeCubeSlab, "lifeCubeSlab", slabs, sizeof(slabs[0]), slabCount);
+  }
+
+  uint64_t* voxels = cube->voxels;
+  cube->voxels = cube->next;
+  cube->next = voxels;
+
+  // The playboard is stale only if no voxel of any plane changed
+  bool isChanged = false;
+  cube->livingVoxels = 0;
+
+  for (int s = 0; s < slabCount; ++s) {
+    cube->livingVoxels += slabs[s].livingVoxels;
+    isChanged |= slabs[s].isChanged;
+  }
+
+  showLifeCube(gameBoard, isInHistory);
+  gameBoard->isDirty = isChanged;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the row of an elementary 1D automaton of a rule
+//------------------------------------------------------------------------------
+bool initElementaryAutomaton(struct elementaryAutomaton* automaton, int cells, unsigned int rule) {
+  automaton->rule = rule & 0xFF;
+  automaton->cells = cells;
+  automaton->words = (cells + 63) >> 6;
+  automaton->generations = 0;
+  automaton->row = memoryAllocateZeroed(MEMORY_CELLS, automaton->words * 3, sizeof(uint64_t));
+
+  if (automaton->row == NULL) {
+    printf("[ERROR] Could not reserve memory for the row of the 1D automaton.\n");
+    return false;
+  }
+
+  automaton->left = automaton->row + automaton->words;
+  automaton->right = automaton->row + (2 * automaton->words);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the row of an elementary 1D automaton
+//------------------------------------------------------------------------------
+void freeElementaryAutomaton(struct elementaryAutomaton* automaton) {
+  memoryFree(automaton->row);
+  memset(automaton, 0, sizeof(struct elementaryAutomaton));
+}
+
+//------------------------------------------------------------------------------
+// Function to evolve the row of an elementary 1D automaton by one generation.
+// Every set bit of the rule adds the cells whose neighbourhood is the pattern
+// of the bit, so 64 cells are decided by a few operations on words.
+//------------------------------------------------------------------------------
+void evolveElementaryRow(struct elementaryAutomaton* automaton) {
+  unsigned int rule = automaton->rule;
+
+  shiftRow(automaton->row, automaton->left, automaton->right, automaton->words, automaton->cells);
+
+  for (unsigned int w = 0; w < automaton->words; ++w) {
+    uint64_t left = automaton->left[w];
+    uint64_t center = automaton->row[w];
+    uint64_t right = automaton->right[w];
+    uint64_t next = 0;
+
+    for (unsigned int pattern = 0; pattern < 8; ++pattern) {
+      if ((rule >> pattern) & 1) {
+        next |= ((pattern & 4) ? left : ~left) & ((pattern & 2) ? center : ~center) & ((pattern & 1) ? right : ~right);
+      }
+    }
+
+    automaton->row[w] = next;
+  }
+
+  // The bits past the end of the row stay dead, rules like 1 would set them
+  if (automaton->cells & 63) {
+    automaton->row[automaton->words - 1] &= (1ull << (automaton->cells & 63)) - 1;
+  }
+
+  ++automaton->generations;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn of an elementary 1D automaton as spacetime diagram:
+// the bottom row of the playboard is the generation, it is evolved once and
+// the rows scroll up, so the older generations move to the top. Edits of the
+// bottom row change the generation.
+//------------------------------------------------------------------------------
+void applyTurnElementary(struct playBoard* gameBoard, bool isInHistory) {
+  struct elementaryAutomaton* automaton = gameBoard->elementary;
+  int cellsX = gameBoard->cellsX;
+  unsigned int bottom = gameBoard->cellCount - cellsX;
+
+  if (gameBoard->isEdited) {
+    memset(automaton->row, 0, sizeof(uint64_t) * automaton->words);
+
+    for (int x = 0; x < cellsX; ++x) {
+      automaton->row[x >> 6] |= (uint64_t) gameBoard->cells[bottom + x].isLiving << (x & 63);
+    }
+
+    gameBoard->isEdited = false;
+  }
+
+  evolveElementaryRow(automaton);
+
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  for (unsigned int i = 0; i < bottom; ++i) {
+    nextLiving[i] = gameBoard->cells[i + cellsX].isLiving;
+  }
+
+  for (int x = 0; x < cellsX; ++x) {
+    nextLiving[bottom + x] = (automaton->row[x >> 6] >> (x & 63)) & 1;
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+}
+
+//------------------------------------------------------------------------------
+// Function to plan the fast Fourier transforms of a length: the length is
+// split into prime factors, smallest first, and the roots of unity are kept
+//------------------------------------------------------------------------------
+bool initFFTPlan(struct fftPlan* plan, int size) {
+  int rest = size;
+
+  plan->size = size;
+  plan->factorCount = 0;
+
+  for (int factor = 2; rest > 1 && plan->factorCount < 32; ) {
+    if (rest % factor == 0) {
+      plan->factors[plan->factorCount++] = factor;
+      rest /= factor;
+    } else {
+      factor = factor * factor > rest ? rest : factor + 1;
+    }
+  }
+
+  plan->rootsRe = memoryAllocate(MEMORY_CELLS, sizeof(double) * size);
+  plan->rootsIm = memoryAllocate(MEMORY_CELLS, sizeof(double) * size);
+
+  if (plan->rootsRe == NULL || plan->rootsIm == NULL) {
+    freeFFTPlan(plan);
+    return false;
+  }
+
+  for (int t = 0; t < size; ++t) {
+    plan->rootsRe[t] = cos(-2 * FFT_PI * t / size);
+    plan->rootsIm[t] = sin(-2 * FFT_PI * t / size);
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the roots of a plan of the fast Fourier transform
+//------------------------------------------------------------------------------
+void freeFFTPlan(struct fftPlan* plan) {
+  memoryFree(plan->rootsRe);
+  memoryFree(plan->rootsIm);
+  plan->rootsRe = NULL;
+  plan->rootsIm = NULL;
+}
+
+//------------------------------------------------------------------------------
+// Function to transform complex values in place by the Stockham algorithm, a
+// stage per factor. Each stage takes the values a part of the length apart,
+// turns them by the twiddle of their position in the finished subsequences
+// and transforms them by the factor, writing them in order for the next stage,
+// so no bit reversal is needed. The inverse is not scaled by the length.
+//------------------------------------------------------------------------------
+void transformFFT(struct fftPlan* plan, double* re, double* im, double* workRe, double* workIm, bool isInverse) {
+  int size = plan->size;
+  double sign = isInverse ? -1 : 1;
+  double* sourceRe = re;
+  double* sourceIm = im;
+  double* targetRe = workRe;
+  double* targetIm = workIm;
+  int finished = 1;   // The length of the subsequences transformed by the stages before
+
+  for (int f = 0; f < plan->factorCount; ++f) {
+    int factor = plan->factors[f];
+    int part = size / factor;
+    int step = size / (finished * factor);
+    int groups = part / finished;
+    double twiddlesRe[factor];
+    double twiddlesIm[factor];
+    double valuesRe[factor];
+    double valuesIm[factor];
+
+    // The roots of the transform by the factor, exp(-2 pi i n / factor) for n below the factor
+    double factorRootsRe[factor];
+    double factorRootsIm[factor];
+
+    for (int n = 0; n < factor; ++n) {
+      factorRootsRe[n] = plan->rootsRe[n * part];
+      factorRootsIm[n] = sign * plan->rootsIm[n * part];
+    }
+
+    for (int position = 0; position < finished; ++position) {
+      // The twiddles turning the values by their position in the finished subsequences
+      for (int r = 0; r < factor; ++r) {
+        twiddlesRe[r] = plan->rootsRe[position * r * step];
+        twiddlesIm[r] = sign * plan->rootsIm[position * r * step];
+      }
+
+      for (int group = 0; group < groups; ++group) {
+        int j = (group * finished) + position;
+        int target = (group * finished * factor) + position;
+
+        // Gather and turn the values
+        for (int r = 0; r < factor; ++r) {
+          double valueRe = sourceRe[j + (r * part)];
+          double valueIm = sourceIm[j + (r * part)];
+
+          valuesRe[r] = (valueRe * twiddlesRe[r]) - (valueIm * twiddlesIm[r]);
+          valuesIm[r] = (valueRe * twiddlesIm[r]) + (valueIm * twiddlesRe[r]);
+        }
+
+        // Transform by the factor and scatter the results a subsequence apart
+        if (factor == 2) {
+          targetRe[target] = valuesRe[0] + valuesRe[1];
+          targetIm[target] = valuesIm[0] + valuesIm[1];
+          targetRe[target + finished] = valuesRe[0] - valuesRe[1];
+          targetIm[target + finished] = valuesIm[0] - valuesIm[1];
+          continue;
+        }
+
+        for (int k = 0; k < factor; ++k) {
+          double sumRe = valuesRe[0];
+          double sumIm = valuesIm[0];
+          int root = 0;
+
+          for (int r = 1; r < factor; ++r) {
+            root += k;
+            root -= root >= factor ? factor : 0;
+
+            sumRe += (valuesRe[r] * factorRootsRe[root]) - (valuesIm[r] * factorRootsIm[root]);
+            sumIm += (valuesRe[r] * factorRootsIm[root]) + (valuesIm[r] * factorRootsRe[root]);
+          }
+
+          targetRe[target + (k * finished)] = sumRe;
+          targetIm[target + (k * finished)] = sumIm;
+        }
+      }
+    }
+
+    finished *= factor;
+
+    double* swap = sourceRe;
+    sourceRe = targetRe;
+    targetRe = swap;
+    swap = sourceIm;
+    sourceIm = targetIm;
+    targetIm = swap;
+  }
+
+  if (sourceRe != re) {
+    memcpy(re, sourceRe, sizeof(double) * size);
+    memcpy(im, sourceIm, sizeof(double) * size);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to parse the Lenia parameters: the radius of the kernel, then
+// optionally mu, sigma and the time resolution, like 13 or 13,0.15,0.015,10
+//------------------------------------------------------------------------------
+bool parseLeniaParameters(char* parameterText, struct lenia* field) {
+  double timeResolution = 10;
+
+  field->mu = 0.15;
+  field->sigma = 0.015;
+
+  if (sscanf(parameterText, "%d,%lf,%lf,%lf", &field->radius, &field->mu, &field->sigma, &timeResolution) < 1 || field->radius < 1 || field->radius > 100 || field->sigma <= 0 || timeResolution < 1) {
+    printf("[ERROR] The Lenia parameters \"%s\" are not like 13 or 13,0.15,0.015,10 (radius 1 to 100, mu, sigma, time resolution).\n", parameterText);
+    return false;
+  }
+
+  field->dt = 1 / timeResolution;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the states of Lenia for the playboard and transform the
+// kernel. The kernel is a smooth ring, a bump over the distance from 0 to the
+// radius, summing to 1. It is laid out around the cell at 0, wrapped like the
+// playboard, so its product with the transformed states is the convolution.
+//------------------------------------------------------------------------------
+bool initLenia(struct playBoard* gameBoard, struct lenia* field) {
+  unsigned int cellCount = gameBoard->cellCount;
+
+  field->cellsX = gameBoard->cellsX;
+  field->cellsY = gameBoard->cellsY;
+  field->states = memoryAllocateZeroed(MEMORY_CELLS, cellCount, sizeof(double));
+  field->spectrumRe = memoryAllocateZeroed(MEMORY_CELLS, cellCount, sizeof(double));
+  field->spectrumIm = memoryAllocateZeroed(MEMORY_CELLS, cellCount, sizeof(double));
+  field->kernelRe = memoryAllocateZeroed(MEMORY_CELLS, cellCount, sizeof(double));
+  field->kernelIm = memoryAllocateZeroed(MEMORY_CELLS, cellCount, sizeof(double));
+
+  if (field->states == NULL || field->spectrumRe == NULL || field->spectrumIm == NULL || field->kernelRe == NULL || field->kernelIm == NULL || !initFFTPlan(&field->rowPlan, field->cellsX) || !initFFTPlan(&field->columnPlan, field->cellsY)) {
+    printf("[ERROR] Could not reserve memory for the states of Lenia.\n");
+    freeLenia(field);
+    return false;
+  }
+
+  double kernelSum = 0;
+
+  for (int dy = -field->radius; dy <= field->radius; ++dy) {
+    for (int dx = -field->radius; dx <= field->radius; ++dx) {
+      double distance = sqrt((dx * dx) + (dy * dy)) / field->radius;
+
+      if (distance <= 0 || distance >= 1) {
+        continue;
+      }
+
+      // Cells closer than the radius on a small playboard add up on the same cell
+      unsigned int i = ((((dy % field->cellsY) + field->cellsY) % field->cellsY) * field->cellsX) + (((dx % field->cellsX) + field->cellsX) % field->cellsX);
+      double weight = exp(4 - (1 / (distance * (1 - distance))));
+
+      field->kernelRe[i] += weight;
+      kernelSum += weight;
+    }
+  }
+
+  for (unsigned int i = 0; i < cellCount; ++i) {
+    field->kernelRe[i] /= kernelSum;
+  }
+
+  // The kernel is transformed like the states in a turn: rows, then columns
+  double workRe[field->cellsX > field->cellsY ? field->cellsX : field->cellsY];
+  double workIm[field->cellsX > field->cellsY ? field->cellsX : field->cellsY];
+  double columnRe[field->cellsY];
+  double columnIm[field->cellsY];
+
+  for (int y = 0; y < field->cellsY; ++y) {
+    transformFFT(&field->rowPlan, &field->kernelRe[y * field->cellsX], &field->kernelIm[y * field->cellsX], workRe, workIm, false);
+  }
+
+  for (int x = 0; x < field->cellsX; ++x) {
+    for (int y = 0; y < field->cellsY; ++y) {
+      columnRe[y] = field->kernelRe[(y * field->cellsX) + x];
+      columnIm[y] = field->kernelIm[(y * field->cellsX) + x];
+    }
+
+    transformFFT(&field->columnPlan, columnRe, columnIm, workRe, workIm, false);
+
+    for (int y = 0; y < field->cellsY; ++y) {
+      field->kernelRe[(y * field->cellsX) + x] = columnRe[y];
+      field->kernelIm[(y * field->cellsX) + x] = columnIm[y];
+    }
+  }
+
+  gameBoard->lenia = field;
+  gameBoard->isEdited = true;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the states and transforms of Lenia
+//------------------------------------------------------------------------------
+void freeLenia(struct lenia* field) {
+  memoryFree(field->states);
+  memoryFree(field->spectrumRe);
+  memoryFree(field->spectrumIm);
+  memoryFree(field->kernelRe);
+  memoryFree(field->kernelIm);
+  freeFFTPlan(&field->rowPlan);
+  freeFFTPlan(&field->columnPlan);
+  memset(field, 0, sizeof(struct lenia));
+}
+
+//------------------------------------------------------------------------------
+// Function to run a phase of a Lenia turn on a band. The rows are real, so two
+// rows are transformed at once as the real and imaginary part of one complex
+// row, and split by the symmetry of real transforms. The columns are
+// transformed, multiplied by the transformed kernel and transformed back. Back
+// in the rows, two real rows come out of one complex transform again, and the
+// states grow by the growth function of their weighted neighbourhood.
+//------------------------------------------------------------------------------
+int applyLeniaBand(void* data) {
+  struct leniaBand* band = data;
+  struct lenia* field = band->lenia;
+  int cellsX = field->cellsX;
+  int cellsY = field->cellsY;
+  double workRe[cellsX > cellsY ? cellsX : cellsY];
+  double workIm[cellsX > cellsY ? cellsX : cellsY];
+
+  if (band->phase == 1) {
+    double columnRe[cellsY];
+    double columnIm[cellsY];
+
+    for (int x = band->first; x < band->end; ++x) {
+      for (int y = 0; y < cellsY; ++y) {
+        columnRe[y] = field->spectrumRe[(y * cellsX) + x];
+        columnIm[y] = field->spectrumIm[(y * cellsX) + x];
+      }
+
+      transformFFT(&field->columnPlan, columnRe, columnIm, workRe, workIm, false);
+
+      for (int y = 0; y < cellsY; ++y) {
+        double kernelRe = field->kernelRe[(y * cellsX) + x];
+        double kernelIm = field->kernelIm[(y * cellsX) + x];
+        double valueRe = columnRe[y];
+
+        columnRe[y] = (valueRe * kernelRe) - (columnIm[y] * kernelIm);
+        columnIm[y] = (valueRe * kernelIm) + (columnIm[y] * kernelRe);
+      }
+
+      transformFFT(&field->columnPlan, columnRe, columnIm, workRe, workIm, true);
+
+      for (int y = 0; y < cellsY; ++y) {
+        field->spectrumRe[(y * cellsX) + x] = columnRe[y];
+        field->spectrumIm[(y * cellsX) + x] = columnIm[y];
+      }
+    }
+
+    return 0;
+  }
+
+  double rowRe[cellsX];
+  double rowIm[cellsX];
+
+  // The band holds pairs of rows, the last row of an odd playboard is paired with zeros
+  for (int y = band->first; y < band->end; y += 2) {
+    double* firstRe = &field->spectrumRe[y * cellsX];
+    double* firstIm = &field->spectrumIm[y * cellsX];
+    bool isPaired = y + 1 < cellsY;
+    double* secondRe = isPaired ? &field->spectrumRe[(y + 1) * cellsX] : NULL;
+    double* secondIm = isPaired ? &field->spectrumIm[(y + 1) * cellsX] : NULL;
+
+    if (band->phase == 0) {
+      for (int x = 0; x < cellsX; ++x) {
+        rowRe[x] = field->states[(y * cellsX) + x];
+        rowIm[x] = isPaired ? field->states[((y + 1) * cellsX) + x] : 0;
+      }
+
+      transformFFT(&field->rowPlan, rowRe, rowIm, workRe, workIm, false);
+
+      // The transform of the first row is the even part, of the second the odd part divided by i
+      for (int x = 0; x < cellsX; ++x) {
+        int mirror = x == 0 ? 0 : cellsX - x;
+
+        firstRe[x] = (rowRe[x] + rowRe[mirror]) * 0.5;
+        firstIm[x] = (rowIm[x] - rowIm[mirror]) * 0.5;
+
+        if (isPaired) {
+          secondRe[x] = (rowIm[x] + rowIm[mirror]) * 0.5;
+          secondIm[x] = (rowRe[mirror] - rowRe[x]) * 0.5;
+        }
+      }
+
+      continue;
+    }
+
+    // The inverse of the first transform plus i times the second gives both real rows at once
+    for (int x = 0; x < cellsX; ++x) {
+      rowRe[x] = firstRe[x] - (isPaired ? secondIm[x] : 0);
+      rowIm[x] = firstIm[x] + (isPaired ? secondRe[x] : 0);
+    }
+
+    transformFFT(&field->rowPlan, rowRe, rowIm, workRe, workIm, true);
+
+    double scale = 1.0 / ((double) cellsX * cellsY);
+
+    for (int row = 0; row < (isPaired ? 2 : 1); ++row) {
+      double* sums = row == 0 ? rowRe : rowIm;
+      double* states = &field->states[(y + row) * cellsX];
+
+      for (int x = 0; x < cellsX; ++x) {
+        double difference = (sums[x] * scale) - field->mu;
+        double growth = (2 * exp(-(difference * difference) / (2 * field->sigma * field->sigma))) - 1;
+        double state = states[x] + (field->dt * growth);
+
+        state = state < 0 ? 0 : state > 1 ? 1 : state;
+        band->isChanged = band->isChanged || state != states[x];
+        states[x] = state;
+      }
+    }
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn of Lenia. Painted cells get the state 1 and cleared
+// cells 0, the states of all other cells are kept. The states are convolved with the kernel by fast Fourier transforms,
+// rows and columns in bands by their own threads, and grow by the result.
+// Cells of a state of at least LENIA_VISIBLE are living on the playboard.
+//------------------------------------------------------------------------------
+void applyTurnLenia(struct playBoard* gameBoard, bool isInHistory) {
+  struct lenia* field = gameBoard->lenia;
+
+  // Only cells shown otherwise than their state were edited, the faint states keep
+  if (gameBoard->isEdited) {
+    for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+      if (gameBoard->cells[i].isLiving != (field->states[i] >= LENIA_VISIBLE)) {
+        field->states[i] = gameBoard->cells[i].isLiving ? 1 : 0;
+      }
+    }
+
+    gameBoard->isEdited = false;
+  }
+
+  struct leniaBand bands[LENIA_THREADS];
+  int bandCount = SDL_GetCPUCount();
+  bool isChanged = false;
+
+  if (bandCount > LENIA_THREADS) {
+    bandCount = LENIA_THREADS;
+  }
+
+  if (bandCount < 1) {
+    bandCount = 1;
+  }
+
+  for (int phase = 0; phase < 3; ++phase) {
+    // Rows go in pairs, columns one by one
+    int count = phase == 1 ? field->cellsX : (field->cellsY + 1) / 2;
+
+    for (int b = 0; b < bandCount; ++b) {
+      bands[b].lenia = field;
+      bands[b].first = count * b / bandCount * (phase == 1 ? 1 : 2);
+      bands[b].end = count * (b + 1) / bandCount * (phase == 1 ? 1 : 2);
+      bands[b].phase = phase;
+      bands[b].isChanged = false;
+    }
+
+    runInThreads(applyLeniaBand, "leniaBand", bands, sizeof(bands[0]), bandCount);
+
+    for (int b = 0; b < bandCount; ++b) {
+      isChanged = isChanged || bands[b].isChanged;
+    }
+  }
+
+  unsigned char nextLiving[gameBoard->cellCount];
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    nextLiving[i] = field->states[i] >= LENIA_VISIBLE;
+  }
+
+  commitTurn(gameBoard, nextLiving, isInHistory);
+
+  // The states change below and above the living ones too
+  gameBoard->isDirty = gameBoard->isDirty || isChanged;
+}
+
+//------------------------------------------------------------------------------
+// Function to make room in a live cell list for rows and living cells. The
+// arrays grow at least twofold in one new allocation, the living cells and
+// the changed cells are kept, all other arrays are filled by each turn.
+//------------------------------------------------------------------------------
+bool reserveLiveList(struct liveList* list, unsigned int rows, unsigned int cells) {
+  if (list->data != NULL && rows <= list->rowCapacity && cells <= list->cellCapacity) {
+    return true;
+  }
+
+  unsigned int rowCapacity = list->rowCapacity < 16 ? 16 : list->rowCapacity;
+  unsigned int cellCapacity = list->cellCapacity < 16 ? 16 : list->cellCapacity;
+
+  if (rows > rowCapacity) {
+    rowCapacity = rows > 2 * rowCapacity ? rows : 2 * rowCapacity;
+  }
+
+  if (cells > cellCapacity) {
+    cellCapacity = cells > 2 * cellCapacity ? cells : 2 * cellCapacity;
+  }
+
+  // The rows and their starts twice, the columns twice, the merged columns, the changed cells and the merged counts
+  size_t words = (4 * (size_t) rowCapacity) + 2 + (5 * (size_t) cellCapacity) + 2;
+  int* data = memoryAllocate(MEMORY_CELLS, (sizeof(int) * words) + cellCapacity + 2);
+
+  if (data == NULL) {
+    printf("[ERROR] Could not reserve memory for %u living cells of the list engine.\n", cells);
+    return false;
+  }
+
+  int* rowData = data;
+  unsigned int* startData = (unsigned int*) &rowData[2 * rowCapacity];
+  int* columnData = (int*) &startData[2 * (rowCapacity + 1)];
+  unsigned int* changed = (unsigned int*) &columnData[(3 * cellCapacity) + 2];
+
+  startData[0] = 0;
+
+  if (list->data != NULL) {
+    memcpy(rowData, list->rows, sizeof(int) * list->rowCount);
+    memcpy(startData, list->rowStarts, sizeof(unsigned int) * (list->rowCount + 1));
+    memcpy(columnData, list->columns, sizeof(int) * list->count);
+    memcpy(changed, list->changed, sizeof(unsigned int) * list->changedCount);
+  }
+
+  memoryFree(list->data);
+  list->data = data;
+  list->rows = rowData;
+  list->nextRows = &rowData[rowCapacity];
+  list->rowStarts = startData;
+  list->nextRowStarts = &startData[rowCapacity + 1];
+  list->columns = columnData;
+  list->nextColumns = &columnData[cellCapacity];
+  list->merged = &columnData[2 * cellCapacity];
+  list->changed = changed;
+  list->mergedCounts = (unsigned char*) &changed[2 * cellCapacity];
+  list->rowCapacity = rowCapacity;
+  list->cellCapacity = cellCapacity;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the arrays of a live cell list, NULL is ignored
+//------------------------------------------------------------------------------
+void freeLiveList(struct liveList* list) {
+  if (list == NULL) {
+    return;
+  }
+
+  memoryFree(list->data);
+  list->data = NULL;
+  list->rowCount = 0;
+  list->count = 0;
+  list->changedCount = 0;
+  list->rowCapacity = 0;
+  list->cellCapacity = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to add a living cell after all others of a live cell list, the
+// cells have to be added by rows and columns ascending into reserved room
+//------------------------------------------------------------------------------
+void appendLiveCell(struct liveList* list, int x, int y) {
+  if (list->rowCount == 0 || list->rows[list->rowCount - 1] != y) {
+    list->rows[list->rowCount++] = y;
+  }
+
+  list->columns[list->count++] = x;
+  list->rowStarts[list->rowCount] = list->count;
+}
+
+//------------------------------------------------------------------------------
+// Function to find the index of a row in a live cell list by binary search,
+// -1 if the row has no living cells
+//------------------------------------------------------------------------------
+int findLiveRow(struct liveList* list, int y) {
+  int low = 0;
+  int high = (int) list->rowCount - 1;
+
+  while (low <= high) {
+    int middle = (low + high) / 2;
+
+    if (list->rows[middle] < y) {
+      low = middle + 1;
+    } else if (list->rows[middle] > y) {
+      high = middle - 1;
+    } else {
+      return middle;
+    }
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Function to evolve a live cell list by one turn of a Moore rule without
+// births by 0 neighbours. Only the rows next to living rows can have living
+// cells after the turn: for each of them the column lists of the row above,
+// itself and the row below are merged into the living cells per column, and
+// a window of three merged columns counts the neighbours of every column next
+// to a living one. The columns and rows wrap around, the last column is also
+// merged left of the first and the first right of the last. A turn costs by
+// the living cells, not by the size of the playboard.
+//------------------------------------------------------------------------------
+bool evolveLiveList(struct liveList* list, unsigned int birthRule, unsigned int survivalRule) {
+  // A living cell reaches 3 columns in 3 rows, so the next turn fits
+  if (!reserveLiveList(list, 3 * list->rowCount, (9 * list->count) + 1)) {
+    return false;
+  }
+
+  int cellsX = list->cellsX;
+  int cellsY = list->cellsY;
+  unsigned int rowCount = list->rowCount;
+  unsigned int nextRowCount = 0;
+  unsigned int nextCount = 0;
+  unsigned int taken[3] = { 0, 0, 0 };
+  unsigned int firsts[3] = { 0, 0, 0 };
+
+  // The rows above, at and below the living rows are three ascending sequences,
+  // each starting at its lowest row after the wrap around
+  if (rowCount > 0) {
+    firsts[0] = list->rows[0] == 0 ? 1 % rowCount : 0;
+    firsts[2] = list->rows[rowCount - 1] == cellsY - 1 ? rowCount - 1 : 0;
+  }
+
+  list->nextRowStarts[0] = 0;
+
+  while (true) {
+    int heads[3];
+    int y = INT_MAX;
+
+    for (int s = 0; s < 3; ++s) {
+      heads[s] = INT_MAX;
+
+      if (taken[s] < rowCount) {
+        int row = list->rows[(firsts[s] + taken[s]) % rowCount] + s - 1;
+
+        heads[s] = row < 0 ? cellsY - 1 : row == cellsY ? 0 : row;
+        y = heads[s] < y ? heads[s] : y;
+      }
+    }
+
+    if (y == INT_MAX) {
+      break;
+    }
+
+    for (int s = 0; s < 3; ++s) {
+      taken[s] += heads[s] == y;
+    }
+
+    // Merge the columns of the rows around, index 0 is kept for the last column left of the first
+    int neighbourRows[3] = { y == 0 ? cellsY - 1 : y - 1, y, y == cellsY - 1 ? 0 : y + 1 };
+    unsigned int positions[3];
+    unsigned int ends[3];
+    unsigned int end = 1;
+
+    for (int r = 0; r < 3; ++r) {
+      int index = findLiveRow(list, neighbourRows[r]);
+
+      positions[r] = index < 0 ? 0 : list->rowStarts[index];
+      ends[r] = index < 0 ? 0 : list->rowStarts[index + 1];
+    }
+
+    while (true) {
+      int x = INT_MAX;
+      unsigned char count = 0;
+
+      for (int r = 0; r < 3; ++r) {
+        if (positions[r] < ends[r] && list->columns[positions[r]] < x) {
+          x = list->columns[positions[r]];
+        }
+      }
+
+      if (x == INT_MAX) {
+        break;
+      }
+
+      // Bit 2 marks the living cell of the middle row
+      for (int r = 0; r < 3; ++r) {
+        if (positions[r] < ends[r] && list->columns[positions[r]] == x) {
+          count += r == 1 ? 5 : 1;
+          ++positions[r];
+        }
+      }
+
+      list->merged[end] = x;
+      list->mergedCounts[end++] = count;
+    }
+
+    unsigned int begin = 1;
+
+    if (list->merged[end - 1] == cellsX - 1) {
+      begin = 0;
+      list->merged[0] = -1;
+      list->mergedCounts[0] = list->mergedCounts[end - 1] & 3;
+    }
+
+    if (list->merged[1] == 0) {
+      list->merged[end] = cellsX;
+      list->mergedCounts[end] = list->mergedCounts[1] & 3;
+      ++end;
+    }
+
+    // Count the neighbours of each column next to a merged one, once per column
+    unsigned int window = begin;
+    int next = INT_MIN;
+
+    for (unsigned int e = begin; e < end; ++e) {
+      int first = list->merged[e] - 1 > next ? list->merged[e] - 1 : next;
+
+      for (int x = first < 0 ? 0 : first; x <= list->merged[e] + 1 && x < cellsX; ++x) {
+        int livingNeighbours = 0;
+        bool isLiving = false;
+
+        while (list->merged[window] < x - 1) {
+          ++window;
+        }
+
+        for (unsigned int w = window; w < end && list->merged[w] <= x + 1; ++w) {
+          livingNeighbours += list->mergedCounts[w] & 3;
+          isLiving = isLiving || (list->merged[w] == x && (list->mergedCounts[w] & 4));
+        }
+
+        livingNeighbours -= isLiving;
+
+        if ((((isLiving ? survivalRule : birthRule) >> livingNeighbours) & 1) != 0) {
+          list->nextColumns[nextCount++] = x;
+        }
+      }
+
+      next = list->merged[e] + 2;
+    }
+
+    if (nextCount > list->nextRowStarts[nextRowCount]) {
+      list->nextRows[nextRowCount++] = y;
+      list->nextRowStarts[nextRowCount] = nextCount;
+    }
+  }
+
+  // The lists of the turn before stay in the next lists until the next turn
+  int* rows = list->rows;
+  unsigned int* rowStarts = list->rowStarts;
+  int* columns = list->columns;
+
+  list->rows = list->nextRows;
+  list->rowStarts = list->nextRowStarts;
+  list->columns = list->nextColumns;
+  list->nextRows = rows;
+  list->nextRowStarts = rowStarts;
+  list->nextColumns = columns;
+  list->rowCount = nextRowCount;
+  list->count = nextCount;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to collect the living cells of the playboard into its live cell
+// list, after the cells were edited. The list is allocated by the first call.
+//------------------------------------------------------------------------------
+bool rebuildLiveList(struct playBoard* gameBoard) {
+  struct liveList* list = gameBoard->liveList;
+  unsigned int count = 0;
+
+  if (list == NULL) {
+    list = memoryAllocateZeroed(MEMORY_CELLS, 1, sizeof(struct liveList));
+
+    if (list == NULL) {
+      printf("[ERROR] Could not reserve memory for the list engine.\n");
+      return false;
+    }
+
+    gameBoard->liveList = list;
+  }
+
+  // The changes of the turns before are not known anymore
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    count += gameBoard->cells[i].isLiving;
+    gameBoard->cells[i].cellChanged = false;
+  }
+
+  list->cellsX = gameBoard->cellsX;
+  list->cellsY = gameBoard->cellsY;
+  list->changedCount = 0;
+
+  if (!reserveLiveList(list, gameBoard->cellsY, count)) {
+    return false;
+  }
+
+  list->rowCount = 0;
+  list->count = 0;
+  list->rowStarts[0] = 0;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (gameBoard->cells[i].isLiving) {
+      appendLiveCell(list, i % gameBoard->cellsX, i / gameBoard->cellsX);
+    }
+  }
+
+  gameBoard->isEdited = false;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn with the rule of the playboard by its live cell
+// list. The lists before and after the turn are walked together and only the
+// cells in one of them are set on the playboard and collected as changes, so
+// the playboard is kept for drawing and saving without visiting all cells.
+// Rules with births by 0 neighbours fill the playboard, they take the flat
+// Moore turn and the list is collected again afterwards.
+//------------------------------------------------------------------------------
+void applyTurnList(struct playBoard* gameBoard, bool isInHistory) {
+  if (gameBoard->birthRule & 1) {
+    applyTurnMoore(gameBoard, isInHistory);
+    gameBoard->isEdited = true;
+    return;
+  }
+
+  if ((gameBoard->isEdited || gameBoard->liveList == NULL) && !rebuildLiveList(gameBoard)) {
+    return;
+  }
+
+  struct liveList* list = gameBoard->liveList;
+  unsigned int rowCount = list->rowCount;
+
+  // The cells changed by the turn before are unchanged by this one, until they change again
+  for (unsigned int c = 0; c < list->changedCount; ++c) {
+    gameBoard->cells[list->changed[c]].cellChanged = false;
+  }
+
+  list->changedCount = 0;
+
+  if (!evolveLiveList(list, gameBoard->birthRule, gameBoard->survivalRule)) {
+    return;
+  }
+
+  unsigned int before = 0;
+  unsigned int after = 0;
+
+  gameBoard->changedCount = 0;
+
+  while (before < rowCount || after < list->rowCount) {
+    int beforeRow = before < rowCount ? list->nextRows[before] : INT_MAX;
+    int afterRow = after < list->rowCount ? list->rows[after] : INT_MAX;
+    int y = beforeRow < afterRow ? beforeRow : afterRow;
+    unsigned int b = beforeRow == y ? list->nextRowStarts[before] : 0;
+    unsigned int bEnd = beforeRow == y ? list->nextRowStarts[before + 1] : 0;
+    unsigned int a = afterRow == y ? list->rowStarts[after] : 0;
+    unsigned int aEnd = afterRow == y ? list->rowStarts[after + 1] : 0;
+
+    while (b < bEnd || a < aEnd) {
+      int beforeX = b < bEnd ? list->nextColumns[b] : INT_MAX;
+      int afterX = a < aEnd ? list->columns[a] : INT_MAX;
+
+      if (beforeX == afterX) {
+        ++b;
+        ++a;
+        continue;
+      }
+
+      // A cell only after the turn is born, a cell only before it died
+      bool isBorn = afterX < beforeX;
+      unsigned int i = (y * gameBoard->cellsX) + (isBorn ? afterX : beforeX);
+
+      a += isBorn;
+      b += !isBorn;
+      gameBoard->cells[i].isLiving = isBorn;
+      gameBoard->cells[i].cellChanged = true;
+      gameBoard->livingCells += isBorn ? 1 : -1;
+      list->changed[list->changedCount++] = i;
+
+      if (gameBoard->changedIndex != NULL) {
+        gameBoard->changedIndex[gameBoard->changedCount++] = i;
+      }
+    }
+
+    before += beforeRow == y;
+    after += afterRow == y;
+  }
+
+  gameBoard->isDirty = list->changedCount > 0;
+
+  // The noise flips cells as part of the turn, the list is rebuilt from them
+  if (!isInHistory && (gameBoard->birthNoise != 0 || gameBoard->deathNoise != 0)) {
+    applyNoise(gameBoard);
+  }
+
+  // Increase the turn count of playboard by one and avoid overflow
+  if (!isInHistory && ++gameBoard->turns > TURN_LIMIT) {
+    gameBoard->turns = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the engine choice of the auto turn engine. It starts
+// with the flat engine, the default costs pick the list engine after the
+// first turns on sparse playboards. Switches are printed if logged. With
+// autoEngineSwitchTurns set the engines take turns at a fixed count instead.
+//------------------------------------------------------------------------------
+bool initAutoEngine(struct playBoard* gameBoard, bool isLogged) {
+  struct autoEngine* policy = memoryAllocateZeroed(MEMORY_CELLS, 1, sizeof(struct autoEngine));
+
+  if (policy == NULL) {
+    printf("[ERROR] Could not reserve memory for the auto turn engine.\n");
+    return false;
+  }
+
+  policy->costs[0] = autoEngineCosts[0];
+  policy->costs[1] = autoEngineCosts[1];
+  policy->switchTurns = autoEngineSwitchTurns;
+  policy->isLogged = isLogged;
+  gameBoard->autoEngine = policy;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to apply a turn by the engine predicted to be the fastest. Each
+// turn is timed and the cost per unit of work of the playing engine follows
+// it. Then both engines are predicted by their work on the playboard after
+// the turn: the flat engine by its cells, the list engine by the living
+// cells and the cells changed by the turn. The other engine has to be faster
+// by the margin for a number of turns in a row, and the playing one has to
+// have played as many turns, before the playboard moves to it. A fixed switch turn count skips the timing, so the
+// switches do not depend on the speed of the machine.
+//------------------------------------------------------------------------------
+void applyTurnAuto(struct playBoard* gameBoard, bool isInHistory) {
+  if (gameBoard->autoEngine == NULL && !initAutoEngine(gameBoard, false)) {
+    applyTurnMoore(gameBoard, isInHistory);
+    return;
+  }
+
+  struct autoEngine* policy = gameBoard->autoEngine;
+  int current = policy->engine;
+  int other = 1 - current;
+
+  if (policy->switchTurns != 0) {
+    autoEngines[current].applyTurn(gameBoard, isInHistory);
+
+    if (++policy->turnsPlayed >= policy->switchTurns) {
+      switchAutoEngine(gameBoard, other);
+    }
+
+    return;
+  }
+
+  double works[2] = { gameBoard->cellCount, gameBoard->livingCells + gameBoard->changedCount + 1.0 };
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  autoEngines[current].applyTurn(gameBoard, isInHistory);
+
+  double nanoseconds = benchmarkNanoseconds(start);
+
+  // The first turn after a switch also moves the playboard, it is not learned
+  if (policy->turnsPlayed++ > 0) {
+    policy->costs[current] += AUTO_ENGINE_LEARNING * ((nanoseconds / works[current]) - policy->costs[current]);
+  }
+
+  double predicted[2] = {
+    policy->costs[0] * gameBoard->cellCount,
+    policy->costs[1] * (gameBoard->livingCells + gameBoard->changedCount + 1.0)
+  };
+
+  policy->favoured = predicted[other] < predicted[current] * AUTO_ENGINE_MARGIN ? policy->favoured + 1 : 0;
+
+  if (policy->favoured < AUTO_ENGINE_TURNS || policy->turnsPlayed < AUTO_ENGINE_TURNS) {
+    return;
+  }
+
+  if (policy->isLogged) {
+    printf("[STATUS] Turn %u: switching from the %s to the %s engine, %u living cells (%.1f%%), %.1f%% of them changed, %.0f ns per turn, %.0f ns predicted.\n",
+      gameBoard->turns, autoEngines[current].name, autoEngines[other].name, gameBoard->livingCells, 100.0 * gameBoard->livingCells / gameBoard->cellCount,
+      gameBoard->livingCells > 0 ? 100.0 * gameBoard->changedCount / gameBoard->livingCells : 0, predicted[current], predicted[other]);
+  }
+
+  switchAutoEngine(gameBoard, other);
+}
+
+//------------------------------------------------------------------------------
+// Function to move the playboard of the auto engine to another engine. The
+// list engine collects its lists from the cells, the flat engine frees them.
+//------------------------------------------------------------------------------
+void switchAutoEngine(struct playBoard* gameBoard, int engine) {
+  struct autoEngine* policy = gameBoard->autoEngine;
+
+  policy->engine = engine;
+  policy->favoured = 0;
+  policy->turnsPlayed = 0;
+  ++policy->switches;
+
+  if (autoEngines[engine].applyTurn == applyTurnList) {
+    gameBoard->isEdited = true;
+  } else {
+    freeLiveList(gameBoard->liveList);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Create a random playboard state. Every random playboard draws its cells from
+// its own counter, counted down from the top so they never meet the turns of
+// the noise. With a fixed seed the playboards repeat in the same order.
+//------------------------------------------------------------------------------
+void initRandomBoard(struct playBoard* gameBoard, struct options* gameOptions) {
+  uint64_t seed = gameOptions->randomSeed != 0 ? gameOptions->randomSeed : ((uint64_t) time(NULL) << 32) ^ (uint64_t) clock();
+  uint64_t counter = ~(uint64_t) gameOptions->randomBoards++;
+
+  // Reset the playboard
+  resetPlayboard(gameBoard);
+
+  // Between 25 and 100 percent of the maximum fit cells are born, the draw after the last cell picks the share
+  double share = ((counterRandom(seed, counter, gameBoard->cellCount) % 75) + 25) * 0.01;
+  uint64_t threshold = probabilityThreshold(gameOptions->maximumFitCellsForRandom * share / gameBoard->cellCount);
+
+  // The voxels of 3D Life are drawn with the same chance as the cells
+  if (gameBoard->lifeCube != NULL) {
+    fillLifeCube(gameBoard, seed, counter, threshold);
+    return;
+  }
+
+  //----------------------------------------------------------------------------
+  // Set random cells active
+  //----------------------------------------------------------------------------
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (counterRandom(seed, counter, i) < threshold) {
+      journalCell(gameBoard, i);
+      gameBoard->cells[i].isLiving = true;
+
+      // Set the cell state for animation
+      gameBoard->cells[i].size = 0;
+      gameBoard->cells[i].cellChanged = true;
+
+      ++gameBoard->livingCells;   // Increase the living cell count on the playboard, as we created a living cell
+
+      // The cells of Immigration and QuadLife get random colours, the cells of Lenia random states, drawn after the share
+      if (gameBoard->colourLife != NULL) {
+        setCellColour(gameBoard, i, counterRandom(seed, counter, gameBoard->cellCount + 1 + i) % gameBoard->colourLife->colourCount);
+      } else if (gameBoard->lenia != NULL) {
+        gameBoard->lenia->states[i] = LENIA_VISIBLE + ((1 - LENIA_VISIBLE) * (counterRandom(seed, counter, gameBoard->cellCount + 1 + i) >> 11) / 9007199254740992.0);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to set a options message to be display to the user
+//------------------------------------------------------------------------------
+void set_options_message(struct options* gameOptions, char message[]) {
+  sprintf(gameOptions->message, message);
+  gameOptions->hasMessage = true;
+  gameOptions->messageTicks = 50;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the index of the cell under a window position, the cell
+// count if the position is outside of the cells
+//------------------------------------------------------------------------------
+unsigned int getCellIndexAt(struct playBoard* gameBoard, double x, double y) {
+  int cellY = floor(y / gameBoard->cellHeight);
+
+  // Odd rows of a hexagonal playboard are drawn shifted right by half a cell
+  if (gameBoard->neighbourhood == HEXAGONAL && (cellY & 1)) {
+    x -= gameBoard->cellWidth / 2.0;
+  }
+
+  int cellX = floor(x / gameBoard->cellWidth);
+
+  if (cellX < 0 || cellY < 0 || cellX >= gameBoard->cellsX || cellY >= gameBoard->cellsY) {
+    return gameBoard->cellCount;
+  }
+
+  return cellX + (cellY * gameBoard->cellsX);
+}
+
+//------------------------------------------------------------------------------
+// Function to paint cells with the mouse when painting mode is enabled
+//------------------------------------------------------------------------------
+void paintCell(SDL_Event* appEvent, struct playBoard* gameBoard, bool isMotionEvent) {
+  if (!isMotionEvent) {
+    // Its a mousebutton event
+
+    // The index in the playboard cell array
+    unsigned int index = getCellIndexAt(gameBoard, appEvent->button.x, appEvent->button.y);
+
+    // A click on Wireworld copper starts an electron
+    if (index < gameBoard->cellCount && gameBoard->wireWorld != NULL && gameBoard->states != NULL && gameBoard->states[index] == WIRE_COPPER) {
+      gameBoard->states[index] = WIRE_HEAD;
+      return;
+    }
+
+    // The index is valid, paint the cell living and increase living cell count by one
+    if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
+      journalCell(gameBoard, index);
+      gameBoard->cells[index].isLiving = true;
+      ++gameBoard->livingCells;
+    }
+
+    return;
+  }
+
+  // Its a motion event, try to apply smoothing
+  int xDistance = appEvent->motion.xrel;  // The total x distance we traveled from last move event
+  int yDistance = appEvent->motion.yrel;  // The total y distance we traveled from last move event
+  unsigned int index = 0; // The array index
+
+  // Check if our drawing would hit the boundaries in x
+  if (xDistance < 0 && appEvent->motion.x + xDistance < 0) {
+    xDistance = appEvent->motion.x;
+  } else if (xDistance > 0 && appEvent->motion.x + xDistance > gameBoard->width) {
+    xDistance = gameBoard->width - appEvent->motion.x;
+  }
+
+  // Check if our drawing would hit the boundaries in y
+  if (yDistance < 0 && appEvent->motion.y + yDistance < 0) {
+    yDistance = appEvent->motion.y;
+  } else if (yDistance > 0 && appEvent->motion.y + yDistance > gameBoard->height) {
+    yDistance = gameBoard->height - appEvent->motion.y;
+  }
+
+  // Check if xDistance or y distance is either zero so we fill one axis
+  if (xDistance == 0 || yDistance == 0) {
+
+    // How much do we increase
+    int stepWidth = 0;
+
+    // How many steps do we take?
+    int steps = abs(xDistance) > abs(yDistance) ? abs(xDistance) : abs(yDistance);
+
+    if (xDistance == 0) {
+      // We only have movement in the y-axis
+      stepWidth = yDistance < 0 ? -1 : 1; // Positive or negative multiplicator
+
+      // Paint all relevant indexes
+      for (int i = 0; i < steps; ++i) {
+        index = getCellIndexAt(gameBoard, appEvent->motion.x, appEvent->motion.y + (stepWidth * i));
+
+        // The index is valid, paint the cell living and increase living cell count by one
+        if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
+          journalCell(gameBoard, index);
+          gameBoard->cells[index].isLiving = true;
+          ++gameBoard->livingCells;
+        }
+      }
+    } else {
+      // We only have movement in the x-axis
+      stepWidth = xDistance < 0 ? -1 : 1; // Positive or negative multiplicator
+
+      // Paint all relevant indexes
+      for (int i = 0; i < steps; ++i) {
+        index = getCellIndexAt(gameBoard, appEvent->motion.x + (stepWidth * i), appEvent->motion.y);
+
+        // The index is valid, paint the cell living and increase living cell count by one
+        if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
+          journalCell(gameBoard, index);
+          gameBoard->cells[index].isLiving = true;
+          ++gameBoard->livingCells;
+        }
+      }
+    }
+
+  } else {
+    // The largest distance determines how many steps we take
+    int steps = abs(xDistance) > abs(yDistance) ? abs(xDistance) : abs(yDistance);
+
+    // How much do we increase x and y in every stepped round?
+    double stepWidthX = (double) xDistance / steps; // Positive or negative additition for the x-axis
+    double stepWidthY = (double) yDistance / steps; // Positive or negative additition for the y-axis
+
+    // Store the increment of x and y
+    double increaseX = 0.0;
+    double increaseY = 0.0;
+
+    for (int i = 0; i < steps; ++i) {
+      // Get the index, increase x by step and y by a rounded float increament each time
+      index = getCellIndexAt(gameBoard, appEvent->motion.x + ceil(increaseX), appEvent->motion.y + ceil(increaseY));
+
+      // The index is valid, paint the cell living and increase living cell count by one
+      if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
+        journalCell(gameBoard, index);
+        gameBoard->cells[index].isLiving = true;
+        ++gameBoard->livingCells;
+      }
+
+      // Increase x and y by it stepwidth factor
+      increaseX += stepWidthX;
+      increaseY += stepWidthY;
+    }
+  }
+
+}
+
+
+//------------------------------------------------------------------------------
+// Function to generate cell content from 24 bit png images
+//------------------------------------------------------------------------------
+bool generateCellMapFromImage(char* droppedFilePath, struct playBoard* gameBoard, struct options* gameOptions) {
+  FILE* inputFile = fopen(droppedFilePath, "rb");
+
+  // If we couldnt open the file for reading, its not usable
+  // We could perform this check with access so, but this requires gnu technology
+  if (inputFile == NULL) {
+    set_options_message(gameOptions, "Image file not accessiable.");
+    return false;
+  }
+
+  // Close it we dont use it anymore, we have read access
+  fclose(inputFile);
+
+  // Check the filepath ending
+  int pathSize = strlen(droppedFilePath);
+  if (pathSize <= 3) {
+    set_options_message(gameOptions, "Filename without ");
+    return false;
+  }
+
+  char* fileType = strrchr(droppedFilePath, '.');
+
+  if (fileType == NULL) {
+    set_options_message(gameOptions, "Image missing \".\" in name.");
+    return false;
+  }
+
+  // Lower the fileType for checking
+  for (int i = strlen(fileType)-1; i > 0; --i) {
+    fileType[i] = tolower(fileType[i]);
+  }
+
+  // Check if the filename is a supported png...
+  if (strcmp(fileType, ".png") != 0) {
+    // Its sees to be a unsupported filetype
+    set_options_message(gameOptions, "Only png images are supported.");
+    return false;
+  }
+
+  // The image loading is initialized on the first import
+  if (!ensureImageLoading()) {
+    set_options_message(gameOptions, "Image loading error, check console.");
+    return false;
+  }
+
+  // Assign a surface and load the image
+  SDL_Surface* imageSurface = IMG_Load(droppedFilePath);
+
+  // Check if the file was loading properly
+  if (imageSurface == NULL) {
+    set_options_message(gameOptions, "Image loading error, check console.");
+    printf("[ERROR] Image loading errror:\n%s\n\n", IMG_GetError());
+    return false;
+  }
+
+
+  // Finally, work with the surface
+  if (imageSurface->format->BitsPerPixel < 32 ) {
+    SDL_FreeSurface(imageSurface);
+    set_options_message(gameOptions, "Only 32 bit png images are supported.");
+    return false;
+  }
+
+  unsigned int imgWidth = imageSurface->w;    // The image width
+  unsigned int imgHeight = imageSurface->h;   // The image height
+
+  // How many image pixels are average for one cell in x and y
+  unsigned int xPixelPerCell = floor((double) imgWidth / gameBoard->cellsX);
+  unsigned int yPixelPerCell = floor((double) imgHeight / gameBoard->cellsY);
+
+  // The total amount of image pixels one conway cell covers/is averaged from
+  unsigned int totalPixelPerCell = xPixelPerCell * yPixelPerCell;
+
+  // What is the maximum limit in x and y we cover with our cells, this is used to determe the borders
+  unsigned int limitX = imgWidth; // - round((double) imgWidth / gameBoard->cellsX);
+  unsigned int limitY = imgHeight; // - round((double) imgHeight / gameBoard->cellsY);
+
+  // In case we have less then one by one pixel representation, we stop here
+  if (xPixelPerCell < 1 || yPixelPerCell < 1) {
+    SDL_FreeSurface(imageSurface);
+    set_options_message(gameOptions, "Image pixel size should be bigger then x and y count of the conway cells.");
+    return false;
+  }
+
+  // Reset the game board, Immigration and QuadLife keep the cells of the images before in their colours
+  unsigned int colour = 0;
+
+  if (gameBoard->colourLife == NULL) {
+    resetPlayboard(gameBoard);
+  } else {
+    colour = gameBoard->colourLife->imports++ % gameBoard->colourLife->colourCount;
+    gameBoard->colourLife->pen = colour;
+  }
+
+  unsigned int index = 0;       // Index of the conway cell in the array of cells
+  unsigned int tempOffset = 0;  // The offset of a pixel in the image, used for calulation to retrive colors
+
+  unsigned int workingX = 0;    // The maximum x offset we are scanning to/from, starting from workingX - xPixelPerCell
+  unsigned int workingY = 0;    // The maximum y offset we are scanning to/from, starting from workingY - yPixelPerCell
+
+  // The color storages in RGB and averages by amount of samples
+  unsigned int rValue = 0;      // The added red color value
+  unsigned int gValue = 0;      // The added green color value
+  unsigned int bValue = 0;      // The added blue color value
+  unsigned int rAverage = 0;    // The red average of rValue divided by samples
+  unsigned int gAverage = 0;    // The green average of gValue divided by samples
+  unsigned int bAverage = 0;    // The blue average of bValue divided by samples
+
+  // Lock the sdl surface
+  SDL_LockSurface(imageSurface);
+
+  // Get the pixeldata from the image surface in a Uin32 pointer for access
+  Uint32* pixelData32bit = (Uint32 *)imageSurface->pixels;
+
+  //----------------------------------------------------------------------------
+  // Analyze the image
+  //----------------------------------------------------------------------------
+
+  // Set the working Y to init with yPixelPercel as boundary
+  workingY = yPixelPerCell;
+  int row = 0;
+
+  // Process loop
+  while (true) {
+
+    // Incease workingX
+    workingX += xPixelPerCell;
+
+    // Would this read of the image limit in X?
+    if (workingX > limitX) {
+      // Yes, we are at the right boundary of the image
+      workingX = xPixelPerCell;   // Reset working x to left
+      workingY += yPixelPerCell;  // Increase the row in y
+
+      ++row;
+      index = (row * gameBoard->cellsX) - row;
+
+      if (workingY > limitY) {
+        // We break the loop as reading is over the boundaries of what can/should be read
+        break;
+      }
+    }
+
+    // Reset the rgb values to zero to start a new count
+    rValue = 0;
+    gValue = 0;
+    bValue = 0;
+
+    // Retrieve the color values of the image area we are scanning in
+    for (unsigned int j = workingX - xPixelPerCell; j < workingX; ++j) {
+      for (unsigned int i = workingY - yPixelPerCell; i < workingY; ++i) {
+        tempOffset = j + (i * imgWidth) - i;  // At which image pixel we are reading from
+
+        // Read in the r and g and b color values from the pixel
+        rValue += ((pixelData32bit[tempOffset] & imageSurface->format->Rmask) >> imageSurface->format->Rshift) << imageSurface->format->Rloss;
+        gValue += ((pixelData32bit[tempOffset] & imageSurface->format->Gmask) >> imageSurface->format->Gshift) << imageSurface->format->Gloss;
+        bValue += ((pixelData32bit[tempOffset] & imageSurface->format->Bmask) >> imageSurface->format->Bshift) << imageSurface->format->Bloss;
+      }
+    }
+
+    // Get the average value of the rgb colorspace divided by number of samples
+    rAverage = rValue / totalPixelPerCell;
+    gAverage = gValue / totalPixelPerCell;
+    bAverage = bValue / totalPixelPerCell;
+
+    // Is the sum of all colors over the threshold?
+    if ((rAverage + gAverage + bAverage) <= gameOptions->colorThreshold) {
+      if (gameBoard->colourLife != NULL) {
+        setCellColour(gameBoard, index, colour);
+      } else {
+        // Turn the cell on living and set its animation state
+        journalCell(gameBoard, index);
+        gameBoard->cells[index].isLiving = true;
+        gameBoard->cells[index].cellChanged = true;
+        ++gameBoard->livingCells;
+      }
+    }
+
+    // Increase the working index
+    ++index;
+
+    // If in any case, the index would hit the playboard cell count, break
+    if (index >= gameBoard->cellCount-1) {
+      break;
+    }
+
+  }
+
+  // Unlock the sdl image surface
+  SDL_UnlockSurface(imageSurface);
+
+  // Free the image surface
+  SDL_FreeSurface(imageSurface);
+
+  // Everything well, return true
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to reset the playboard to initial state
+//------------------------------------------------------------------------------
+void resetPlayboard(struct playBoard* gameBoard) {
+  // Reset the playboard cells...
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (gameBoard->cells[i].isLiving) {
+      journalCell(gameBoard, i);
+    }
+
+    gameBoard->cells[i].size = 0;
+    gameBoard->cells[i].isLiving = false;
+    gameBoard->cells[i].cellChanged = false;
+  }
+
+  // ... and turns and living cells
+  gameBoard->turns = 0;
+  gameBoard->livingCells = 0;
+  gameBoard->isEdited = true;
+
+  // ... and the noise, its draws are keyed by the turns counted from 0 again
+  if (gameBoard->birthNoise != 0 || gameBoard->deathNoise != 0) {
+    gameBoard->noiseSeed = mixBits(gameBoard->noiseSeed ^ 0x9E3779B97F4A7C15ull);
+  }
+
+  // ... and all voxels of 3D Life, not only the shown ones
+  if (gameBoard->lifeCube != NULL) {
+    resetLifeCube(gameBoard->lifeCube);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate a playboard of cellsX by cellsY cells, drawn on width
+// by height pixels, with all cells not living
+//------------------------------------------------------------------------------
+bool initPlayBoard(struct playBoard* gameBoard, int width, int height, int cellsX, int cellsY) {
+  gameBoard->isDirty = true;
+  sprintf(gameBoard->status, "[PAUSED]");
+  gameBoard->width = width;
+  gameBoard->height = height;
+  gameBoard->cellsX = cellsX;
+  gameBoard->cellsY = cellsY;
+  gameBoard->cellWidth = width / cellsX;
+  gameBoard->cellHeight = height / cellsY;
+  gameBoard->cellCount = cellsX * cellsY;
+  gameBoard->livingCells = 0;
+  gameBoard->turns = 0;
+  gameBoard->changedCount = 0;
+  gameBoard->neighbourhood = MOORE;
+  gameBoard->birthRule = neighbourhoods[MOORE].birthRule;
+  gameBoard->survivalRule = neighbourhoods[MOORE].survivalRule;
+  fillTotalisticTable(gameBoard->ruleTable, gameBoard->birthRule, gameBoard->survivalRule);
+  gameBoard->states = NULL;
+  gameBoard->stateTable = NULL;
+  gameBoard->noiseSeed = 0;
+  gameBoard->birthNoise = 0;
+  gameBoard->deathNoise = 0;
+  gameBoard->wireWorld = NULL;
+  gameBoard->colourLife = NULL;
+  gameBoard->lifeCube = NULL;
+  gameBoard->elementary = NULL;
+  gameBoard->lenia = NULL;
+  gameBoard->liveList = NULL;
+  gameBoard->autoEngine = NULL;
+  gameBoard->journal = NULL;
+  gameBoard->isEdited = true;
+
+  // Get memory of the gameboard cells
+  gameBoard->cells = memoryAllocate(MEMORY_CELLS, sizeof(struct cell) * gameBoard->cellCount);
+  gameBoard->changedIndex = memoryAllocate(MEMORY_CELLS, sizeof(unsigned int) * gameBoard->cellCount);
+
+  if (gameBoard->cells == NULL || gameBoard->changedIndex == NULL) {
+    freePlayBoard(gameBoard);
+    return false;
+  }
+
+  for (int y = 0; y < cellsY; ++y) {
+    for (int x = 0; x < cellsX; ++x) {
+
+      // The offset in the array
+      int offset = x + (y * cellsX);
+
+      // Set default to not living
+      gameBoard->cells[offset].isLiving = false;
+
+      // The x and y position off the cell used for drawing
+      gameBoard->cells[offset].x = x * gameBoard->cellWidth;
+      gameBoard->cells[offset].y = y * gameBoard->cellHeight;
+
+      // The x and y location of the grid field in the gameboard
+      gameBoard->cells[offset].cellX = x;
+      gameBoard->cells[offset].cellY = y;
+
+      // Animation properties
+      gameBoard->cells[offset].cellChanged = false;
+      gameBoard->cells[offset].size = 0.0;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the cells of a playboard
+//------------------------------------------------------------------------------
+void freePlayBoard(struct playBoard* gameBoard) {
+  memoryFree(gameBoard->cells);
+  memoryFree(gameBoard->changedIndex);
+  memoryFree(gameBoard->states);
+  freeLiveList(gameBoard->liveList);
+  memoryFree(gameBoard->liveList);
+  memoryFree(gameBoard->autoEngine);
+  gameBoard->cells = NULL;
+  gameBoard->changedIndex = NULL;
+  gameBoard->states = NULL;
+  gameBoard->liveList = NULL;
+  gameBoard->autoEngine = NULL;
+}
+
+//------------------------------------------------------------------------------
+// Function to print out the help
+//------------------------------------------------------------------------------
+void printHelp() {
+  printf("\n\nGENERAL HELP\n\nThis is Conway's Game of life.\nYou can either paint living cells, using the mouse in paint mode\nor drag and drop a 32 bit png with alpha channel into the game window,\nthis will generate a cell map varying from the image.\n\nImages should be equal in there dimensions in order to reach the best effect.\nFor example a one by one ratio, divisble by the cells in x and y to the image pixel dimensions.\nFor generation you could use The Gimp or save out images from the game using \"s\" key.\nExample images are incuded which are all consisting of 32bit PNG images with alpha.\n");
+  printf("\nSAVING IMAGES AND DRAG AND DROP\n\nIf you want to save an image, you can do so by pressing \"s\" key.\nIt is then saved to the folder \"saved_images/TIMESTAMP.png\".\nThe routine saves everything except the grid and the message displayed inside the game window.\nThose images can be reimported into the application, like other images, by drag and drop.\n\nNote that CAIRO backend png's, switch \"-cb\", cannot directly be imported as they are missing the alpha channel.\nYou have to use The Gimp or similiar to add an alpha channel, then import is working!\n");
+  printf("\nPATTERN STAMPS\n\nIn paint mode the keys \"1\" to \"9\" select a pattern of the built-in catalog,\nwhich is stamped centered on the clicked cell. Additional patterns are loaded from\nthe .rle files inside the \"patterns\" folder, cycle through all patterns with \"n\" key.\n\"t\" rotates the pattern clockwise, \"f\" flips it and \"0\" returns to painting single cells.\n");
+  printf("\nSELECTIONS\n\nIn paint mode a rectangle is selected by dragging with the right mouse button.\n\"ctrl + c\" copies, \"ctrl + x\" cuts and \"ctrl + v\" pastes the clipboard by click, like a pattern stamp.\n\"ctrl + i\" inverts, \"ctrl + r\" fills the selection randomly by the maximum fit cells ratio (-mfc),\n\"delete\" clears the selection and \"ctrl + d\" removes it.\n\n\"ctrl + f\" searches all occurrences of the selected pattern stamp in all 8 orientations.\nMatches are outlined and listed on the console, the pattern must be surrounded by dead cells.\n");
+  printf("\nOBJECT TRACKING\n\nThe \"o\" key tracks the active objects after each turn. Objects are found around the changed cells,\nfollowed from turn to turn, also across the playboard borders. If the shape of an object repeats,\nits period, velocity and heading are printed on the console. The info panel (\"i\" key) shows the\nmoving objects by speed and heading, \"c/4 SE\" is a glider moving down right.\n");
+  printf("\nINFO PANEL USAGE\n\nIf the history is enabled (\"h\" key) - and the info panel enabled,\nthree bars are shown at the bottom of the screen. When the mouse is moved on\ntop of those bars, either:\n\t- Stable cells are shown, which didnt change in this turn or survived\n\t- Born cells. cells which did become born during a turn\n\t- Dead cells, which died during this turn\n\nIf you hover over the corresponding bar, you see the exact cells highlighted.\nAnd there counts are always displayed on the bars.\n");
+  printf("\nAVAILABLE COMMANDS\n");
+  printf("-h\t\t\t\tThis help\n");
+  printf("-c5 ... 250\t\t\tAmount of cells in x and y by one number from 5 to 250 (default: 50)\n");
+  printf("-ct0.0 ... 1.0\t\t\tFloating point value 0.5 for 50 percent color threshold (default: 0.85)\n\t\t\t\t(rgb added together and averaged) for living cell image generation, below the set value\n");
+  printf("-mfc0.0 ... 1.0\t\t\tMaximum fit cells for random number generator (default 0.4)\n");
+  printf("-ul1 ... n\t\t\tMemory cap of the undo journal in kilobytes (default: %d)\n", UNDO_LIMIT_KB);
+  printf("-verify[1 ... n]\t\tVerify all turn engines against the reference on known patterns and n random\n\t\t\t\tplayboards (default: 100) without starting the game, failures are written as .rle files\n");
+  printf("-bench[FILE]\t\t\tTime the turn engines, the offscreen rendering, the history and the image import and\n\t\t\t\texport, write the results to a JSON file (default: benchmark.json)\n");
+  printf("-benchcompare OLD NEW\t\tCompare two benchmark result files, exits with an error on a regression\n");
+  printf("-bt0.0 ... 1.0\t\t\tSlowdown a benchmark case may show before it is a regression (default: %.2f)\n", BENCH_THRESHOLD);
+  printf("--record-input FILE\t\tRecord the input events of the session with a fixed random seed to a file\n");
+  printf("--replay-input FILE\t\tReplay a recorded session as fast as possible and report the frame times,\n\t\t\t\talso written to FILE.json for -benchcompare\n");
+  printf("--startup-report\t\tPrint the time of each phase of the program start up to the first frame\n");
+  printf("-stall1 ... n\t\t\tFrame time in milliseconds which dumps the latest events to %s (default: %d)\n", FLIGHT_RECORDER_FILE, FLIGHT_STALL_MS);
+  printf("-nbNAME\t\t\t\tNeighbourhood of the cells: moore (default), hex for a hexagonal grid or vn for von Neumann\n");
+  printf("-engineNAME\t\t\tTurn engine of moore rules: reference (default), moore, isotropic, table, list or auto,\n\t\t\t\tthe list engine keeps the living cells only, auto switches between moore and list\n");
+  printf("-ruleB3/S23\t\t\tBirth and survival counts of living neighbours (default: B3/S23, hex B2/S34, vn B23/S2)\n");
+  printf("\t\t\t\tMoore rules take Hensel letters per count, B2-a3/S12 is born with 2 except the adjacent ones\n");
+  printf("-tableFILE\t\t\tPlay the multi-state automaton of a Golly .rule file with a @TABLE or of a .table file\n");
+  printf("-pb0.0 ... 1.0\t\t\tProbability of a dead cell to be born by noise after each turn (default: 0)\n");
+  printf("-pd0.0 ... 1.0\t\t\tProbability of a living cell to die by noise after each turn (default: 0)\n");
+  printf("-wireworld\t\t\tPlay Wireworld, living cells are copper and a click on copper starts an electron\n");
+  printf("-immigration\t\t\tPlay Immigration, newborn cells take the colour of most of their parents, of 2 colours\n");
+  printf("-quadlife\t\t\tPlay QuadLife, like Immigration with 4 colours, parents of 3 colours give the fourth\n");
+  printf("-cubeRULE\t\t\tPlay 3D Life on a cube of the cells in x, y and z by a rule like 4555 or 5,7,6,6\n\t\t\t\t(survival from, to, birth from, to), arrow keys move the slice, \"v\" shows all\n");
+  printf("-eca0 ... 255\t\t\tPlay the elementary 1D automaton of a rule number, like 30 or 110, as spacetime diagram\n");
+  printf("-leniaR[,MU,SIGMA,T]\t\tPlay Lenia with continuous states, a ring kernel of the radius R and the growth\n\t\t\t\taround MU of the width SIGMA, T steps a unit of time (default: 13,0.15,0.015,10)\n");
+  printf("-seed1 ... n\t\t\tSeed of the random playboards and the noise, the same seed repeats a run (default: time)\n");
+  printf("\nStart options of boolean type either 0/1 or t/f AND (also in game options/keybindings):\n\n");
+  printf("-gBOOL\t+[KEY]\t\t\tGrid enabled (t)rue or 1 or disabled (f)alse or 0 - (\"g\" key in game)\n");
+  printf("-aBOOL\t+[KEY]\t\t\tAnimations enabled or disabled (\"a\" key in game to toggle)\n");
+  printf("-htBOOL\t+[KEY]\t\t\tHistory enabled or disabled (Toggled using \"h\" key in game)\n");
+  printf("-iBOOL\t+[KEY]\t\t\tDraw infopanel when history is enabled and one turn is processed (Toggled with \"i\" key)\n");
+  printf("-r\t+[KEY]\t\t\tShould the game start with a random playboard, be regenerated with a\n\t\t\t\trandom playboard (\"r\" key in game)\n");
+  printf("\n-cb\t\t\t\tShould cairo's png functions be used instead of libpng to save images\n\t\t\t\tCairo backend images cannot be imported directly! Please read the help for more information.\n");
+  printf("\n[KEY] \"s\"\t\t\tSaves the actual scene, including the info panel if displayed (\"s\" key in game)\n");
+  printf("[KEY] \"+\" (not numpad)\t\tDecrease game ticks and increase game speed (\"+\" key in game)\n");
+  printf("[KEY] \",\"\t\t\tGo back in history, if enabled (\",\" key in game)\n");
+  printf("[KEY] \".\"\t\t\tGo forward in history, if enabled (\".\" key in game)\n");
+  printf("[KEY] \"c\"\t\t\tClear game board (\"c\" key in game)\n");
+  printf("[KEY] \"p\"\t\t\tPaint mode (\"p\" key in game)\n");
+  printf("[KEY] \"o\"\t\t\tTrack moving objects, shown in the info panel (\"o\" key in game)\n");
+  printf("[KEY] \"m\"\t\t\tShow the current and peak memory of each subsystem, printed at exit too (\"m\" key in game)\n");
+  printf("[KEY] \"1\" ... \"9\"\t\tSelect a pattern stamp in paint mode, \"n\" selects the next pattern and \"0\" paints single cells\n");
+  printf("[KEY] \"t\" / \"f\"\t\t\tRotate / flip the selected pattern stamp in paint mode\n");
+  printf("[KEY] \"Space\"\t\t\tPlay/Pause the game (\"space\" key in game)\n");
+  printf("[KEY] \"ctrl + z\" / \"ctrl + y\"\tUndo / redo the last edit: painting, stamps, selections, image drops, clear and random playboards\n");
+}
+
+//------------------------------------------------------------------------------
+// Function to clear the game history
+//------------------------------------------------------------------------------
+bool clearHistory(struct gameHistoryGame* gameHistory) {
+  if (gameHistory->turnData == NULL) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < gameHistory->turns; ++i) {
+    memoryFree(gameHistory->turnData[i].state);
+    memoryFree(gameHistory->turnData[i].index);
+  }
+
+  memoryFree(gameHistory->turnData);
+  gameHistory->turnData = NULL;
+  gameHistory->turns = 0;
+  gameHistory->currentTurn = 0;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to add a turn to the history
+//------------------------------------------------------------------------------
+bool addHistory(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+  if (gameHistory->turns > gameBoard->turns) {
+    return false;
+  }
+
+  if (gameHistory->turns == TURN_LIMIT) {
+    clearHistory(gameHistory);
+  }
+
+  gameHistory->turnData = memoryResize(MEMORY_HISTORY, gameHistory->turnData, sizeof(struct gameHistoryTurn) * (gameHistory->turns + 1));
+
+  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->turns];
+
+  if (currentTurn == NULL) {
+    return false;
+  }
+
+  currentTurn->records = 0;
+  currentTurn->countBorn = 0;
+  currentTurn->countDeath = 0;
+  currentTurn->countStable = 0;
+  currentTurn->state = NULL;
+  currentTurn->index = NULL;
+
+  gameHistory->currentTurn = gameHistory->turns;
+  ++gameHistory->turns;
+
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    if (gameBoard->cells[i].cellChanged) {
+      currentTurn->state = memoryResize(MEMORY_HISTORY, currentTurn->state, sizeof(short) * (currentTurn->records + 1));
+      currentTurn->index = memoryResize(MEMORY_HISTORY, currentTurn->index, sizeof(unsigned int) * (currentTurn->records + 1));
+
+      currentTurn->index[currentTurn->records] = gameBoard->cells[i].cellX + (gameBoard->cells[i].cellY * gameBoard->cellsX);
+
+      if (gameBoard->cells[i].isLiving) {
+        ++currentTurn->countBorn;
+        currentTurn->state[currentTurn->records] = BORN;
+      } else {
+        ++currentTurn->countDeath;
+        currentTurn->state[currentTurn->records] = DEAD;
+      }
+
+      ++currentTurn->records;
+    } else if (gameBoard->cells[i].isLiving) {
+      currentTurn->state = memoryResize(MEMORY_HISTORY, currentTurn->state, sizeof(short) * (currentTurn->records + 1));
+      currentTurn->index = memoryResize(MEMORY_HISTORY, currentTurn->index, sizeof(unsigned int) * (currentTurn->records + 1));
+
+      currentTurn->state[currentTurn->records] = STABLE;
+      currentTurn->index[currentTurn->records] = gameBoard->cells[i].cellX + (gameBoard->cells[i].cellY * gameBoard->cellsX);
+      ++currentTurn->countStable;
+
+      ++currentTurn->records;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to get backwards in the history
+//------------------------------------------------------------------------------
+bool historyBackwards(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+  if (gameHistory->currentTurn == 0 || gameHistory->turns == 0) {
+    return false;
+  }
+
+  --gameHistory->currentTurn;
+
+  if (historyDisplayTurn(gameHistory, gameBoard)) {
+    return true;
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------------
+// Function to get forward in the history
+//------------------------------------------------------------------------------
+bool historyForwards(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+
+  if (gameHistory->currentTurn == gameBoard->turns || gameHistory->turns == 0 || gameHistory->currentTurn == (gameHistory->turns - 1)) {
+    return false;
+  }
+
+  ++gameHistory->currentTurn;
+
+  if (historyDisplayTurn(gameHistory, gameBoard)) {
+    return true;
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------------
+// Function to display a history state on the playboard
+//------------------------------------------------------------------------------
+bool historyDisplayTurn(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+  gameBoard->isEdited = true;
+
+  // Reset the playboard to zero
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    gameBoard->cells[i].isLiving = false;
+    gameBoard->cells[i].cellChanged = false;
+    gameBoard->cells[i].size = 0;
+  }
+
+  // Get the current history turn
+  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->currentTurn];
+
+  // The working cell index in the playboard cell array
+  unsigned int index = 0;
+
+  // Set the cells accordings there recorded states
+  for (unsigned int i = 0; i < currentTurn->records; ++i) {
+    index = currentTurn->index[i];
+
+    switch (currentTurn->state[i]) {
+      case STABLE:
+        // The cell was stable
+        gameBoard->cells[index].isLiving = true;
+        gameBoard->cells[index].cellChanged = false;
+        gameBoard->cells[index].size = 1;
+        break;
+      case DEAD:
+        // The cell was dying
+        gameBoard->cells[index].isLiving = false;
+        gameBoard->cells[index].cellChanged = true;
+        gameBoard->cells[index].size = 1;
+        break;
+      case BORN:
+        // The cell was born
+        gameBoard->cells[index].isLiving = true;
+        gameBoard->cells[index].cellChanged = true;
+        gameBoard->cells[index].size = 0;
+        break;
+      default:
+        break;
+    }
+
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the bytes of memory held by the history, the recorded turns
+// and their cell states and indexes
+//------------------------------------------------------------------------------
+size_t historyMemory(struct gameHistoryGame* gameHistory) {
+  size_t bytes = sizeof(struct gameHistoryTurn) * gameHistory->turns;
+
+  for (unsigned int i = 0; i < gameHistory->turns; ++i) {
+    bytes += (sizeof(short) + sizeof(unsigned int)) * gameHistory->turnData[i].records;
+  }
+
+  return bytes;
+}
+
+//------------------------------------------------------------------------------
+// Function to write out a image using libPNG functions
+//------------------------------------------------------------------------------
+bool writePNG(SDL_Surface* drawingSurface, struct playBoard* gameBoard, char* filename, struct options* gameOptions) {
+  // Get the surface dimensions
+  unsigned int width = drawingSurface->w;
+  unsigned int height = drawingSurface->h;
+
+  // Prepare the png structures
+  png_structp png_ptr = NULL;
+	png_infop info_ptr = NULL;
+	png_bytep row;
+
+  // Try if we can access the image for reading
+  FILE *imageFile = fopen(filename, "wb");
+
+  if (imageFile == NULL) {
+    set_options_message(gameOptions, "Could not open file for writing.");
+    return false;
+  }
+
+  // Initialize png write structure
+  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+
+  if (png_ptr == NULL) {
+    set_options_message(gameOptions, "Could not create png write structure.");
+    fclose(imageFile);
+    remove(filename);
+		return false;
+	}
+
+  // Initialize png info structure
+	info_ptr = png_create_info_struct(png_ptr);
+	if (info_ptr == NULL) {
+    set_options_message(gameOptions, "Could not create png info structure.");
+    fclose(imageFile);
+    remove(filename);
+    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+	}
+
+  // Setup Exception handling
+	if (setjmp(png_jmpbuf(png_ptr))) {
+    set_options_message(gameOptions, "An error in libPNG occured.");
+    fclose(imageFile);
+    remove(filename);
+    png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
+    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+	}
+
+  // Init png
+  png_init_io(png_ptr, imageFile);
+
+	// Write header (8 bit color depth, RGB plus alpha channel)
+	png_set_IHDR(png_ptr, info_ptr, width, height,
+			8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_DEFAULT);
+
+	png_write_info(png_ptr, info_ptr);
+
+
+  // Allocate memory for one row (4 bytes per pixel - RGBA)
+	row = (png_bytep) calloc(sizeof(png_byte), 4 * width);
+
+  if (row == NULL) {
+    set_options_message(gameOptions, "Insufficient ram to create png row.");
+    fclose(imageFile);
+    remove(filename);
+    png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
+    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+    return false;
+  }
+
+  // Get the pixel data
+  SDL_LockSurface(drawingSurface);
+  Uint32* pixelData = (Uint32*) drawingSurface->pixels;
+  SDL_UnlockSurface(drawingSurface);
+
+  // Write image data
+  unsigned int offset = 0;    // The offset of the pixel in the image
+  unsigned int yOffset = 0;   // The yOffset adding to the pixel offset
+
+  unsigned int rowOffset = 0;   // The offset of the pixel data in the row
+
+	for (unsigned int y = 0; y < height; y++) {
+    yOffset = (y * width);
+    for (unsigned int x = 0; x < width; x++) {
+      offset = x + yOffset;
+      rowOffset = x * 4;
+      row[rowOffset] = ((pixelData[offset] & drawingSurface->format->Rmask) >> drawingSurface->format->Rshift) << drawingSurface->format->Rloss;
+      row[rowOffset + 1] = ((pixelData[offset] & drawingSurface->format->Gmask) >> drawingSurface->format->Gshift) << drawingSurface->format->Gloss;
+      row[rowOffset + 2] = ((pixelData[offset] & drawingSurface->format->Bmask) >> drawingSurface->format->Bshift) << drawingSurface->format->Bloss;
+      row[rowOffset + 3] = 255;
+		}
+
+		png_write_row(png_ptr, row);
+	}
+
+  // End write
+	png_write_end(png_ptr, NULL);
+
+  // Close the image and cleanup
+  fclose(imageFile);
+  png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
+  png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+
+  free(row);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate a cleared bit block of width x height cells
+//------------------------------------------------------------------------------
+bool createBitBlock(struct bitBlock* block, int width, int height) {
+  block->width = width;
+  block->height = height;
+  block->wordsPerRow = (width + 63) >> 6;
+  block->words = NULL;
+
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+
+  block->words = memoryAllocateZeroed(MEMORY_BLOCKS, (size_t) block->wordsPerRow * height, sizeof(uint64_t));
+
+  return block->words != NULL;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the storage of a bit block
+//------------------------------------------------------------------------------
+void freeBitBlock(struct bitBlock* block) {
+  memoryFree(block->words);
+  block->words = NULL;
+  block->width = 0;
+  block->height = 0;
+  block->wordsPerRow = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to copy a bit block rotated clockwise by quarter turns, the
+// horizontal mirror is applied before the rotation
+//------------------------------------------------------------------------------
+bool transformBitBlock(struct bitBlock* source, struct bitBlock* target, int rotation, bool flip) {
+  rotation &= 3;
+
+  // Odd quarter turns swap the dimensions
+  int width = (rotation & 1) ? source->height : source->width;
+  int height = (rotation & 1) ? source->width : source->height;
+
+  if (!createBitBlock(target, width, height)) {
+    return false;
+  }
+
+  int sourceX = 0;  // The x location read from the source, after mirroring
+  int targetX = 0;  // The x location in the target
+  int targetY = 0;  // The y location in the target
+
+  for (int y = 0; y < source->height; ++y) {
+    uint64_t* row = &source->words[y * source->wordsPerRow];
+
+    for (int w = 0; w < source->wordsPerRow; ++w) {
+      uint64_t bits = row[w];
+
+      // Only visit the set bits of the word
+      while (bits != 0) {
+        sourceX = (w << 6) + __builtin_ctzll(bits);
+        bits &= bits - 1;
+
+        if (flip) {
+          sourceX = source->width - 1 - sourceX;
+        }
+
+        switch (rotation) {
+          case 1:
+            targetX = source->height - 1 - y;
+            targetY = sourceX;
+            break;
+          case 2:
+            targetX = source->width - 1 - sourceX;
+            targetY = source->height - 1 - y;
+            break;
+          case 3:
+            targetX = y;
+            targetY = source->width - 1 - sourceX;
+            break;
+          default:
+            targetX = sourceX;
+            targetY = y;
+            break;
+        }
+
+        target->words[(targetY * target->wordsPerRow) + (targetX >> 6)] |= (uint64_t) 1 << (targetX & 63);
+      }
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to parse a run length encoded pattern, as used by most life programs,
+// into a bit block. Comment lines "#" and the "x = .., y = .." header are skipped.
+// Patterns larger than the largest playboard are rejected while measuring.
+//------------------------------------------------------------------------------
+bool parseRLE(const char* rleText, struct bitBlock* block) {
+  int width = 0;    // The widest row we found
+  int height = 0;   // The amount of rows
+  int x = 0;        // The current x location
+  int y = 0;        // The current y location
+  int count = 0;    // The run count in front of a tag, 0 if none was given
+  bool isLineStart = true;
+  const char* data = rleText;
+
+  block->words = NULL;
+
+  // Do two passes, the first measures the pattern and the second sets the cells
+  for (int pass = 0; pass < 2; ++pass) {
+    x = 0;
+    y = 0;
+    count = 0;
+    isLineStart = true;
+
+    for (data = rleText; *data != '\0' && *data != '!'; ++data) {
+      // Skip comment and header lines
+      if (isLineStart && (*data == '#' || *data == 'x')) {
+        while (*data != '\0' && *data != '\n') {
+          ++data;
+        }
+
+        if (*data == '\0') {
+          break;
+        }
+
+        continue;
+      }
+
+      isLineStart = *data == '\n' || *data == '\r';
+
+      if (isdigit((unsigned char) *data)) {
+        count = (count * 10) + (*data - '0');
+
+        // Guard against absurd runs
+        if (count > 1000000) {
+          return false;
+        }
+
+        continue;
+      }
+
+      if (isspace((unsigned char) *data)) {
+        continue;
+      }
+
+      if (count == 0) {
+        count = 1;
+      }
+
+      if (*data == '$') {
+        y += count;
+        x = 0;
+      } else if (*data == 'b' || *data == '.') {
+        x += count;
+      } else if (isalpha((unsigned char) *data)) {
+        // Every other state letter counts as a living cell
+        if (pass == 1) {
+          for (int i = 0; i < count; ++i, ++x) {
+            block->words[(y * block->wordsPerRow) + (x >> 6)] |= (uint64_t) 1 << (x & 63);
+          }
+        } else {
+          x += count;
+          height = y + 1;
+        }
+      } else {
+        // Unknown character in the run data
+        return false;
+      }
+
+      // Stop before the runs add up beyond any playboard
+      if (pass == 0 && (x > PATTERN_SIZE_LIMIT || y > PATTERN_SIZE_LIMIT || height > PATTERN_SIZE_LIMIT)) {
+        return false;
+      }
+
+      if (x > width) {
+        width = x;
+      }
+
+      count = 0;
+    }
+
+    if (pass == 0 && !createBitBlock(block, width, height)) {
+      freeBitBlock(block);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to fill the pattern library with the built-in catalog and all .rle
+// files found in the patterns directory
+//------------------------------------------------------------------------------
+bool initStampLibrary(struct stampLibrary* library, char* directoryPath) {
+  // The built-in catalog, the first nine patterns are selected by number keys
+  static const char* builtinPatterns[][2] = {
+    { "Glider", "bo$2bo$3o!" },
+    { "Lightweight spaceship", "bo2bo$o4b$o3bo$4o!" },
+    { "Middleweight spaceship", "3bo2b$bo3bo$o5b$o4bo$5o!" },
+    { "Heavyweight spaceship", "3b2o2b$bo4bo$o6b$o5bo$6o!" },
+    { "Gosper glider gun", "24bo$22bobo$12b2o6b2o12b2o$11bo3bo4b2o12b2o$2o8bo5bo3b2o$2o8bo3bob2o4bobo$10bo5bo7bo$11bo3bo$12b2o!" },
+    { "Puffer train", "3bo$4bo$o3bo$b4o4$o$b2o$2bo$2bo$bo3$3bo$4bo$o3bo$b4o!" },
+    { "R-pentomino", "b2o$2o$bo!" },
+    { "Acorn", "bo$3bo$2o2b3o!" },
+    { "Pulsar", "2b3o3b3o2$o4bobo4bo$o4bobo4bo$o4bobo4bo$2b3o3b3o2$2b3o3b3o$o4bobo4bo$o4bobo4bo$o4bobo4bo2$2b3o3b3o!" }
+  };
+
+  unsigned int builtinCount = sizeof(builtinPatterns) / sizeof(builtinPatterns[0]);
+
+  library->count = 0;
+  library->active = -1;
+  library->rotation = 0;
+  library->flipped = false;
+  library->clipboard = -1;
+  library->oriented.words = NULL;
+  library->patterns = memoryAllocate(MEMORY_BLOCKS, sizeof(struct stampPattern) * builtinCount);
+
+  if (library->patterns == NULL) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < builtinCount; ++i) {
+    if (parseRLE(builtinPatterns[i][1], &library->patterns[library->count].block)) {
+      snprintf(library->patterns[library->count].name, 32, "%s", builtinPatterns[i][0]);
+      ++library->count;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Add the patterns of the .rle files in the pattern directory
+  //----------------------------------------------------------------------------
+  DIR* directory = opendir(directoryPath);
+
+  if (directory == NULL) {
+    return true;
+  }
+
+  struct dirent* entry = NULL;
+  char filePath[512];
+  char* rleText = NULL;
+  FILE* rleFile = NULL;
+  long fileSize = 0;
+
+  while ((entry = readdir(directory)) != NULL) {
+    char* fileType = strrchr(entry->d_name, '.');
+
+    if (fileType == NULL || strlen(fileType) != 4 || tolower(fileType[1]) != 'r' || tolower(fileType[2]) != 'l' || tolower(fileType[3]) != 'e') {
+      continue;
+    }
+
+    snprintf(filePath, 512, "%s/%s", directoryPath, entry->d_name);
+    rleFile = fopen(filePath, "rb");
+
+    if (rleFile == NULL) {
+      continue;
+    }
+
+    // Read in the complete file
+    fseek(rleFile, 0, SEEK_END);
+    fileSize = ftell(rleFile);
+    fseek(rleFile, 0, SEEK_SET);
+
+    if (fileSize <= 0 || fileSize > PATTERN_FILE_LIMIT) {
+      printf("[ERROR] Pattern file \"%s\" is empty or too large, skipped.\n", filePath);
+      fclose(rleFile);
+      continue;
+    }
+
+    rleText = malloc(fileSize + 1);
+
+    if (rleText == NULL) {
+      fclose(rleFile);
+      break;
+    }
+
+    rleText[fread(rleText, 1, fileSize, rleFile)] = '\0';
+    fclose(rleFile);
+
+    struct stampPattern* patterns = memoryResize(MEMORY_BLOCKS, library->patterns, sizeof(struct stampPattern) * (library->count + 1));
+
+    if (patterns == NULL) {
+      free(rleText);
+      break;
+    }
+
+    library->patterns = patterns;
+
+    if (parseRLE(rleText, &library->patterns[library->count].block)) {
+      // The filename without the extension is the pattern name
+      snprintf(library->patterns[library->count].name, 32, "%.*s", (int) (fileType - entry->d_name), entry->d_name);
+      ++library->count;
+    } else {
+      printf("[ERROR] Pattern file \"%s\" could not be parsed, skipped.\n", filePath);
+    }
+
+    free(rleText);
+  }
+
+  closedir(directory);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the pattern library
+//------------------------------------------------------------------------------
+void freeStampLibrary(struct stampLibrary* library) {
+  for (unsigned int i = 0; i < library->count; ++i) {
+    freeBitBlock(&library->patterns[i].block);
+  }
+
+  freeBitBlock(&library->oriented);
+  memoryFree(library->patterns);
+  library->patterns = NULL;
+  library->count = 0;
+  library->active = -1;
+  library->clipboard = -1;
+}
+
+//------------------------------------------------------------------------------
+// Function to select a pattern and apply rotation and flip to it,
+// an index of -1 deselects the pattern and returns to painting single cells
+//------------------------------------------------------------------------------
+bool selectStamp(struct stampLibrary* library, int index, int rotation, bool flipped) {
+  freeBitBlock(&library->oriented);
+
+  if (index < 0 || index >= library->count) {
+    library->active = -1;
+    return false;
+  }
+
+  library->active = index;
+  library->rotation = rotation & 3;
+  library->flipped = flipped;
+
+  // The orientation is only calculated once here, so stamping itself is a plain blit
+  if (!transformBitBlock(&library->patterns[index].block, &library->oriented, library->rotation, flipped)) {
+    library->active = -1;
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to or-blit a bit block onto the playboard with its top left corner
+// at cellX and cellY, wrapping around the borders. Only the set bits of each
+// word are visited, so the cost depends on the living cells of the stamp.
+//------------------------------------------------------------------------------
+unsigned int stampBitBlock(struct bitBlock* block, struct playBoard* gameBoard, int cellX, int cellY) {
+  unsigned int bornCells = 0;   // How many cells did we turn living
+  unsigned int index = 0;       // The index in the playboard cell array
+  int boardX = 0;               // The wrapped x location on the playboard
+  int boardY = 0;               // The wrapped y location on the playboard
+
+  for (int y = 0; y < block->height; ++y) {
+    boardY = (((cellY + y) % gameBoard->cellsY) + gameBoard->cellsY) % gameBoard->cellsY;
+    uint64_t* row = &block->words[y * block->wordsPerRow];
+
+    for (int w = 0; w < block->wordsPerRow; ++w) {
+      uint64_t bits = row[w];
+
+      while (bits != 0) {
+        boardX = (((cellX + (w << 6) + __builtin_ctzll(bits)) % gameBoard->cellsX) + gameBoard->cellsX) % gameBoard->cellsX;
+        bits &= bits - 1;
+
+        index = boardX + (boardY * gameBoard->cellsX);
+
+        if (!gameBoard->cells[index].isLiving) {
+          journalCell(gameBoard, index);
+          gameBoard->cells[index].isLiving = true;
+          ++gameBoard->livingCells;
+          ++bornCells;
+        }
+      }
+    }
+  }
+
+  return bornCells;
+}
+
+//------------------------------------------------------------------------------
+// Function to start recording the cells flipped by an edit. Until commitEdit
+// the functions writing cells report each flip by journalCell, so an edit
+// costs the cells it flips, not the playboard. A running edit goes on.
+//------------------------------------------------------------------------------
+bool beginEdit(struct editJournal* journal, struct playBoard* gameBoard) {
+  unsigned int slotCount = ((gameBoard->cellsX + 63) >> 6) * gameBoard->cellsY;
+
+  gameBoard->isEdited = true;
+
+  if (gameBoard->journal == journal) {
+    return true;
+  }
+
+  if (journal->slotCount != slotCount) {
+    memoryFree(journal->slots);
+    journal->slots = memoryAllocateZeroed(MEMORY_JOURNAL, slotCount, sizeof(unsigned int));
+    journal->slotCount = journal->slots != NULL ? slotCount : 0;
+  }
+
+  if (journal->slots == NULL) {
+    return false;
+  }
+
+  journal->pendingCount = 0;
+  journal->isOverflowed = false;
+  gameBoard->journal = journal;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to record a cell which flips its living state in the running edit,
+// called before the flip. The flips are gathered by word of the packed
+// playboard, a cell flipped twice cancels out.
+//------------------------------------------------------------------------------
+void journalCell(struct playBoard* gameBoard, unsigned int index) {
+  struct editJournal* journal = gameBoard->journal;
+
+  if (journal == NULL) {
+    return;
+  }
+
+  unsigned int x = index % gameBoard->cellsX;
+  unsigned int word = ((index / gameBoard->cellsX) * ((gameBoard->cellsX + 63) >> 6)) + (x >> 6);
+
+  if (journal->slots[word] == 0) {
+    if (journal->pendingCount == journal->pendingCapacity) {
+      unsigned int capacity = journal->pendingCapacity == 0 ? 64 : journal->pendingCapacity * 2;
+      unsigned int* pendingIndex = memoryResize(MEMORY_JOURNAL, journal->pendingIndex, sizeof(unsigned int) * capacity);
+
+      if (pendingIndex != NULL) {
+        journal->pendingIndex = pendingIndex;
+      }
+
+      uint64_t* pendingDelta = memoryResize(MEMORY_JOURNAL, journal->pendingDelta, sizeof(uint64_t) * capacity);
+
+      if (pendingDelta != NULL) {
+        journal->pendingDelta = pendingDelta;
+      }
+
+      if (pendingIndex == NULL || pendingDelta == NULL) {
+        journal->isOverflowed = true;
+        return;
+      }
+
+      journal->pendingCapacity = capacity;
+    }
+
+    journal->pendingIndex[journal->pendingCount] = word;
+    journal->pendingDelta[journal->pendingCount] = 0;
+    journal->slots[word] = ++journal->pendingCount;
+  }
+
+  journal->pendingDelta[journal->slots[word] - 1] ^= (uint64_t) 1 << (x & 63);
+}
+
+//------------------------------------------------------------------------------
+// Function to free the storage of one journal entry and return its size
+//------------------------------------------------------------------------------
+size_t freeJournalEntry(struct editJournalEntry* entry) {
+  size_t entryBytes = sizeof(struct editJournalEntry) + (entry->words * (sizeof(unsigned int) + sizeof(uint64_t)));
+
+  memoryFree(entry->index);
+  memoryFree(entry->delta);
+  entry->index = NULL;
+  entry->delta = NULL;
+  entry->words = 0;
+
+  return entryBytes;
+}
+
+//------------------------------------------------------------------------------
+// Function to record the changed words of an edit, started with beginEdit.
+// Only the xor of changed words is stored, redo steps are dropped and the
+// oldest edits are dropped if the memory cap would be exceeded.
+//------------------------------------------------------------------------------
+bool commitEdit(struct editJournal* journal, struct playBoard* gameBoard) {
+  struct editJournalEntry entry = { 0, NULL, NULL };
+
+  if (gameBoard->journal != journal) {
+    return false;
+  }
+
+  gameBoard->journal = NULL;
+
+  // Count the changed words first, to allocate the entry at once, and free the slots for the next edit
+  for (unsigned int p = 0; p < journal->pendingCount; ++p) {
+    journal->slots[journal->pendingIndex[p]] = 0;
+
+    if (journal->pendingDelta[p] != 0) {
+      ++entry.words;
+    }
+  }
+
+  size_t entryBytes = sizeof(struct editJournalEntry) + (entry.words * (sizeof(unsigned int) + sizeof(uint64_t)));
+
+  if (entry.words == 0 || entryBytes > journal->byteLimit || journal->isOverflowed) {
+    // An edit which does not fit at all makes the older edits unreachable
+    if (entry.words != 0 || journal->isOverflowed) {
+      clearJournal(journal);
+    }
+
+    return false;
+  }
+
+  entry.index = memoryAllocate(MEMORY_JOURNAL, sizeof(unsigned int) * entry.words);
+  entry.delta = memoryAllocate(MEMORY_JOURNAL, sizeof(uint64_t) * entry.words);
+
+  if (entry.index == NULL || entry.delta == NULL) {
+    memoryFree(entry.index);
+    memoryFree(entry.delta);
+    clearJournal(journal);
+    return false;
+  }
+
+  entry.words = 0;
+
+  for (unsigned int p = 0; p < journal->pendingCount; ++p) {
+    if (journal->pendingDelta[p] != 0) {
+      entry.index[entry.words] = journal->pendingIndex[p];
+      entry.delta[entry.words] = journal->pendingDelta[p];
+      ++entry.words;
+    }
+  }
+
+  // A new edit drops the redo steps
+  while (journal->entries > journal->position) {
+    --journal->entries;
+    journal->bytes -= freeJournalEntry(&journal->entryData[journal->entries]);
+  }
+
+  // Drop the oldest edits until the new one fits
+  while (journal->entries > 0 && journal->bytes + entryBytes > journal->byteLimit) {
+    journal->bytes -= freeJournalEntry(&journal->entryData[0]);
+    memmove(&journal->entryData[0], &journal->entryData[1], sizeof(struct editJournalEntry) * (journal->entries - 1));
+    --journal->entries;
+  }
+
+  struct editJournalEntry* entryData = memoryResize(MEMORY_JOURNAL, journal->entryData, sizeof(struct editJournalEntry) * (journal->entries + 1));
+
+  if (entryData == NULL) {
+    memoryFree(entry.index);
+    memoryFree(entry.delta);
+    journal->position = journal->entries;
+    return false;
+  }
+
+  journal->entryData = entryData;
+  journal->entryData[journal->entries] = entry;
+  ++journal->entries;
+  journal->position = journal->entries;
+  journal->bytes += entryBytes;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to toggle the cells of the changed words of an edit, applying the
+// xor is its own inverse, so this does undo and redo in O(changed words)
+//------------------------------------------------------------------------------
+void applyJournalEntry(struct editJournalEntry* entry, struct playBoard* gameBoard) {
+  int wordsPerRow = (gameBoard->cellsX + 63) >> 6;
+  struct cell* toggleCell = NULL;
+
+  gameBoard->isEdited = true;
+
+  for (unsigned int i = 0; i < entry->words; ++i) {
+    uint64_t bits = entry->delta[i];
+    int y = entry->index[i] / wordsPerRow;
+    int x = (entry->index[i] % wordsPerRow) << 6;
+
+    while (bits != 0) {
+      toggleCell = &gameBoard->cells[x + __builtin_ctzll(bits) + (y * gameBoard->cellsX)];
+      bits &= bits - 1;
+
+      toggleCell->isLiving = !toggleCell->isLiving;
+      toggleCell->cellChanged = false;
+      toggleCell->size = 1;
+
+      if (toggleCell->isLiving) {
+        ++gameBoard->livingCells;
+      } else {
+        --gameBoard->livingCells;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to undo the last applied edit
+//------------------------------------------------------------------------------
+bool undoEdit(struct editJournal* journal, struct playBoard* gameBoard) {
+  if (journal->position == 0) {
+    return false;
+  }
+
+  --journal->position;
+  applyJournalEntry(&journal->entryData[journal->position], gameBoard);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to redo the last undone edit
+//------------------------------------------------------------------------------
+bool redoEdit(struct editJournal* journal, struct playBoard* gameBoard) {
+  if (journal->position == journal->entries) {
+    return false;
+  }
+
+  applyJournalEntry(&journal->entryData[journal->position], gameBoard);
+  ++journal->position;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to drop all recorded edits, used when the playboard changes by turns
+//------------------------------------------------------------------------------
+void clearJournal(struct editJournal* journal) {
+  for (unsigned int i = 0; i < journal->entries; ++i) {
+    freeJournalEntry(&journal->entryData[i]);
+  }
+
+  memoryFree(journal->entryData);
+  journal->entryData = NULL;
+  journal->isOverflowed = true;  // A running edit is dropped too, its commit frees the slots
+  journal->entries = 0;
+  journal->position = 0;
+  journal->bytes = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the journal with the storage of the running edit
+//------------------------------------------------------------------------------
+void freeJournal(struct editJournal* journal) {
+  clearJournal(journal);
+  memoryFree(journal->slots);
+  memoryFree(journal->pendingIndex);
+  memoryFree(journal->pendingDelta);
+  journal->slots = NULL;
+  journal->slotCount = 0;
+  journal->pendingIndex = NULL;
+  journal->pendingDelta = NULL;
+  journal->pendingCount = 0;
+  journal->pendingCapacity = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate the object tracker for a playboard
+//------------------------------------------------------------------------------
+bool initObjectTracker(struct objectTracker* tracker, struct playBoard* gameBoard) {
+  tracker->isEnabled = false;
+  tracker->count = 0;
+  tracker->nextId = 1;
+  tracker->generation = 0;
+  tracker->summary[0] = '\0';
+  tracker->objects = NULL;
+  tracker->detected = NULL;
+  tracker->visited = memoryAllocateZeroed(MEMORY_TRACKING, gameBoard->cellCount, sizeof(unsigned int));
+  tracker->queue = memoryAllocate(MEMORY_TRACKING, sizeof(int) * gameBoard->cellCount);
+  tracker->queueX = memoryAllocate(MEMORY_TRACKING, sizeof(int) * gameBoard->cellCount);
+  tracker->queueY = memoryAllocate(MEMORY_TRACKING, sizeof(int) * gameBoard->cellCount);
+
+  if (tracker->visited == NULL || tracker->queue == NULL || tracker->queueX == NULL || tracker->queueY == NULL) {
+    freeObjectTracker(tracker);
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to free the object tracker
+//------------------------------------------------------------------------------
+void freeObjectTracker(struct objectTracker* tracker) {
+  memoryFree(tracker->objects);
+  memoryFree(tracker->detected);
+  memoryFree(tracker->visited);
+  memoryFree(tracker->queue);
+  memoryFree(tracker->queueX);
+  memoryFree(tracker->queueY);
+  tracker->objects = NULL;
+  tracker->detected = NULL;
+  tracker->visited = NULL;
+  tracker->queue = NULL;
+  tracker->queueX = NULL;
+  tracker->queueY = NULL;
+  tracker->count = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the shortest distance of two locations on a wrapped axis
+//------------------------------------------------------------------------------
+int wrappedDistance(int from, int to, int size) {
+  int distance = (to - from) % size;
+
+  if (distance < -size / 2) {
+    distance += size;
+  } else if (distance >= size / 2) {
+    distance -= size;
+  }
+
+  return distance;
+}
+
+//------------------------------------------------------------------------------
+// Function to hash a cell of a shape at its location relative to the bounding
+// box, the hash of a shape is the sum over its cells, independent of the order
+//------------------------------------------------------------------------------
+uint64_t hashShapeCell(int x, int y) {
+  uint64_t cellHash = ((uint64_t) x << 32) | (uint32_t) y;
+
+  cellHash = (cellHash ^ (cellHash >> 31)) * 0x9E3779B97F4A7C15ull;
+
+  return cellHash ^ (cellHash >> 29);
+}
+
+//------------------------------------------------------------------------------
+// Function to detect the active objects around the changed cells of the last
+// turn and match them to the tracked objects. Living cells up to two cells
+// apart form one object. Only objects touching the change set are visited,
+// still lifes cost nothing. Each object is hashed as it is and in canonical
+// form, the smallest hash of its 8 orientations. Within reach of a tracked
+// object of the last generation, the one expecting this phase of its period
+// is preferred, then one which had the canonical shape before, and the
+// distance only breaks ties, so passing objects keep their identities. When
+// the shape repeats after a period, the displacement over the period gives
+// the velocity and heading.
+//------------------------------------------------------------------------------
+void updateObjectTracker(struct objectTracker* tracker, struct playBoard* gameBoard) {
+  unsigned int detectedCount = 0;
+  unsigned int queueStart = 0;
+  unsigned int queueEnd = 0;
+
+  if (tracker->visited == NULL || gameBoard->changedIndex == NULL) {
+    return;
+  }
+
+  // Restart the visited marks before the counter overflows
+  if (++tracker->generation == 0) {
+    memset(tracker->visited, 0, sizeof(unsigned int) * gameBoard->cellCount);
+    tracker->generation = 1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Flood fill the living cells around each changed cell into objects
+  //----------------------------------------------------------------------------
+  for (unsigned int c = 0; c < gameBoard->changedCount; ++c) {
+    int changedX = gameBoard->changedIndex[c] % gameBoard->cellsX;
+    int changedY = gameBoard->changedIndex[c] / gameBoard->cellsX;
+
+    // The changed cell might have died, so check it and its neighbours as seeds
+    for (int seed = 0; seed < 9; ++seed) {
+      int seedX = (changedX + (seed % 3) - 1 + gameBoard->cellsX) % gameBoard->cellsX;
+      int seedY = (changedY + (seed / 3) - 1 + gameBoard->cellsY) % gameBoard->cellsY;
+      int seedIndex = seedX + (seedY * gameBoard->cellsX);
+
+      if (!gameBoard->cells[seedIndex].isLiving || tracker->visited[seedIndex] == tracker->generation) {
+        continue;
+      }
+
+      // Fill with locations continued across the wrap, relative to the seed
+      int minX = 0;
+      int minY = 0;
+      int maxX = 0;
+      int maxY = 0;
+
+      queueStart = 0;
+      queueEnd = 1;
+      tracker->queue[0] = seedIndex;
+      tracker->queueX[0] = 0;
+      tracker->queueY[0] = 0;
+      tracker->visited[seedIndex] = tracker->generation;
+
+      while (queueStart < queueEnd) {
+        int fillX = tracker->queueX[queueStart];
+        int fillY = tracker->queueY[queueStart];
+        ++queueStart;
+
+        minX = fillX < minX ? fillX : minX;
+        minY = fillY < minY ? fillY : minY;
+        maxX = fillX > maxX ? fillX : maxX;
+        maxY = fillY > maxY ? fillY : maxY;
+
+        // Cells up to two cells apart belong to one object, this keeps sparks and split phases together
+        for (int neighbour = 0; neighbour < 25; ++neighbour) {
+          int neighbourX = fillX + (neighbour % 5) - 2;
+          int neighbourY = fillY + (neighbour / 5) - 2;
+          int neighbourIndex = (((seedX + neighbourX) % gameBoard->cellsX + gameBoard->cellsX) % gameBoard->cellsX) + ((((seedY + neighbourY) % gameBoard->cellsY + gameBoard->cellsY) % gameBoard->cellsY) * gameBoard->cellsX);
+
+          if (gameBoard->cells[neighbourIndex].isLiving && tracker->visited[neighbourIndex] != tracker->generation) {
+            tracker->visited[neighbourIndex] = tracker->generation;
+            tracker->queue[queueEnd] = neighbourIndex;
+            tracker->queueX[queueEnd] = neighbourX;
+            tracker->queueY[queueEnd] = neighbourY;
+            ++queueEnd;
+          }
+        }
+      }
+
+      // Skip large regions, they are not objects we can follow
+      if (queueEnd > TRACK_POPULATION_LIMIT || maxX - minX + 1 >= gameBoard->cellsX / 2 || maxY - minY + 1 >= gameBoard->cellsY / 2) {
+        continue;
+      }
+
+      // Hash the shape relative to its bounding box in all 8 orientations, the first is the shape as it is
+      uint64_t orientationHashes[8] = { 0 };
+      int right = maxX - minX;
+      int bottom = maxY - minY;
+
+      for (unsigned int i = 0; i < queueEnd; ++i) {
+        int u = tracker->queueX[i] - minX;
+        int v = tracker->queueY[i] - minY;
+
+        orientationHashes[0] += hashShapeCell(u, v);
+        orientationHashes[1] += hashShapeCell(right - u, v);
+        orientationHashes[2] += hashShapeCell(u, bottom - v);
+        orientationHashes[3] += hashShapeCell(right - u, bottom - v);
+        orientationHashes[4] += hashShapeCell(v, u);
+        orientationHashes[5] += hashShapeCell(bottom - v, u);
+        orientationHashes[6] += hashShapeCell(v, right - u);
+        orientationHashes[7] += hashShapeCell(bottom - v, right - u);
+      }
+
+      uint64_t canonicalHash = orientationHashes[0];
+
+      for (int orientation = 1; orientation < 8; ++orientation) {
+        canonicalHash = orientationHashes[orientation] < canonicalHash ? orientationHashes[orientation] : canonicalHash;
+      }
+
+      struct trackedObject* grown = memoryResize(MEMORY_TRACKING, tracker->detected, sizeof(struct trackedObject) * (detectedCount + 1));
+
+      if (grown == NULL) {
+        break;
+      }
+
+      tracker->detected = grown;
+      struct trackedObject* object = &tracker->detected[detectedCount++];
+
+      object->id = 0;
+      object->x = ((seedX + minX) % gameBoard->cellsX + gameBoard->cellsX) % gameBoard->cellsX;
+      object->y = ((seedY + minY) % gameBoard->cellsY + gameBoard->cellsY) % gameBoard->cellsY;
+      object->width = maxX - minX + 1;
+      object->height = maxY - minY + 1;
+      object->population = queueEnd;
+      object->shapeHash[0] = orientationHashes[0];
+      object->canonicalHash[0] = canonicalHash;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Match the detected objects to the tracked objects of the last generation
+  //----------------------------------------------------------------------------
+  struct trackedObject* matched = memoryAllocate(MEMORY_TRACKING, sizeof(struct trackedObject) * (detectedCount + 1));
+
+  if (matched == NULL) {
+    return;
+  }
+
+  bool* isTaken = memoryAllocateZeroed(MEMORY_TRACKING, tracker->count + 1, sizeof(bool));
+
+  if (isTaken == NULL) {
+    memoryFree(matched);
+    return;
+  }
+
+  for (unsigned int d = 0; d < detectedCount; ++d) {
+    struct trackedObject* object = &tracker->detected[d];
+    int bestDistance = INT_MAX;
+    int bestScore = -1;
+    int best = -1;
+
+    // Objects in reach by the doubled center distance, they move at most one cell per generation
+    for (unsigned int t = 0; t < tracker->count; ++t) {
+      struct trackedObject* tracked = &tracker->objects[t];
+
+      int distanceX = wrappedDistance((tracked->x * 2) + tracked->width, (object->x * 2) + object->width, gameBoard->cellsX * 2);
+      int distanceY = wrappedDistance((tracked->y * 2) + tracked->height, (object->y * 2) + object->height, gameBoard->cellsY * 2);
+      int distance = abs(distanceX) + abs(distanceY);
+
+      if (isTaken[t] || distance > 6) {
+        continue;
+      }
+
+      // Score 2 for the phase expected after the period, 1 for a canonical shape of the object before
+      int score = 0;
+
+      if (tracked->period != 0 && tracked->shapeHash[(tracked->age + 1 - tracked->period) % TRACK_HISTORY] == object->shapeHash[0]) {
+        score = 2;
+      }
+
+      for (unsigned int p = 0; score == 0 && p < TRACK_HISTORY && p <= tracked->age; ++p) {
+        if (tracked->canonicalHash[(tracked->age - p) % TRACK_HISTORY] == object->canonicalHash[0]) {
+          score = 1;
+        }
+      }
+
+      if (score > bestScore || (score == bestScore && distance < bestDistance)) {
+        bestScore = score;
+        bestDistance = distance;
+        best = t;
+      }
+    }
+
+    if (best == -1) {
+      // A new object
+      object->id = tracker->nextId++;
+      object->age = 0;
+      object->period = 0;
+      object->velocityX = 0;
+      object->velocityY = 0;
+      object->positionX[0] = object->x;
+      object->positionY[0] = object->y;
+      matched[d] = *object;
+      continue;
+    }
+
+    // Continue the tracked object with the new shape and position
+    struct trackedObject* tracked = &tracker->objects[best];
+    unsigned int last = tracked->age % TRACK_HISTORY;
+    unsigned int now = (tracked->age + 1) % TRACK_HISTORY;
+
+    isTaken[best] = true;
+    matched[d] = *tracked;
+    matched[d].age = tracked->age + 1;
+    matched[d].x = object->x;
+    matched[d].y = object->y;
+    matched[d].width = object->width;
+    matched[d].height = object->height;
+    matched[d].population = object->population;
+    matched[d].shapeHash[now] = object->shapeHash[0];
+    matched[d].canonicalHash[now] = object->canonicalHash[0];
+    matched[d].positionX[now] = tracked->positionX[last] + wrappedDistance(tracked->x, object->x, gameBoard->cellsX);
+    matched[d].positionY[now] = tracked->positionY[last] + wrappedDistance(tracked->y, object->y, gameBoard->cellsY);
+
+    // Find the shortest period after which the shape repeats
+    int period = 0;
+
+    for (unsigned int p = 1; p < TRACK_HISTORY && p <= matched[d].age; ++p) {
+      if (matched[d].shapeHash[(matched[d].age - p) % TRACK_HISTORY] == matched[d].shapeHash[now]) {
+        period = p;
+        break;
+      }
+    }
+
+    if (period != 0) {
+      unsigned int before = (matched[d].age - period) % TRACK_HISTORY;
+      int velocityX = matched[d].positionX[now] - matched[d].positionX[before];
+      int velocityY = matched[d].positionY[now] - matched[d].positionY[before];
+
+      if (period != tracked->period || velocityX != tracked->velocityX || velocityY != tracked->velocityY) {
+        printf("[TRACKING] Object %u: %u cells, period %d, moving %d x, %d y per period\n", matched[d].id, matched[d].population, period, velocityX, velocityY);
+      }
+
+      matched[d].velocityX = velocityX;
+      matched[d].velocityY = velocityY;
+    }
+
+    matched[d].period = period;
+  }
+
+  memoryFree(isTaken);
+
+  // Tracked objects without a match have died, merged or settled
+  memoryFree(tracker->objects);
+  tracker->objects = matched;
+  tracker->count = detectedCount;
+
+  //----------------------------------------------------------------------------
+  // Summarize the moving objects by speed and heading for the info panel
+  //----------------------------------------------------------------------------
+  static const char* headings[] = { "NW", "N", "NE", "W", "", "E", "SW", "S", "SE" };
+  unsigned int movingCount = 0;
+  int written = snprintf(tracker->summary, 128, "%u active objects", tracker->count);
+
+  for (unsigned int t = 0; t < tracker->count; ++t) {
+    struct trackedObject* tracked = &tracker->objects[t];
+
+    if (tracked->period == 0 || (tracked->velocityX == 0 && tracked->velocityY == 0)) {
+      continue;
+    }
+
+    ++movingCount;
+
+    // Speed in fractions of c, the speed of light of one cell per generation, reduced by the greatest common divisor
+    int distance = abs(tracked->velocityX) > abs(tracked->velocityY) ? abs(tracked->velocityX) : abs(tracked->velocityY);
+    int period = tracked->period;
+
+    for (int divisor = distance; divisor > 1; --divisor) {
+      if (distance % divisor == 0 && period % divisor == 0) {
+        distance /= divisor;
+        period /= divisor;
+        break;
+      }
+    }
+
+    int heading = ((tracked->velocityY > 0) - (tracked->velocityY < 0) + 1) * 3 + (tracked->velocityX > 0) - (tracked->velocityX < 0) + 1;
+
+    if (written > 0 && written < 100) {
+      if (distance == 1) {
+        written += snprintf(&tracker->summary[written], 128 - written, "%s c/%d %s", movingCount == 1 ? ", moving:" : ",", period, headings[heading]);
+      } else {
+        written += snprintf(&tracker->summary[written], 128 - written, "%s %dc/%d %s", movingCount == 1 ? ", moving:" : ",", distance, period, headings[heading]);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to get 64 bits of a packed row starting at a bit offset, the row
+// needs one more word than the offset reaches into
+//------------------------------------------------------------------------------
+uint64_t rowBitsAt(uint64_t* row, int offset) {
+  int shift = offset & 63;
+
+  if (shift == 0) {
+    return row[offset >> 6];
+  }
+
+  return (row[offset >> 6] >> shift) | (row[(offset >> 6) + 1] << (64 - shift));
+}
+
+//------------------------------------------------------------------------------
+// Function to find every occurrence of a pattern on the playboard in all 8
+// orientations. A match requires the exact pattern cells and a dead border of
+// one cell around them, so patterns inside bigger objects are not reported.
+//
+// For each row and 64 start positions at once, a candidate word is and-ed with
+// the playboard row shifted by each pattern column, inverted for dead cells,
+// across all pattern rows. The bits left are the matching start positions.
+//------------------------------------------------------------------------------
+unsigned int findPatternMatches(struct playBoard* gameBoard, struct bitBlock* pattern, struct patternMatch** matches) {
+  unsigned int matchCount = 0;
+  unsigned int orientationCount = 0;
+  struct bitBlock orientations[8];  // The pattern with its dead border in each distinct orientation
+  short orientationIds[8];          // The rotation and flip of each orientation
+  struct bitBlock oriented;
+
+  *matches = NULL;
+
+  // The pattern and its border must fit on the playboard, otherwise it would wrap onto itself
+  if (pattern->width + 2 > gameBoard->cellsX || pattern->height + 2 > gameBoard->cellsY) {
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Create the distinct orientations, each with a dead border of one cell
+  //----------------------------------------------------------------------------
+  for (short orientation = 0; orientation < 8; ++orientation) {
+    if (!transformBitBlock(pattern, &oriented, orientation & 3, orientation >= 4)) {
+      continue;
+    }
+
+    struct bitBlock* bordered = &orientations[orientationCount];
+
+    if (!createBitBlock(bordered, oriented.width + 2, oriented.height + 2)) {
+      freeBitBlock(&oriented);
+      continue;
+    }
+
+    for (int y = 0; y < oriented.height; ++y) {
+      for (int x = 0; x < oriented.width; ++x) {
+        if ((oriented.words[(y * oriented.wordsPerRow) + (x >> 6)] >> (x & 63)) & 1) {
+          bordered->words[((y + 1) * bordered->wordsPerRow) + ((x + 1) >> 6)] |= (uint64_t) 1 << ((x + 1) & 63);
+        }
+      }
+    }
+
+    freeBitBlock(&oriented);
+
+    // Symmetric patterns have identical orientations, which would report the same match again
+    bool isDuplicate = false;
+
+    for (unsigned int i = 0; i < orientationCount && !isDuplicate; ++i) {
+      isDuplicate = orientations[i].width == bordered->width && orientations[i].height == bordered->height && memcmp(orientations[i].words, bordered->words, sizeof(uint64_t) * bordered->wordsPerRow * bordered->height) == 0;
+    }
+
+    if (isDuplicate) {
+      freeBitBlock(bordered);
+      continue;
+    }
+
+    orientationIds[orientationCount] = orientation;
+    ++orientationCount;
+  }
+
+  //----------------------------------------------------------------------------
+  // Pack the playboard rows, extended by the widest pattern to wrap around the right border
+  //----------------------------------------------------------------------------
+  int extendedWidth = gameBoard->cellsX + pattern->width + pattern->height + 2;
+  int extendedWords = ((extendedWidth + 63) >> 6) + 1;
+  int boardWords = (gameBoard->cellsX + 63) >> 6;
+  uint64_t* extendedRows = memoryAllocateZeroed(MEMORY_SEARCH, extendedWords * gameBoard->cellsY, sizeof(uint64_t));
+
+  if (extendedRows == NULL) {
+    for (unsigned int i = 0; i < orientationCount; ++i) {
+      freeBitBlock(&orientations[i]);
+    }
+
+    return 0;
+  }
+
+  for (int y = 0; y < gameBoard->cellsY; ++y) {
+    uint64_t* row = &extendedRows[y * extendedWords];
+
+    for (int x = 0; x < extendedWidth; ++x) {
+      if (gameBoard->cells[(x % gameBoard->cellsX) + (y * gameBoard->cellsX)].isLiving) {
+        row[x >> 6] |= (uint64_t) 1 << (x & 63);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Match 64 start positions at once
+  //----------------------------------------------------------------------------
+  uint64_t lastWordMask = (gameBoard->cellsX & 63) == 0 ? ~(uint64_t) 0 : ((uint64_t) 1 << (gameBoard->cellsX & 63)) - 1;
+  uint64_t candidates = 0;
+  int matchX = 0;
+
+  for (unsigned int o = 0; o < orientationCount; ++o) {
+    struct bitBlock* search = &orientations[o];
+
+    for (int y = 0; y < gameBoard->cellsY; ++y) {
+      for (int w = 0; w < boardWords; ++w) {
+        candidates = w == boardWords - 1 ? lastWordMask : ~(uint64_t) 0;
+
+        for (int r = 0; r < search->height && candidates != 0; ++r) {
+          uint64_t* row = &extendedRows[((y + r) % gameBoard->cellsY) * extendedWords];
+          uint64_t* patternRow = &search->words[r * search->wordsPerRow];
+
+          for (int c = 0; c < search->width && candidates != 0; ++c) {
+            if ((patternRow[c >> 6] >> (c & 63)) & 1) {
+              candidates &= rowBitsAt(row, (w << 6) + c);
+            } else {
+              candidates &= ~rowBitsAt(row, (w << 6) + c);
+            }
+          }
+        }
+
+        // Every bit left is a match, store it without the border
+        while (candidates != 0) {
+          matchX = (w << 6) + __builtin_ctzll(candidates);
+          candidates &= candidates - 1;
+
+          struct patternMatch* grown = memoryResize(MEMORY_SEARCH, *matches, sizeof(struct patternMatch) * (matchCount + 1));
+
+          if (grown == NULL) {
+            break;
+          }
+
+          *matches = grown;
+          (*matches)[matchCount].x = (matchX + 1) % gameBoard->cellsX;
+          (*matches)[matchCount].y = (y + 1) % gameBoard->cellsY;
+          (*matches)[matchCount].width = search->width - 2;
+          (*matches)[matchCount].height = search->height - 2;
+          (*matches)[matchCount].orientation = orientationIds[o];
+          ++matchCount;
+        }
+      }
+    }
+  }
+
+  memoryFree(extendedRows);
+
+  for (unsigned int i = 0; i < orientationCount; ++i) {
+    freeBitBlock(&orientations[i]);
+  }
+
+  return matchCount;
+}
+
+//------------------------------------------------------------------------------
+// Function to remove the highlighted pattern matches
+//------------------------------------------------------------------------------
+void clearPatternMatches(struct options* gameOptions) {
+  memoryFree(gameOptions->matches);
+  gameOptions->matches = NULL;
+  gameOptions->matchCount = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to pack a rectangle of the playboard into a bit block, the
+// rectangle has to be inside of the playboard
+//------------------------------------------------------------------------------
+bool readBitBlock(struct playBoard* gameBoard, int cellX, int cellY, int width, int height, struct bitBlock* block) {
+  if (!createBitBlock(block, width, height)) {
+    return false;
+  }
+
+  int bitLimit = 0;   // How many bits of the current word are inside the rectangle
+
+  for (int y = 0; y < height; ++y) {
+    struct cell* rowCells = &gameBoard->cells[cellX + ((cellY + y) * gameBoard->cellsX)];
+    uint64_t* row = &block->words[y * block->wordsPerRow];
+
+    for (int w = 0; w < block->wordsPerRow; ++w) {
+      uint64_t word = 0;
+      bitLimit = width - (w << 6) < 64 ? width - (w << 6) : 64;
+
+      for (int bit = 0; bit < bitLimit; ++bit) {
+        word |= (uint64_t) rowCells[(w << 6) + bit].isLiving << bit;
+      }
+
+      row[w] = word;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to replace a rectangle of the playboard with the cells of a bit
+// block, only cells which change their state are written
+//------------------------------------------------------------------------------
+void writeBitBlock(struct bitBlock* block, struct playBoard* gameBoard, int cellX, int cellY) {
+  bool isLiving = false;
+
+  for (int y = 0; y < block->height; ++y) {
+    struct cell* rowCells = &gameBoard->cells[cellX + ((cellY + y) * gameBoard->cellsX)];
+    uint64_t* row = &block->words[y * block->wordsPerRow];
+
+    for (int x = 0; x < block->width; ++x) {
+      isLiving = (row[x >> 6] >> (x & 63)) & 1;
+
+      if (rowCells[x].isLiving != isLiving) {
+        journalCell(gameBoard, cellX + x + ((cellY + y) * gameBoard->cellsX));
+        rowCells[x].isLiving = isLiving;
+
+        if (isLiving) {
+          ++gameBoard->livingCells;
+        } else {
+          --gameBoard->livingCells;
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to get a random word with each bit set by a probability of n/256.
+// Random words are combined along the binary digits of the density, starting
+// at the lowest digit, "or" halves the distance to one and "and" halves the value.
+//------------------------------------------------------------------------------
+uint64_t randomDensityWord(uint64_t* randomState, unsigned int density) {
+  uint64_t word = 0;
+
+  if (density >= 256) {
+    return ~(uint64_t) 0;
+  }
+
+  for (int digit = 0; digit < 8; ++digit) {
+    // xorshift64 random number generator
+    *randomState ^= *randomState << 13;
+    *randomState ^= *randomState >> 7;
+    *randomState ^= *randomState << 17;
+
+    word = ((density >> digit) & 1) ? (word | *randomState) : (word & *randomState);
+  }
+
+  return word;
+}
+
+//------------------------------------------------------------------------------
+// Function to set the selected rectangle spanned by two cells, clamped to the playboard
+//------------------------------------------------------------------------------
+void setSelection(struct options* gameOptions, struct playBoard* gameBoard, int anchorX, int anchorY, int cellX, int cellY) {
+  // Clamp both corners to the playboard
+  anchorX = anchorX < 0 ? 0 : anchorX >= gameBoard->cellsX ? gameBoard->cellsX - 1 : anchorX;
+  anchorY = anchorY < 0 ? 0 : anchorY >= gameBoard->cellsY ? gameBoard->cellsY - 1 : anchorY;
+  cellX = cellX < 0 ? 0 : cellX >= gameBoard->cellsX ? gameBoard->cellsX - 1 : cellX;
+  cellY = cellY < 0 ? 0 : cellY >= gameBoard->cellsY ? gameBoard->cellsY - 1 : cellY;
+
+  gameOptions->hasSelection = true;
+  gameOptions->selectionX = anchorX < cellX ? anchorX : cellX;
+  gameOptions->selectionY = anchorY < cellY ? anchorY : cellY;
+  gameOptions->selectionWidth = abs(cellX - anchorX) + 1;
+  gameOptions->selectionHeight = abs(cellY - anchorY) + 1;
+}
+
+//------------------------------------------------------------------------------
+// Function to clear, invert or random fill the selected rectangle of the playboard.
+// The rectangle is packed into words, changed word by word and written back.
+//------------------------------------------------------------------------------
+bool applyRegionOperation(struct playBoard* gameBoard, struct options* gameOptions, int operation) {
+  static uint64_t randomState = 0;  // The state of the random number generator for random fills
+  struct bitBlock region;
+
+  if (!gameOptions->hasSelection) {
+    return false;
+  }
+
+  if (!readBitBlock(gameBoard, gameOptions->selectionX, gameOptions->selectionY, gameOptions->selectionWidth, gameOptions->selectionHeight, &region)) {
+    return false;
+  }
+
+  if (randomState == 0) {
+    randomState = gameOptions->randomSeed != 0 ? gameOptions->randomSeed : ((uint64_t) time(NULL) << 32) ^ (uint64_t) clock();
+    randomState ^= 0x9E3779B97F4A7C15ull;
+  }
+
+  // The density of the random fill follows the maximum fit cells option
+  unsigned int density = round(256.0 * gameOptions->maximumFitCellsForRandom / gameBoard->cellCount);
+
+  // Mask for the bits of the last word in a row, which are inside the rectangle
+  uint64_t lastWordMask = (region.width & 63) == 0 ? ~(uint64_t) 0 : ((uint64_t) 1 << (region.width & 63)) - 1;
+  uint64_t wordMask = 0;
+
+  for (int y = 0; y < region.height; ++y) {
+    uint64_t* row = &region.words[y * region.wordsPerRow];
+
+    for (int w = 0; w < region.wordsPerRow; ++w) {
+      wordMask = w == region.wordsPerRow - 1 ? lastWordMask : ~(uint64_t) 0;
+
+      switch (operation) {
+        case REGION_CLEAR:
+          row[w] = 0;
+          break;
+        case REGION_INVERT:
+          row[w] = ~row[w] & wordMask;
           break;
-        case DEAD:
-          cairo_set_source_rgba(drawingContext, 0.3, 0.3, 0.45, 1);
+        case REGION_RANDOM:
+          row[w] = randomDensityWord(&randomState, density) & wordMask;
           break;
         default:
           break;
       }
+    }
+  }
+
+  writeBitBlock(&region, gameBoard, gameOptions->selectionX, gameOptions->selectionY);
+  freeBitBlock(&region);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to copy the selected rectangle of the playboard into the clipboard
+// pattern of the library, which is then pasted like any other pattern stamp
+//------------------------------------------------------------------------------
+bool copySelection(struct playBoard* gameBoard, struct options* gameOptions, struct stampLibrary* library) {
+  struct bitBlock copy;
+
+  if (!gameOptions->hasSelection) {
+    return false;
+  }
+
+  if (!readBitBlock(gameBoard, gameOptions->selectionX, gameOptions->selectionY, gameOptions->selectionWidth, gameOptions->selectionHeight, &copy)) {
+    return false;
+  }
+
+  if (library->clipboard == -1) {
+    struct stampPattern* patterns = memoryResize(MEMORY_BLOCKS, library->patterns, sizeof(struct stampPattern) * (library->count + 1));
+
+    if (patterns == NULL) {
+      freeBitBlock(&copy);
+      return false;
+    }
+
+    library->patterns = patterns;
+    library->clipboard = library->count;
+    ++library->count;
+    snprintf(library->patterns[library->clipboard].name, 32, "Clipboard");
+  } else {
+    freeBitBlock(&library->patterns[library->clipboard].block);
+  }
+
+  library->patterns[library->clipboard].block = copy;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to write one run of a run length encoded pattern, keeping lines short
+//------------------------------------------------------------------------------
+void writeRLERun(FILE* rleFile, int count, char tag, int* lineLength) {
+  char run[16];
+  int runLength = count > 1 ? snprintf(run, 16, "%d%c", count, tag) : snprintf(run, 16, "%c", tag);
+
+  if (*lineLength + runLength > 70) {
+    fputc('\n', rleFile);
+    *lineLength = 0;
+  }
+
+  fputs(run, rleFile);
+  *lineLength += runLength;
+}
+
+//------------------------------------------------------------------------------
+// Function to write the living cells of the playboard to a run length encoded
+// pattern file, the format read by parseRLE and most life programs
+//------------------------------------------------------------------------------
+bool writeRLE(char* filename, struct playBoard* gameBoard, char* comment) {
+  FILE* rleFile = fopen(filename, "w");
+
+  if (rleFile == NULL) {
+    return false;
+  }
+
+  if (comment != NULL) {
+    fprintf(rleFile, "#C %s\n", comment);
+  }
+
+  fprintf(rleFile, "x = %d, y = %d, rule = B3/S23\n", gameBoard->cellsX, gameBoard->cellsY);
+
+  int lineLength = 0;   // The characters written in the current line
+  int previousRow = 0;  // The last row with living cells, rows are ended by "$"
+
+  for (int y = 0; y < gameBoard->cellsY; ++y) {
+    struct cell* rowCells = &gameBoard->cells[y * gameBoard->cellsX];
+    int lastLiving = -1;
+
+    // Dead cells at the end of a row are not written
+    for (int x = 0; x < gameBoard->cellsX; ++x) {
+      if (rowCells[x].isLiving) {
+        lastLiving = x;
+      }
+    }
+
+    if (lastLiving == -1) {
+      continue;
+    }
+
+    if (y != previousRow) {
+      writeRLERun(rleFile, y - previousRow, '$', &lineLength);
+      previousRow = y;
+    }
+
+    for (int x = 0; x <= lastLiving;) {
+      int count = 1;
+
+      while (x + count <= lastLiving && rowCells[x + count].isLiving == rowCells[x].isLiving) {
+        ++count;
+      }
+
+      writeRLERun(rleFile, count, rowCells[x].isLiving ? 'o' : 'b', &lineLength);
+      x += count;
+    }
+  }
+
+  writeRLERun(rleFile, 1, '!', &lineLength);
+  fputc('\n', rleFile);
+  fclose(rleFile);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to get a hash of the living cells of the playboard (FNV-1a)
+//------------------------------------------------------------------------------
+uint64_t hashPlayBoard(struct playBoard* gameBoard) {
+  uint64_t hash = 0xCBF29CE484222325ull;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    hash ^= gameBoard->cells[i].isLiving;
+    hash *= 0x100000001B3ull;
+  }
+
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+// Function to copy the living cells of one playboard to another of the same size
+//------------------------------------------------------------------------------
+void copyPlayBoard(struct playBoard* source, struct playBoard* target) {
+  for (unsigned int i = 0; i < source->cellCount; ++i) {
+    target->cells[i].isLiving = source->cells[i].isLiving;
+    target->cells[i].cellChanged = false;
+    target->cells[i].size = 0;
+  }
+
+  target->livingCells = source->livingCells;
+  target->turns = source->turns;
+  target->isDirty = true;
+  target->isEdited = true;
+}
+
+//------------------------------------------------------------------------------
+// Function to check if an engine differs from the reference within a count of
+// turns, for a start playboard. The first differing turn is stored in failedTurn.
+//------------------------------------------------------------------------------
+bool enginesDiverge(struct turnEngine* engine, struct playBoard* startBoard, unsigned int turns, unsigned int* failedTurn) {
+  struct playBoard referenceBoard;
+  struct playBoard engineBoard;
+  bool isDiverging = false;
+
+  if (!initPlayBoard(&referenceBoard, startBoard->cellsX, startBoard->cellsY, startBoard->cellsX, startBoard->cellsY)) {
+    return false;
+  }
+
+  if (!initPlayBoard(&engineBoard, startBoard->cellsX, startBoard->cellsY, startBoard->cellsX, startBoard->cellsY)) {
+    freePlayBoard(&referenceBoard);
+    return false;
+  }
+
+  copyPlayBoard(startBoard, &referenceBoard);
+  copyPlayBoard(startBoard, &engineBoard);
+
+  for (unsigned int turn = 1; turn <= turns && !isDiverging; ++turn) {
+    turnEngines[0].applyTurn(&referenceBoard, false);
+    engine->applyTurn(&engineBoard, false);
+
+    // Compare the cells, the living cell count and the stale state
+    isDiverging = hashPlayBoard(&referenceBoard) != hashPlayBoard(&engineBoard) || referenceBoard.livingCells != engineBoard.livingCells || referenceBoard.isDirty != engineBoard.isDirty;
+
+    if (isDiverging && failedTurn != NULL) {
+      *failedTurn = turn;
+    }
+  }
+
+  freePlayBoard(&referenceBoard);
+  freePlayBoard(&engineBoard);
+
+  return isDiverging;
+}
+
+//------------------------------------------------------------------------------
+// Function to remove living cells of a failing start playboard one by one,
+// as long as the engine still differs from the reference. Repeated until no
+// cell can be removed, what is left is a minimal reproducer.
+//------------------------------------------------------------------------------
+void shrinkFailure(struct turnEngine* engine, struct playBoard* startBoard, unsigned int turns) {
+  bool isShrinking = true;
+
+  while (isShrinking) {
+    isShrinking = false;
+
+    for (unsigned int i = 0; i < startBoard->cellCount; ++i) {
+      if (!startBoard->cells[i].isLiving) {
+        continue;
+      }
+
+      startBoard->cells[i].isLiving = false;
+      --startBoard->livingCells;
+
+      if (enginesDiverge(engine, startBoard, turns, NULL)) {
+        isShrinking = true;
+      } else {
+        startBoard->cells[i].isLiving = true;
+        ++startBoard->livingCells;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to get the neighbour offsets of a cell in a row, for the hexagonal
+// or von Neumann neighbourhood. Wrapped one by one they are the slow reference
+// the kernels are verified against. Returns the count of offsets.
+//------------------------------------------------------------------------------
+int getNeighbourOffsets(int neighbourhood, int y, const int (**offsets)[2]) {
+  static const int vonNeumannOffsets[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+  static const int hexagonalOffsets[2][6][2] = {
+    { { -1, -1 }, { 0, -1 }, { -1, 0 }, { 1, 0 }, { -1, 1 }, { 0, 1 } },  // Even rows
+    { { 0, -1 }, { 1, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } }     // Odd rows, shifted right
+  };
+
+  if (neighbourhood == HEXAGONAL) {
+    *offsets = hexagonalOffsets[y & 1];
+    return 6;
+  }
+
+  *offsets = vonNeumannOffsets;
+  return 4;
+}
+
+//------------------------------------------------------------------------------
+// Function to run the turn engines in lockstep with the reference engine.
+//
+// First the known oscillators and spaceships of the verification catalog are
+// run on odd and non-square playboards in all 8 orientations. After some periods
+// each must be found at its expected location, which checks the reference and
+// all engines including the wrap around the borders.
+//
+// Then random playboards of random sizes and densities are stepped by every
+// engine and the reference, comparing the playboards every turn. The history
+// is recorded along and replayed afterwards, it has to reproduce every turn.
+// A differing engine gets its start playboard shrunk and written as RLE file.
+// The auto engine switches between its engines every few turns.
+//
+// Last the hexagonal and von Neumann kernels are stepped on random playboards
+// against the wrapped neighbour offsets, hexagonal ones with even rows only.
+// Every neighbour of a cell has to count the cell as neighbour too.
+//------------------------------------------------------------------------------
+bool runVerification(unsigned int randomBoards) {
+  // Known patterns with their period and displacement per period
+  static const struct {
+    char* name;
+    char* rle;
+    int period;
+    int moveX;
+    int moveY;
+  } knownPatterns[] = {
+    { "Blinker", "3o!", 2, 0, 0 },
+    { "Toad", "b3o$3o!", 2, 0, 0 },
+    { "Beacon", "2o$o$3bo$2b2o!", 2, 0, 0 },
+    { "Pulsar", "2b3o3b3o2$o4bobo4bo$o4bobo4bo$o4bobo4bo$2b3o3b3o2$2b3o3b3o$o4bobo4bo$o4bobo4bo$o4bobo4bo2$2b3o3b3o!", 3, 0, 0 },
+    { "Pentadecathlon", "2bo4bo$2ob4ob2o$2bo4bo!", 15, 0, 0 },
+    { "Glider", "bo$2bo$3o!", 4, 1, 1 },
+    { "Lightweight ship", "bo2bo$o4b$o3bo$4o!", 4, -2, 0 },
+    { "Middleweight ship", "3bo2b$bo3bo$o5b$o4bo$5o!", 4, -2, 0 },
+    { "Heavyweight ship", "3b2o2b$bo4bo$o6b$o5bo$6o!", 4, -2, 0 }
+  };
+
+  // Playboard sizes with odd, even and non-square dimensions
+  static const int boardSizes[][2] = { { 37, 23 }, { 64, 64 }, { 45, 71 }, { 65, 20 } };
+
+  unsigned int knownCount = sizeof(knownPatterns) / sizeof(knownPatterns[0]);
+  unsigned int sizeCount = sizeof(boardSizes) / sizeof(boardSizes[0]);
+  unsigned int failures = 0;
+  unsigned int checks = 0;
+  uint64_t randomState = 0x9E3779B97F4A7C15ull;  // Fixed seed, every run checks the same playboards
+  struct bitBlock pattern;
+  struct bitBlock oriented;
+  struct playBoard gameBoard;
+  struct playBoard expectedBoard;
+  char filename[64];
+  char comment[128];
+
+  // The auto engine switches at fixed turns, so both conversions are checked and a failure repeats
+  autoEngineSwitchTurns = AUTO_ENGINE_VERIFY_TURNS;
+
+  printf("[VERIFY] Verifying %u turn engines against \"%s\".\n", turnEngineCount - 1, turnEngines[0].name);
+
+  //----------------------------------------------------------------------------
+  // Known oscillators and spaceships in all orientations
+  //----------------------------------------------------------------------------
+  for (unsigned int k = 0; k < knownCount; ++k) {
+    if (!parseRLE(knownPatterns[k].rle, &pattern)) {
+      printf("[VERIFY] FAILED to parse the pattern %s.\n", knownPatterns[k].name);
+      ++failures;
+      continue;
+    }
+
+    for (unsigned int s = 0; s < sizeCount; ++s) {
+      for (int orientation = 0; orientation < 8; ++orientation) {
+        if (!transformBitBlock(&pattern, &oriented, orientation & 3, orientation >= 4)) {
+          continue;
+        }
+
+        // The displacement in this orientation: mirror first, then rotate clockwise
+        int moveX = orientation >= 4 ? -knownPatterns[k].moveX : knownPatterns[k].moveX;
+        int moveY = knownPatterns[k].moveY;
+
+        for (int r = 0; r < (orientation & 3); ++r) {
+          int rotated = -moveY;
+          moveY = moveX;
+          moveX = rotated;
+        }
+
+        // Spaceships have to cross the borders of the playboard
+        int periods = knownPatterns[k].moveX != 0 || knownPatterns[k].moveY != 0 ? 2 * (boardSizes[s][0] > boardSizes[s][1] ? boardSizes[s][0] : boardSizes[s][1]) / 2 + 3 : 3;
+
+        if (!initPlayBoard(&gameBoard, boardSizes[s][0], boardSizes[s][1], boardSizes[s][0], boardSizes[s][1])) {
+          freeBitBlock(&oriented);
+          continue;
+        }
+
+        if (!initPlayBoard(&expectedBoard, boardSizes[s][0], boardSizes[s][1], boardSizes[s][0], boardSizes[s][1])) {
+          freePlayBoard(&gameBoard);
+          freeBitBlock(&oriented);
+          continue;
+        }
+
+        stampBitBlock(&oriented, &expectedBoard, 3 + (periods * moveX), 5 + (periods * moveY));
+
+        for (unsigned int e = 0; e < turnEngineCount; ++e) {
+          resetPlayboard(&gameBoard);
+          stampBitBlock(&oriented, &gameBoard, 3, 5);
+
+          for (int turn = 0; turn < periods * knownPatterns[k].period; ++turn) {
+            turnEngines[e].applyTurn(&gameBoard, false);
+          }
+
+          ++checks;
+
+          if (hashPlayBoard(&gameBoard) != hashPlayBoard(&expectedBoard) || gameBoard.livingCells != expectedBoard.livingCells) {
+            printf("[VERIFY] FAILED %s: %s on %dx%d, orientation %d, after %d turns.\n", turnEngines[e].name, knownPatterns[k].name, boardSizes[s][0], boardSizes[s][1], orientation, periods * knownPatterns[k].period);
+            ++failures;
+          }
+        }
+
+        freePlayBoard(&gameBoard);
+        freePlayBoard(&expectedBoard);
+        freeBitBlock(&oriented);
+      }
+    }
+
+    freeBitBlock(&pattern);
+  }
+
+  printf("[VERIFY] Known patterns: %u checks, %u failed.\n", checks, failures);
+
+  //----------------------------------------------------------------------------
+  // Random playboards stepped in lockstep
+  //----------------------------------------------------------------------------
+  unsigned int randomFailures = 0;
+  unsigned int turns = 64;
+
+  for (unsigned int b = 0; b < randomBoards; ++b) {
+    // Random sizes from 3 to 96 cells and densities from 1/16 to 12/16
+    int cellsX = 3 + (randomDensityWord(&randomState, 128) % 94);
+    int cellsY = 3 + (randomDensityWord(&randomState, 128) % 94);
+    unsigned int density = 16 * (1 + (randomDensityWord(&randomState, 128) % 12));
+    struct gameHistoryGame gameHistory = { 0, 0, NULL };
+    uint64_t turnHashes[65];
+
+    if (!initPlayBoard(&gameBoard, cellsX, cellsY, cellsX, cellsY)) {
+      printf("[VERIFY] Could not reserve memory for a %dx%d playboard.\n", cellsX, cellsY);
+      return false;
+    }
+
+    for (unsigned int i = 0; i < gameBoard.cellCount; i += 64) {
+      uint64_t word = randomDensityWord(&randomState, density);
+
+      for (unsigned int bit = 0; bit < 64 && i + bit < gameBoard.cellCount; ++bit) {
+        if ((word >> bit) & 1) {
+          gameBoard.cells[i + bit].isLiving = true;
+          ++gameBoard.livingCells;
+        }
+      }
+    }
+
+    // Every engine against the reference
+    for (unsigned int e = 1; e < turnEngineCount; ++e) {
+      unsigned int failedTurn = 0;
+
+      if (!enginesDiverge(&turnEngines[e], &gameBoard, turns, &failedTurn)) {
+        continue;
+      }
+
+      ++randomFailures;
+      printf("[VERIFY] FAILED %s: random playboard %u (%dx%d, %u living cells) differs after turn %u, shrinking...\n", turnEngines[e].name, b, cellsX, cellsY, gameBoard.livingCells, failedTurn);
+
+      shrinkFailure(&turnEngines[e], &gameBoard, failedTurn);
+      snprintf(filename, 64, "verify_failure_%s.rle", turnEngines[e].name);
+      snprintf(comment, 128, "Engine %s differs from %s within %u turns", turnEngines[e].name, turnEngines[0].name, failedTurn);
+
+      if (writeRLE(filename, &gameBoard, comment)) {
+        printf("[VERIFY] Minimal reproducer with %u living cells written to %s\n", gameBoard.livingCells, filename);
+      }
+    }
+
+    // The history has to replay every recorded turn of the reference
+    turnHashes[0] = hashPlayBoard(&gameBoard);
+    addHistory(&gameHistory, &gameBoard);
+
+    for (unsigned int turn = 1; turn <= turns; ++turn) {
+      turnEngines[0].applyTurn(&gameBoard, false);
+      turnHashes[turn] = hashPlayBoard(&gameBoard);
+      addHistory(&gameHistory, &gameBoard);
+    }
+
+    for (gameHistory.currentTurn = 0; gameHistory.currentTurn < gameHistory.turns; ++gameHistory.currentTurn) {
+      historyDisplayTurn(&gameHistory, &gameBoard);
+
+      if (hashPlayBoard(&gameBoard) != turnHashes[gameHistory.currentTurn]) {
+        printf("[VERIFY] FAILED history: random playboard %u (%dx%d) does not replay turn %u.\n", b, cellsX, cellsY, gameHistory.currentTurn);
+        ++randomFailures;
+        break;
+      }
+    }
+
+    clearHistory(&gameHistory);
+    freePlayBoard(&gameBoard);
+  }
+
+  if (turnEngineCount == 1) {
+    printf("[VERIFY] No optimized turn engines registered, random playboards checked the history replay only.\n");
+  }
+
+  printf("[VERIFY] Random playboards: %u playboards of %u turns, %u failed.\n", randomBoards, turns, randomFailures);
+
+  failures += randomFailures;
+
+  //----------------------------------------------------------------------------
+  // Hexagonal and von Neumann kernels against the neighbour offsets
+  //----------------------------------------------------------------------------
+  unsigned int neighbourhoodFailures = 0;
+
+  for (int n = HEXAGONAL; n <= VON_NEUMANN; ++n) {
+    for (unsigned int b = 0; b < randomBoards; ++b) {
+      // Random sizes from 4 to 96 cells, rows of a hexagonal playboard are even
+      int cellsX = 4 + (randomDensityWord(&randomState, 128) % 93);
+      int cellsY = 4 + (randomDensityWord(&randomState, 128) % 93);
+      unsigned int density = 16 * (1 + (randomDensityWord(&randomState, 128) % 12));
+      const int (*offsets)[2];
+      bool isFailed = false;
+
+      if (n == HEXAGONAL) {
+        cellsY &= ~1;
+      }
+
+      if (!initPlayBoard(&gameBoard, cellsX, cellsY, cellsX, cellsY)) {
+        printf("[VERIFY] Could not reserve memory for a %dx%d playboard.\n", cellsX, cellsY);
+        return false;
+      }
+
+      gameBoard.neighbourhood = n;
+      gameBoard.birthRule = neighbourhoods[n].birthRule;
+      gameBoard.survivalRule = neighbourhoods[n].survivalRule;
+
+      for (unsigned int i = 0; i < gameBoard.cellCount; i += 64) {
+        uint64_t word = randomDensityWord(&randomState, density);
+
+        for (unsigned int bit = 0; bit < 64 && i + bit < gameBoard.cellCount; ++bit) {
+          if ((word >> bit) & 1) {
+            gameBoard.cells[i + bit].isLiving = true;
+            ++gameBoard.livingCells;
+          }
+        }
+      }
+
+      // The neighbour relation has to be symmetric across the wrapped borders
+      for (int y = 0; y < cellsY && !isFailed; ++y) {
+        for (int x = 0; x < cellsX && !isFailed; ++x) {
+          int count = getNeighbourOffsets(n, y, &offsets);
+
+          for (int o = 0; o < count && !isFailed; ++o) {
+            int neighbourX = (x + offsets[o][0] + cellsX) % cellsX;
+            int neighbourY = (y + offsets[o][1] + cellsY) % cellsY;
+            const int (*backOffsets)[2];
+            int backCount = getNeighbourOffsets(n, neighbourY, &backOffsets);
+
+            isFailed = true;
+
+            for (int back = 0; back < backCount; ++back) {
+              if ((neighbourX + backOffsets[back][0] + cellsX) % cellsX == x && (neighbourY + backOffsets[back][1] + cellsY) % cellsY == y) {
+                isFailed = false;
+              }
+            }
+
+            if (isFailed) {
+              printf("[VERIFY] FAILED %s: on %dx%d cell %d,%d is a neighbour of %d,%d but not the other way round.\n", neighbourhoods[n].name, cellsX, cellsY, neighbourX, neighbourY, x, y);
+            }
+          }
+        }
+      }
+
+      for (unsigned int turn = 1; turn <= turns && !isFailed; ++turn) {
+        unsigned char expected[gameBoard.cellCount];
+        unsigned int expectedLiving = 0;
+
+        for (int y = 0; y < cellsY; ++y) {
+          int count = getNeighbourOffsets(n, y, &offsets);
+
+          for (int x = 0; x < cellsX; ++x) {
+            int livingNeighbours = 0;
+
+            for (int o = 0; o < count; ++o) {
+              livingNeighbours += gameBoard.cells[(((y + offsets[o][1] + cellsY) % cellsY) * cellsX) + ((x + offsets[o][0] + cellsX) % cellsX)].isLiving;
+            }
+
+            unsigned int rule = gameBoard.cells[(y * cellsX) + x].isLiving ? gameBoard.survivalRule : gameBoard.birthRule;
+
+            expected[(y * cellsX) + x] = (rule >> livingNeighbours) & 1;
+            expectedLiving += expected[(y * cellsX) + x];
+          }
+        }
+
+        neighbourhoods[n].applyTurn(&gameBoard, false);
+
+        for (unsigned int i = 0; i < gameBoard.cellCount && !isFailed; ++i) {
+          isFailed = gameBoard.cells[i].isLiving != expected[i];
+        }
+
+        if (isFailed || gameBoard.livingCells != expectedLiving) {
+          printf("[VERIFY] FAILED %s: random playboard %u (%dx%d) differs after turn %u.\n", neighbourhoods[n].name, b, cellsX, cellsY, turn);
+          isFailed = true;
+        }
+      }
+
+      neighbourhoodFailures += isFailed ? 1 : 0;
+      freePlayBoard(&gameBoard);
+    }
+  }
+
+  printf("[VERIFY] Neighbourhoods: %u hexagonal and von Neumann playboards of %u turns, %u failed.\n", 2 * randomBoards, turns, neighbourhoodFailures);
+
+  failures += neighbourhoodFailures;
+  printf("[VERIFY] %s\n", failures == 0 ? "PASSED" : "FAILED");
+
+  return failures == 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to run all benchmark cases and write the results to a JSON file
+//------------------------------------------------------------------------------
+bool runBenchmark(char* filename) {
+  struct benchmarkResult result = { 0, NULL };
+
+  printf("[BENCH] Running %d samples per case.\n", BENCH_SAMPLES);
+
+  benchmarkTurnEngines(&result);
+  benchmarkLiveList(&result);
+  benchmarkWireWorld(&result);
+  benchmarkColourLife(&result);
+  benchmarkLifeCube(&result);
+  benchmarkElementary(&result);
+  benchmarkLenia(&result);
+  benchmarkRendering(&result);
+  benchmarkHistory(&result);
+  benchmarkImages(&result);
+
+  bool isWritten = writeBenchmarkJSON(filename, &result);
+
+  if (isWritten) {
+    printf("[BENCH] %u cases written to %s\n", result.count, filename);
+  } else {
+    printf("[ERROR] Could not write the benchmark results to %s\n", filename);
+  }
+
+  freeBenchmarkResult(&result);
+
+  return isWritten;
+}
+
+//------------------------------------------------------------------------------
+// Function to add a case to the benchmark results, returns NULL if out of memory
+//------------------------------------------------------------------------------
+struct benchmarkCase* addBenchmarkCase(struct benchmarkResult* result, char* name, char* unit) {
+  struct benchmarkCase* cases = realloc(result->cases, sizeof(struct benchmarkCase) * (result->count + 1));
+
+  if (cases == NULL) {
+    return NULL;
+  }
+
+  result->cases = cases;
+
+  struct benchmarkCase* benchCase = &result->cases[result->count];
+  snprintf(benchCase->name, 64, "%s", name);
+  snprintf(benchCase->unit, 16, "%s", unit);
+  benchCase->samples = 0;
+  memset(benchCase->percentiles, 0, sizeof(benchCase->percentiles));
+  benchCase->bytes = 0;
+  benchCase->peakKilobytes = 0;
+  ++result->count;
+
+  return benchCase;
+}
+
+//------------------------------------------------------------------------------
+// Function to free all cases of the benchmark results
+//------------------------------------------------------------------------------
+void freeBenchmarkResult(struct benchmarkResult* result) {
+  free(result->cases);
+  result->cases = NULL;
+  result->count = 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the nanoseconds passed since a performance counter value
+//------------------------------------------------------------------------------
+double benchmarkNanoseconds(Uint64 start) {
+  return (double) (SDL_GetPerformanceCounter() - start) * 1000000000.0 / (double) SDL_GetPerformanceFrequency();
+}
+
+//------------------------------------------------------------------------------
+// Function to fill a playboard with random cells of a density of n/256, by a
+// seed. The same seed gives the same playboard on every run and machine.
+//------------------------------------------------------------------------------
+void fillBenchmarkBoard(struct playBoard* gameBoard, uint64_t seed, unsigned int density) {
+  uint64_t randomState = seed;
+
+  resetPlayboard(gameBoard);
+  gameBoard->isDirty = true;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; i += 64) {
+    uint64_t word = randomDensityWord(&randomState, density);
+
+    for (unsigned int bit = 0; bit < 64 && i + bit < gameBoard->cellCount; ++bit) {
+      if ((word >> bit) & 1) {
+        gameBoard->cells[i + bit].isLiving = true;
+        ++gameBoard->livingCells;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to time the turns of all turn engines. Each engine runs on a small
+// and a large dense random playboard and on a large sparse one, which is mostly
+// dead cells. Every sample starts from the same playboard, the first turns are
+// not timed to let the random start settle. The hexagonal and von Neumann
+// kernels are timed the same way, with their default rules, and last the Moore
+// kernel followed by noise of 1 percent births and deaths.
+//------------------------------------------------------------------------------
+void benchmarkTurnEngines(struct benchmarkResult* result) {
+  static const struct {
+    char* name;
+    int cells;
+    unsigned int density;
+  } boards[] = {
+    { "dense64", 64, 77 },
+    { "dense250", 250, 77 },
+    { "sparse250", 250, 3 }
+  };
+
+  unsigned int boardCount = sizeof(boards) / sizeof(boards[0]);
+  struct playBoard gameBoard;
+  char name[64];
+
+  // The turn engines, then the other neighbourhoods with their default rules, then the noise
+  for (unsigned int e = 0; e < turnEngineCount + NEIGHBOURHOOD_COUNT; ++e) {
+    bool isNoisy = e == turnEngineCount + NEIGHBOURHOOD_COUNT - 1;
+    int neighbourhood = e < turnEngineCount || isNoisy ? MOORE : (int) (e - turnEngineCount + 1);
+    char* engineName = isNoisy ? "noise" : e < turnEngineCount ? turnEngines[e].name : neighbourhoods[neighbourhood].name;
+    void (*engineTurn)(struct playBoard*, bool) = e < turnEngineCount ? turnEngines[e].applyTurn : neighbourhoods[neighbourhood].applyTurn;
+
+    for (unsigned int b = 0; b < boardCount; ++b) {
+      if (!initPlayBoard(&gameBoard, boards[b].cells, boards[b].cells, boards[b].cells, boards[b].cells)) {
+        printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+        return;
+      }
+
+      gameBoard.neighbourhood = neighbourhood;
+      gameBoard.birthRule = neighbourhoods[neighbourhood].birthRule;
+      gameBoard.survivalRule = neighbourhoods[neighbourhood].survivalRule;
+
+      if (isNoisy) {
+        gameBoard.noiseSeed = 0x2545F4914F6CDD1Dull;
+        gameBoard.birthNoise = probabilityThreshold(0.01);
+        gameBoard.deathNoise = probabilityThreshold(0.01);
+      }
+
+      snprintf(name, 64, "turn/%s/%s", engineName, boards[b].name);
+      struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/turn");
+
+      // Around two million cell updates per sample
+      unsigned int turns = 2000000 / gameBoard.cellCount;
+
+      for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+        fillBenchmarkBoard(&gameBoard, 0x2545F4914F6CDD1Dull, boards[b].density);
+
+        for (unsigned int turn = 0; turn < 8; ++turn) {
+          engineTurn(&gameBoard, false);
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+
+        for (unsigned int turn = 0; turn < turns; ++turn) {
+          engineTurn(&gameBoard, false);
+        }
+
+        benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / turns;
+      }
+
+      if (benchCase != NULL) {
+        printf("[BENCH] %-40s %12.0f %s\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit);
+      }
+
+      freePlayBoard(&gameBoard);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to time the live cell list of the list engine on a torus of a
+// million by a million cells, which no playboard could hold. Gliders are
+// spread evenly over the torus, far enough apart to never meet, so a turn
+// should cost by the living cells and not by the empty fields between them.
+//------------------------------------------------------------------------------
+void benchmarkLiveList(struct benchmarkResult* result) {
+  static const struct {
+    char* name;
+    int spread;   // The gliders in each row and column of the torus
+  } cases[] = {
+    { "gliders16", 4 },
+    { "gliders400", 20 }
+  };
+
+  static const int glider[5][2] = { { 1, 0 }, { 2, 1 }, { 0, 2 }, { 1, 2 }, { 2, 2 } };
+  struct liveList list = { 0 };
+  char name[64];
+
+  list.cellsX = 1000000;
+  list.cellsY = 1000000;
+
+  for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    int spread = cases[c].spread;
+    int spacing = list.cellsX / spread;
+
+    snprintf(name, 64, "list/torus1M/%s", cases[c].name);
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/turn");
+
+    // Around two million living cell updates per sample
+    unsigned int turns = 2000000 / (5 * spread * spread);
+
+    for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+      if (!reserveLiveList(&list, 3 * spread, 5 * spread * spread)) {
+        break;
+      }
+
+      list.rowCount = 0;
+      list.count = 0;
+      list.rowStarts[0] = 0;
+
+      // The cells are added by rows, the gliders of a row of gliders together
+      for (int gliderY = 0; gliderY < spread; ++gliderY) {
+        for (int dy = 0; dy < 3; ++dy) {
+          for (int gliderX = 0; gliderX < spread; ++gliderX) {
+            for (int g = 0; g < 5; ++g) {
+              if (glider[g][1] == dy) {
+                appendLiveCell(&list, (gliderX * spacing) + glider[g][0], (gliderY * spacing) + dy);
+              }
+            }
+          }
+        }
+      }
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      for (unsigned int turn = 0; turn < turns; ++turn) {
+        evolveLiveList(&list, 1 << 3, (1 << 2) | (1 << 3));
+      }
+
+      benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / turns;
+    }
+
+    if (benchCase != NULL) {
+      printf("[BENCH] %-40s %12.0f %s, %u living cells\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit, list.count);
+    }
+  }
+
+  freeLiveList(&list);
+}
+
+//------------------------------------------------------------------------------
+// Function to time the Wireworld turns. Every fourth row of the playboard is a
+// wire around the playboard, with electrons every few cells running along it.
+// The copper is the same in all cases, only the electrons differ, so the time
+// of a turn should follow the electrons.
+//------------------------------------------------------------------------------
+void benchmarkWireWorld(struct benchmarkResult* result) {
+  static const struct {
+    char* name;
+    unsigned int spacing;   // The cells from one electron to the next on the wires
+  } cases[] = {
+    { "wires250/few", 4000 },
+    { "wires250/busy", 8 }
+  };
+
+  struct playBoard gameBoard;
+  struct wireWorld wireWorld = { 0 };
+  char name[64];
+
+  if (!initPlayBoard(&gameBoard, 250, 250, 250, 250)) {
+    printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+    return;
+  }
+
+  gameBoard.wireWorld = &wireWorld;
+
+  for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    snprintf(name, 64, "wireworld/%s", cases[c].name);
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/turn");
+
+    for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+      resetPlayboard(&gameBoard);
+
+      // The wires are living, the electrons are a head with its tail behind
+      for (unsigned int i = 0; i < gameBoard.cellCount; ++i) {
+        if ((i / gameBoard.cellsX) % 4 == 0) {
+          gameBoard.cells[i].isLiving = true;
+          ++gameBoard.livingCells;
+        }
+      }
+
+      if (!rebuildWireWorld(&gameBoard)) {
+        break;
+      }
+
+      for (unsigned int i = 0; i < gameBoard.cellCount; i += 4 * gameBoard.cellsX) {
+        for (unsigned int x = 1; x < (unsigned int) gameBoard.cellsX; x += cases[c].spacing) {
+          gameBoard.states[i + x] = WIRE_HEAD;
+          gameBoard.states[i + x - 1] = WIRE_TAIL;
+        }
+      }
+
+      // Collect the electrons before the timing, the copper was set above
+      if (!rebuildWireWorld(&gameBoard)) {
+        break;
+      }
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      for (unsigned int turn = 0; turn < 1000; ++turn) {
+        applyTurnWireWorld(&gameBoard, false);
+      }
+
+      benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / 1000;
+    }
+
+    if (benchCase != NULL) {
+      printf("[BENCH] %-40s %12.0f %s\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit);
+    }
+  }
+
+  freeWireWorld(&wireWorld);
+  freePlayBoard(&gameBoard);
+}
+
+//------------------------------------------------------------------------------
+// Function to time the QuadLife turns on the bit planes, on the dense random
+// playboards of the turn engines with the colours of the living cells taken in
+// turn. The turns include updating the cells, like the other engines.
+//------------------------------------------------------------------------------
+void benchmarkColourLife(struct benchmarkResult* result) {
+  static const int sizes[] = { 64, 250 };
+  struct playBoard gameBoard;
+  struct colourLife colourLife = { 0 };
+  char name[64];
+
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    if (!initPlayBoard(&gameBoard, sizes[s], sizes[s], sizes[s], sizes[s])) {
+      printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+      return;
+    }
+
+    if (!initColourLife(&gameBoard, &colourLife, 4)) {
+      freePlayBoard(&gameBoard);
+      return;
+    }
+
+    gameBoard.birthRule = neighbourhoods[MOORE].birthRule;
+    gameBoard.survivalRule = neighbourhoods[MOORE].survivalRule;
+
+    snprintf(name, 64, "turn/quadlife/dense%d", sizes[s]);
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/turn");
+
+    // Around two million cell updates per sample
+    unsigned int turns = 2000000 / gameBoard.cellCount;
+
+    for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+      fillBenchmarkBoard(&gameBoard, 0x2545F4914F6CDD1Dull, 77);
+
+      for (unsigned int i = 0; i < gameBoard.cellCount; ++i) {
+        if (gameBoard.cells[i].isLiving) {
+          setCellColour(&gameBoard, i, i & 3);
+        }
+      }
+
+      for (unsigned int turn = 0; turn < 8; ++turn) {
+        applyTurnColourLife(&gameBoard, false);
+      }
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      for (unsigned int turn = 0; turn < turns; ++turn) {
+        applyTurnColourLife(&gameBoard, false);
+      }
+
+      benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / turns;
+    }
+
+    if (benchCase != NULL) {
+      printf("[BENCH] %-40s %12.0f %s\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit);
+    }
+
+    freeColourLife(&colourLife);
+    freePlayBoard(&gameBoard);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to time the 3D Life turns of the rule 4555 on random cubes of a
+// fifth living voxels. The values are per turn, showing the slice included.
+//------------------------------------------------------------------------------
+void benchmarkLifeCube(struct benchmarkResult* result) {
+  static const int sizes[] = { 64, 250 };
+  struct playBoard gameBoard;
+  struct lifeCube lifeCube = { 0 };
+  char name[64];
+
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    if (!initPlayBoard(&gameBoard, sizes[s], sizes[s], sizes[s], sizes[s])) {
+      printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+      return;
+    }
+
+    if (!parseCubeRule("4555", &lifeCube) || !initLifeCube(&gameBoard, &lifeCube)) {
+      freePlayBoard(&gameBoard);
+      return;
+    }
+
+    snprintf(name, 64, "turn/cube4555/cube%d", sizes[s]);
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/turn");
+
+    // Around a hundred million voxel updates per sample
+    unsigned int turns = 1 + (100000000 / (sizes[s] * sizes[s] * sizes[s]));
+
+    for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+      fillLifeCube(&gameBoard, 0x2545F4914F6CDD1Dull, sample, probabilityThreshold(0.2));
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      for (unsigned int turn = 0; turn < turns; ++turn) {
+        applyTurnLifeCube(&gameBoard, false);
+      }
+
+      benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / turns;
+    }
+
+    if (benchCase != NULL) {
+      printf("[BENCH] %-40s %12.0f %s\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit);
+    }
+
+    freeLifeCube(&lifeCube);
+    freePlayBoard(&gameBoard);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to time the generations of the 1D automata 30 and 110 on a row of a
+// million cells, started random. The values are per generation, the cell
+// updates per second are printed beside.
+//------------------------------------------------------------------------------
+void benchmarkElementary(struct benchmarkResult* result) {
+  static const unsigned int rules[] = { 30, 110 };
+  struct elementaryAutomaton automaton = { 0 };
+  char name[64];
+
+  if (!initElementaryAutomaton(&automaton, 1 << 20, 0)) {
+    return;
+  }
+
+  for (unsigned int r = 0; r < sizeof(rules) / sizeof(rules[0]); ++r) {
+    automaton.rule = rules[r];
+
+    snprintf(name, 64, "eca/rule%u/row1M", rules[r]);
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/gen");
+
+    for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+      for (unsigned int w = 0; w < automaton.words; ++w) {
+        automaton.row[w] = counterRandom(0x2545F4914F6CDD1Dull, sample, w);
+      }
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      for (unsigned int generation = 0; generation < 100; ++generation) {
+        evolveElementaryRow(&automaton);
+      }
+
+      benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / 100;
+    }
+
+    if (benchCase != NULL) {
+      double median = medianOf(benchCase->values, benchCase->samples);
+      printf("[BENCH] %-40s %12.0f %s, %.2f billion cell updates/s\n", benchCase->name, median, benchCase->unit, median > 0 ? automaton.cells / median : 0);
+    }
+  }
+
+  freeElementaryAutomaton(&automaton);
+}
+
+//------------------------------------------------------------------------------
+// Function to time the Lenia turns of radius 13 on random states of a
+// playboard of the largest size, the values include updating the cells
+//------------------------------------------------------------------------------
+void benchmarkLenia(struct benchmarkResult* result) {
+  struct playBoard gameBoard;
+  struct lenia lenia = { 0 };
+
+  if (!initPlayBoard(&gameBoard, 250, 250, 250, 250)) {
+    printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+    return;
+  }
+
+  if (!parseLeniaParameters("13", &lenia) || !initLenia(&gameBoard, &lenia)) {
+    freePlayBoard(&gameBoard);
+    return;
+  }
+
+  struct benchmarkCase* benchCase = addBenchmarkCase(result, "turn/lenia13/board250", "ns/turn");
+
+  for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_SAMPLES; ++sample) {
+    for (unsigned int i = 0; i < gameBoard.cellCount; ++i) {
+      lenia.states[i] = (counterRandom(0x2545F4914F6CDD1Dull, sample, i) >> 11) / 9007199254740992.0;
+    }
+
+    // The states are set directly, the dead cells of the playboard must not clear them
+    gameBoard.isEdited = false;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    for (unsigned int turn = 0; turn < 10; ++turn) {
+      applyTurnLenia(&gameBoard, false);
+    }
+
+    benchCase->values[benchCase->samples++] = benchmarkNanoseconds(start) / 10;
+  }
+
+  if (benchCase != NULL) {
+    printf("[BENCH] %-40s %12.0f %s\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit);
+  }
+
+  freeLenia(&lenia);
+  freePlayBoard(&gameBoard);
+}
+
+//------------------------------------------------------------------------------
+// Function to time the offscreen rendering of playboards. drawGameBoard draws
+// into a surface without window, at the window size the game would open for
+// the cells. Each size and density is rendered plain, with grid, animations,
+// info panel and with all of them. A turn is applied every few frames, so the
+// animations and the info panel have changed cells to show. The values are the
+// mean frame time per sample, the percentiles are taken over all frames.
+//------------------------------------------------------------------------------
+void benchmarkRendering(struct benchmarkResult* result) {
+  static const int sizes[] = { 50, 100, 250 };
+  static const unsigned int densities[] = { 26, 102 };  // 10% and 40% living cells
+  static const struct {
+    char* name;
+    bool drawGrid;
+    bool showAnimations;
+    bool drawInfoPanel;
+  } configurations[] = {
+    { "plain", false, false, false },
+    { "grid", true, false, false },
+    { "animations", false, true, false },
+    { "infopanel", false, false, true },
+    { "all", true, true, true }
+  };
+
+  unsigned int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+  unsigned int densityCount = sizeof(densities) / sizeof(densities[0]);
+  unsigned int configurationCount = sizeof(configurations) / sizeof(configurations[0]);
+  double frameTimes[BENCH_SAMPLES * BENCH_FRAMES];
+  struct playBoard gameBoard;
+  char name[64];
+
+  for (unsigned int s = 0; s < sizeCount; ++s) {
+    // The window size the game uses for this amount of cells
+    int cells = sizes[s];
+    int windowSize = cells <= 50 ? cells * 20 : cells <= 100 ? cells * 10 : cells * 5;
+
+    SDL_Surface* drawingSurface = SDL_CreateRGBSurface(0, windowSize, windowSize, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+
+    if (drawingSurface == NULL) {
+      printf("[ERROR] Could not create the offscreen surface:\n%s\n", SDL_GetError());
+      return;
+    }
+
+    cairo_surface_t* cairoSurface = cairo_image_surface_create_for_data(drawingSurface->pixels, CAIRO_FORMAT_RGB24, drawingSurface->w, drawingSurface->h, drawingSurface->pitch);
+    cairo_t* drawingContext = cairo_create(cairoSurface);
+    cairo_select_font_face(drawingContext, "sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+    cairo_set_font_size(drawingContext, 16);
+
+    if (!initPlayBoard(&gameBoard, windowSize, windowSize, cells, cells)) {
+      printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+      cairo_destroy(drawingContext);
+      cairo_surface_destroy(cairoSurface);
+      SDL_FreeSurface(drawingSurface);
+      return;
+    }
+
+    for (unsigned int d = 0; d < densityCount; ++d) {
+      for (unsigned int c = 0; c < configurationCount; ++c) {
+        struct options renderOptions;
+        struct gameHistoryGame gameHistory = { 0, 0, NULL };
+
+        memset(&renderOptions, 0, sizeof(renderOptions));
+        renderOptions.drawGrid = configurations[c].drawGrid;
+        renderOptions.showAnimations = configurations[c].showAnimations;
+        renderOptions.drawInfoPanel = configurations[c].drawInfoPanel;
+        renderOptions.doRecordHistory = configurations[c].drawInfoPanel;
+        renderOptions.messageTicks = 50;
+        renderOptions.activePanelItem = configurations[c].drawInfoPanel ? STABLE : DISABLED;
+
+        snprintf(name, 64, "render/%dx%d/d%u/%s", cells, cells, (densities[d] * 100 + 128) / 256, configurations[c].name);
+        struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/frame");
+
+        if (benchCase == NULL) {
+          break;
+        }
+
+        fillBenchmarkBoard(&gameBoard, 0x2545F4914F6CDD1Dull, densities[d]);
+
+        if (renderOptions.doRecordHistory) {
+          addHistory(&gameHistory, &gameBoard);
+        }
+
+        for (unsigned int sample = 0; sample < BENCH_SAMPLES; ++sample) {
+          double sampleTime = 0;
+
+          for (unsigned int frame = 0; frame < BENCH_FRAMES; ++frame) {
+            // A new turn every few frames, like the game does between its ticks
+            if (frame % 4 == 0) {
+              applyTurn(&gameBoard, false);
+
+              if (renderOptions.doRecordHistory) {
+                addHistory(&gameHistory, &gameBoard);
+              }
+            }
+
+            Uint64 start = SDL_GetPerformanceCounter();
+            drawGameBoard(NULL, drawingSurface, cairoSurface, drawingContext, &gameBoard, &renderOptions, &gameHistory);
+            double frameTime = benchmarkNanoseconds(start);
+
+            frameTimes[(sample * BENCH_FRAMES) + frame] = frameTime;
+            sampleTime += frameTime;
+          }
+
+          benchCase->values[benchCase->samples++] = sampleTime / BENCH_FRAMES;
+        }
+
+        benchCase->percentiles[0] = percentileOf(frameTimes, BENCH_SAMPLES * BENCH_FRAMES, 0.5);
+        benchCase->percentiles[1] = percentileOf(frameTimes, BENCH_SAMPLES * BENCH_FRAMES, 0.9);
+        benchCase->percentiles[2] = percentileOf(frameTimes, BENCH_SAMPLES * BENCH_FRAMES, 0.99);
+
+        printf("[BENCH] %-40s %12.0f %s, p50 %.0f p90 %.0f p99 %.0f\n", benchCase->name, medianOf(benchCase->values, benchCase->samples), benchCase->unit, benchCase->percentiles[0], benchCase->percentiles[1], benchCase->percentiles[2]);
+
+        clearHistory(&gameHistory);
+      }
+    }
+
+    freePlayBoard(&gameBoard);
+    cairo_destroy(drawingContext);
+    cairo_surface_destroy(cairoSurface);
+    SDL_FreeSurface(drawingSurface);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to set the playboard to a recorded generation of the same size,
+// marking the changed cells like applyTurn does
+//------------------------------------------------------------------------------
+void replayGeneration(struct bitBlock* generation, struct playBoard* gameBoard) {
+  bool isLiving = false;
+
+  gameBoard->livingCells = 0;
+
+  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
+    struct cell* gameCell = &gameBoard->cells[i];
+    isLiving = (generation->words[(gameCell->cellY * generation->wordsPerRow) + (gameCell->cellX >> 6)] >> (gameCell->cellX & 63)) & 1;
+
+    gameCell->cellChanged = gameCell->isLiving != isLiving;
+    gameCell->isLiving = isLiving;
+
+    if (isLiving) {
+      ++gameBoard->livingCells;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function to benchmark the history. The generations of standard soups are
+// recorded once, a 16x16 soup of half living cells in the middle of an empty
+// playboard and a playboard filled with 30% living cells. Every sample replays
+// them into a new history, so only the history itself is timed. Per soup:
+//
+// - append: time of addHistory per recorded cell, the inverse of records/s
+// - seek: time of historyDisplayTurn of a random turn, with percentiles
+// - scrub: time per turn stepping through all turns with historyForwards
+// - memory: bytes held by the history per recorded turn
+//------------------------------------------------------------------------------
+void benchmarkHistory(struct benchmarkResult* result) {
+  static const struct {
+    char* name;
+    int cells;
+    int soupSize;
+    unsigned int density;
+  } soups[] = {
+    { "soup16in100", 100, 16, 128 },
+    { "dense250", 250, 250, 77 }
+  };
+
+  unsigned int soupCount = sizeof(soups) / sizeof(soups[0]);
+  uint64_t randomState = 0x9E3779B97F4A7C15ull;  // Fixed seed, every run seeks the same turns
+  double seekTimes[BENCH_SAMPLES * BENCH_SEEKS];
+  struct playBoard soupBoard;
+  struct playBoard gameBoard;
+  struct bitBlock soup;
+  struct bitBlock generations[BENCH_HISTORY_TURNS + 1];
+  char name[64];
+
+  for (unsigned int s = 0; s < soupCount; ++s) {
+    int cells = soups[s].cells;
+
+    // The soup is filled on its own playboard and stamped in the middle
+    if (!initPlayBoard(&soupBoard, soups[s].soupSize, soups[s].soupSize, soups[s].soupSize, soups[s].soupSize)) {
+      printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+      return;
+    }
+
+    fillBenchmarkBoard(&soupBoard, 0x2545F4914F6CDD1Dull, soups[s].density);
+    bool isRead = readBitBlock(&soupBoard, 0, 0, soups[s].soupSize, soups[s].soupSize, &soup);
+    freePlayBoard(&soupBoard);
+
+    if (!isRead || !initPlayBoard(&gameBoard, cells, cells, cells, cells)) {
+      printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+      freeBitBlock(&soup);
+      return;
+    }
+
+    // Record the generations of the soup
+    stampBitBlock(&soup, &gameBoard, (cells - soup.width) / 2, (cells - soup.height) / 2);
+    freeBitBlock(&soup);
+
+    for (int turn = 0; turn <= BENCH_HISTORY_TURNS; ++turn) {
+      if (turn != 0) {
+        applyTurn(&gameBoard, false);
+      }
+
+      if (!readBitBlock(&gameBoard, 0, 0, cells, cells, &generations[turn])) {
+        printf("[ERROR] Could not reserve memory for the benchmark generations.\n");
+
+        while (--turn >= 0) {
+          freeBitBlock(&generations[turn]);
+        }
+
+        freePlayBoard(&gameBoard);
+        return;
+      }
+    }
+
+    // The cases are reallocated on add, so they are taken by index once all are added
+    unsigned int firstCase = result->count;
+    bool isAdded = true;
+
+    snprintf(name, 64, "history/%s/append", soups[s].name);
+    isAdded = isAdded && addBenchmarkCase(result, name, "ns/record") != NULL;
+    snprintf(name, 64, "history/%s/seek", soups[s].name);
+    isAdded = isAdded && addBenchmarkCase(result, name, "ns/seek") != NULL;
+    snprintf(name, 64, "history/%s/scrub", soups[s].name);
+    isAdded = isAdded && addBenchmarkCase(result, name, "ns/turn") != NULL;
+    snprintf(name, 64, "history/%s/memory", soups[s].name);
+    isAdded = isAdded && addBenchmarkCase(result, name, "bytes/turn") != NULL;
+
+    struct benchmarkCase* appendCase = isAdded ? &result->cases[firstCase] : NULL;
+    struct benchmarkCase* seekCase = isAdded ? &result->cases[firstCase + 1] : NULL;
+    struct benchmarkCase* scrubCase = isAdded ? &result->cases[firstCase + 2] : NULL;
+    struct benchmarkCase* memoryCase = isAdded ? &result->cases[firstCase + 3] : NULL;
+
+    for (unsigned int sample = 0; isAdded && sample < BENCH_SAMPLES; ++sample) {
+      struct gameHistoryGame gameHistory = { 0, 0, NULL };
+      double appendTime = 0;
+      double seekTime = 0;
+      unsigned int records = 0;
+
+      resetPlayboard(&gameBoard);
+
+      // Replay the recorded generations, only addHistory is timed
+      for (unsigned int turn = 0; turn <= BENCH_HISTORY_TURNS; ++turn) {
+        replayGeneration(&generations[turn], &gameBoard);
+        gameBoard.turns = turn;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        addHistory(&gameHistory, &gameBoard);
+        appendTime += benchmarkNanoseconds(start);
+        records += gameHistory.turnData[gameHistory.turns - 1].records;
+      }
+
+      appendCase->values[appendCase->samples++] = appendTime / (records > 0 ? records : 1);
+      memoryCase->values[memoryCase->samples++] = (double) historyMemory(&gameHistory) / gameHistory.turns;
+
+      // Display random turns
+      for (unsigned int seek = 0; seek < BENCH_SEEKS; ++seek) {
+        gameHistory.currentTurn = randomDensityWord(&randomState, 128) % gameHistory.turns;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        historyDisplayTurn(&gameHistory, &gameBoard);
+        double displayTime = benchmarkNanoseconds(start);
+
+        seekTimes[(sample * BENCH_SEEKS) + seek] = displayTime;
+        seekTime += displayTime;
+      }
+
+      seekCase->values[seekCase->samples++] = seekTime / BENCH_SEEKS;
+
+      // Step through all turns from the first
+      gameHistory.currentTurn = 0;
+      historyDisplayTurn(&gameHistory, &gameBoard);
+
+      Uint64 start = SDL_GetPerformanceCounter();
+
+      while (historyForwards(&gameHistory, &gameBoard));
+
+      scrubCase->values[scrubCase->samples++] = benchmarkNanoseconds(start) / (gameHistory.turns - 1);
+
+      clearHistory(&gameHistory);
+    }
+
+    for (int turn = 0; turn <= BENCH_HISTORY_TURNS; ++turn) {
+      freeBitBlock(&generations[turn]);
+    }
+
+    freePlayBoard(&gameBoard);
+
+    if (!isAdded) {
+      return;
+    }
+
+    seekCase->percentiles[0] = percentileOf(seekTimes, BENCH_SAMPLES * BENCH_SEEKS, 0.5);
+    seekCase->percentiles[1] = percentileOf(seekTimes, BENCH_SAMPLES * BENCH_SEEKS, 0.9);
+    seekCase->percentiles[2] = percentileOf(seekTimes, BENCH_SAMPLES * BENCH_SEEKS, 0.99);
+
+    double appendMedian = medianOf(appendCase->values, appendCase->samples);
+
+    printf("[BENCH] %-40s %12.1f %s, %.0f records/s\n", appendCase->name, appendMedian, appendCase->unit, appendMedian > 0 ? 1000000000.0 / appendMedian : 0);
+    printf("[BENCH] %-40s %12.0f %s, p50 %.0f p90 %.0f p99 %.0f\n", seekCase->name, medianOf(seekCase->values, seekCase->samples), seekCase->unit, seekCase->percentiles[0], seekCase->percentiles[1], seekCase->percentiles[2]);
+    printf("[BENCH] %-40s %12.0f %s\n", scrubCase->name, medianOf(scrubCase->values, scrubCase->samples), scrubCase->unit);
+    printf("[BENCH] %-40s %12.0f %s\n", memoryCase->name, medianOf(memoryCase->values, memoryCase->samples), memoryCase->unit);
+  }
+}
 
+//------------------------------------------------------------------------------
+// Function to benchmark the image import and export. Every png image of the
+// example image directory is turned into cell maps of 50, 100 and 250 cells
+// by generateCellMapFromImage, as if dropped on the window. The cell map of
+// the first image is rendered offscreen and saved by writePNG and by cairo,
+// like the "s" key does. The bytes are those of the png files read or written,
+// so MB/s follows from the median time. The peak resident memory of the
+// process is noted after each case, it only grows, so a step shows the case
+// which needed the memory.
+//------------------------------------------------------------------------------
+void benchmarkImages(struct benchmarkResult* result) {
+  static const int sizes[] = { 50, 100, 250 };
 
+  unsigned int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+  char* exportFile = "benchmark_export.png";
+  char firstImage[512] = "";
+  char imagePath[512];
+  char name[64];
+  struct playBoard gameBoard;
+  struct options imageOptions;
 
-      for (unsigned int i = 0; i < currentTurn->records; ++i) {
-        if (currentTurn->state[i] == gameOptions->activePanelItem) {
-          activeCell = &gameBoard->cells[currentTurn->index[i]];
-          cairo_rectangle(drawingContext, activeCell->x, activeCell->y, gameBoard->cellWidth, gameBoard->cellHeight);
-        }
-      }
+  memset(&imageOptions, 0, sizeof(imageOptions));
+  imageOptions.colorThreshold = (255 + 255 + 255) * 0.85;
+  imageOptions.messageTicks = 50;
 
-      cairo_fill(drawingContext);
+  if (IMG_Init(IMG_INIT_PNG) == 0) {
+    printf("[ERROR] Could not init SDL image, image benchmarks skipped:\n%s\n", IMG_GetError());
+    return;
+  }
+
+  DIR* directory = opendir(EXAMPLE_IMAGE_DIRECTORY);
+
+  if (directory == NULL) {
+    printf("[BENCH] No \"%s\" directory, image benchmarks skipped.\n", EXAMPLE_IMAGE_DIRECTORY);
+    IMG_Quit();
+    return;
+  }
+
+  //----------------------------------------------------------------------------
+  // Import every example image at every cell size
+  //----------------------------------------------------------------------------
+  struct dirent* entry = NULL;
+
+  while ((entry = readdir(directory)) != NULL) {
+    char* fileType = strrchr(entry->d_name, '.');
+
+    if (fileType == NULL || strlen(fileType) != 4 || tolower(fileType[1]) != 'p' || tolower(fileType[2]) != 'n' || tolower(fileType[3]) != 'g') {
+      continue;
     }
 
-    //--------------------------------------------------------------------------
-    cairo_set_source_rgba(drawingContext, 1, 1, 1, 0.35);
-    cairo_rectangle(drawingContext, 0, gameBoard->height-100, gameBoard->width, 100);
-    cairo_fill(drawingContext);
+    snprintf(imagePath, 512, "%s/%s", EXAMPLE_IMAGE_DIRECTORY, entry->d_name);
+    long imageBytes = fileBytes(imagePath);
 
-    unsigned int highestNum = 0;
-    unsigned int currentNum = 0;
+    if (firstImage[0] == '\0') {
+      snprintf(firstImage, 512, "%s", imagePath);
+    }
 
-    for (int i = 0; i < 3; ++i) {
-      switch (i) {
-        case 0:
-          currentNum = currentTurn->countBorn;
-          break;
-        case 1:
-          currentNum = currentTurn->countDeath;
-          break;
-        case 2:
-          currentNum = currentTurn->countStable;
-          break;
-        default:
-          break;
+    for (unsigned int s = 0; s < sizeCount; ++s) {
+      int cells = sizes[s];
+      int windowSize = cells <= 50 ? cells * 20 : cells <= 100 ? cells * 10 : cells * 5;
+
+      if (!initPlayBoard(&gameBoard, windowSize, windowSize, cells, cells)) {
+        printf("[ERROR] Could not reserve memory for the benchmark playboard.\n");
+        closedir(directory);
+        IMG_Quit();
+        return;
       }
 
-      if (currentNum > highestNum) {
-        highestNum = currentNum;
+      snprintf(name, 64, "import/%.*s/%d", (int) (fileType - entry->d_name), entry->d_name, cells);
+      struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/image");
+
+      for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_IO_SAMPLES; ++sample) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        bool isImported = generateCellMapFromImage(imagePath, &gameBoard, &imageOptions);
+        double importTime = benchmarkNanoseconds(start);
+
+        if (!isImported) {
+          printf("[BENCH] %s could not be imported: %s\n", imagePath, imageOptions.message);
+          break;
+        }
+
+        benchCase->values[benchCase->samples++] = importTime;
       }
-    }
 
-    unsigned int availableSpace = gameBoard->width - 30;
-    cairo_set_source_rgba(drawingContext, 1, 0, 0, 0.8);
-    cairo_rectangle(drawingContext, 15, gameBoard->height-90, availableSpace * ((double) currentTurn->countStable / highestNum), 20);
-    cairo_fill(drawingContext);
+      freePlayBoard(&gameBoard);
 
-    cairo_set_source_rgba(drawingContext, 0, 1, 0, 0.8);
-    cairo_rectangle(drawingContext, 15, gameBoard->height-60, availableSpace * ((double) currentTurn->countBorn / highestNum), 20);
-    cairo_fill(drawingContext);
+      if (benchCase != NULL && benchCase->samples != 0) {
+        benchCase->bytes = imageBytes;
+        benchCase->peakKilobytes = peakResidentKilobytes();
 
-    cairo_set_source_rgba(drawingContext, 0, 0, 0, 0.8);
-    cairo_rectangle(drawingContext, 15, gameBoard->height-30, availableSpace * ((double) currentTurn->countDeath / highestNum), 20);
-    cairo_fill(drawingContext);
+        double median = medianOf(benchCase->values, benchCase->samples);
+        printf("[BENCH] %-40s %12.2f ms/image, %.2f MB/s, peak RSS %ld kB\n", benchCase->name, median / 1000000.0, median > 0 ? benchCase->bytes * 1000.0 / median : 0, benchCase->peakKilobytes);
+      }
+    }
+  }
 
-    char numberToDisplay[32];
+  closedir(directory);
 
+  //----------------------------------------------------------------------------
+  // Export the rendered cell map of the first image with libpng and cairo
+  //----------------------------------------------------------------------------
+  for (unsigned int s = 0; firstImage[0] != '\0' && s < sizeCount; ++s) {
+    int cells = sizes[s];
+    int windowSize = cells <= 50 ? cells * 20 : cells <= 100 ? cells * 10 : cells * 5;
 
-    cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
+    SDL_Surface* drawingSurface = SDL_CreateRGBSurface(0, windowSize, windowSize, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
 
-    switch (gameOptions->activePanelItem) {
-      case STABLE:
-        cairo_rectangle(drawingContext, 14, gameBoard->height-91, gameBoard->width - 28, 22);
-        break;
-      case BORN:
-        cairo_rectangle(drawingContext, 14, gameBoard->height-61, gameBoard->width - 28, 22);
-        break;
-      case DEAD:
-        cairo_rectangle(drawingContext, 14, gameBoard->height-31, gameBoard->width - 28, 22);
-        break;
-      default:
-        break;
+    if (drawingSurface == NULL || !initPlayBoard(&gameBoard, windowSize, windowSize, cells, cells)) {
+      printf("[ERROR] Could not create the offscreen surface.\n");
+      SDL_FreeSurface(drawingSurface);
+      break;
     }
 
-    cairo_stroke(drawingContext);
+    cairo_surface_t* cairoSurface = cairo_image_surface_create_for_data(drawingSurface->pixels, CAIRO_FORMAT_RGB24, drawingSurface->w, drawingSurface->h, drawingSurface->pitch);
+    cairo_t* drawingContext = cairo_create(cairoSurface);
+    struct gameHistoryGame gameHistory = { 0, 0, NULL };
 
+    snprintf(imagePath, 512, "%s", firstImage);
 
+    if (generateCellMapFromImage(imagePath, &gameBoard, &imageOptions)) {
+      drawGameBoard(NULL, drawingSurface, cairoSurface, drawingContext, &gameBoard, &imageOptions, &gameHistory);
 
-    //--------------------------------------------------------------------------
-    cairo_set_source_rgba(drawingContext, 1, 1, 1, 1);
+      for (int backend = 0; backend < 2; ++backend) {
+        snprintf(name, 64, "export/%s/%d", backend == 0 ? "libpng" : "cairo", cells);
+        struct benchmarkCase* benchCase = addBenchmarkCase(result, name, "ns/image");
 
-    sprintf(numberToDisplay, "%d stable cells", currentTurn->countStable);
-    cairo_move_to(drawingContext, 20, gameBoard->height-74);
-    cairo_show_text(drawingContext, numberToDisplay);
+        for (unsigned int sample = 0; benchCase != NULL && sample < BENCH_IO_SAMPLES; ++sample) {
+          Uint64 start = SDL_GetPerformanceCounter();
+          bool isWritten = backend == 0 ? writePNG(drawingSurface, &gameBoard, exportFile, &imageOptions) : cairo_surface_write_to_png(cairoSurface, exportFile) == CAIRO_STATUS_SUCCESS;
+          double exportTime = benchmarkNanoseconds(start);
 
-    sprintf(numberToDisplay, "%d birth/s", currentTurn->countBorn);
-    cairo_move_to(drawingContext, 20, gameBoard->height-44);
-    cairo_show_text(drawingContext, numberToDisplay);
+          if (!isWritten) {
+            printf("[BENCH] %s could not be written.\n", exportFile);
+            break;
+          }
 
-    sprintf(numberToDisplay, "%d death/s", currentTurn->countDeath);
-    cairo_move_to(drawingContext, 20, gameBoard->height-14);
-    cairo_show_text(drawingContext, numberToDisplay);
-  }
+          benchCase->values[benchCase->samples++] = exportTime;
+        }
 
-  // Show a screen message in case we have one to display
-  if (gameOptions->hasMessage) {
-    gameOptions->messageTicks--;
+        if (benchCase != NULL && benchCase->samples != 0) {
+          benchCase->bytes = fileBytes(exportFile);
+          benchCase->peakKilobytes = peakResidentKilobytes();
 
-    if (gameOptions->messageTicks < 10) {
-      cairo_set_source_rgba(drawingContext, 0, 0, 0, gameOptions->messageTicks  * 0.1);
+          double median = medianOf(benchCase->values, benchCase->samples);
+          printf("[BENCH] %-40s %12.2f ms/image, %.2f MB/s, peak RSS %ld kB\n", benchCase->name, median / 1000000.0, median > 0 ? benchCase->bytes * 1000.0 / median : 0, benchCase->peakKilobytes);
+        }
 
-      if (gameOptions->messageTicks == 0) {
-        gameOptions->messageTicks = 50;
-        gameOptions->hasMessage = false;
+        remove(exportFile);
       }
-    } else {
-      cairo_set_source_rgba(drawingContext, 0, 0, 0, 1);
     }
 
-    cairo_move_to(drawingContext, 20, 20);
-    cairo_show_text(drawingContext, gameOptions->message);
+    freePlayBoard(&gameBoard);
+    cairo_destroy(drawingContext);
+    cairo_surface_destroy(cairoSurface);
+    SDL_FreeSurface(drawingSurface);
   }
 
-  // Paint all data on the cairo drawing surface to merge it into sdl
-  cairo_surface_flush(cairoSurface);
+  IMG_Quit();
+}
 
-  // Unlock the SDL surface
-  SDL_UnlockSurface(drawingSurface);
+//------------------------------------------------------------------------------
+// Function to get the size of a file in bytes, 0 if it cannot be opened
+//------------------------------------------------------------------------------
+long fileBytes(char* filename) {
+  FILE* sizeFile = fopen(filename, "rb");
+
+  if (sizeFile == NULL) {
+    return 0;
+  }
 
-  // Update and render the drawingSurface contents to the application window
-  SDL_UpdateWindowSurface(appWindow);
+  fseek(sizeFile, 0, SEEK_END);
+  long size = ftell(sizeFile);
+  fclose(sizeFile);
 
-  return isAnimating;
+  return size;
+}
+
+//------------------------------------------------------------------------------
+// Function to get the peak resident memory of the process in kilobytes,
+// as Linux reports it, 0 if the system does not tell
+//------------------------------------------------------------------------------
+long peakResidentKilobytes() {
+  #ifdef _ISWINDOWS
+    return 0;
+  #else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return 0;
+    }
+
+    return usage.ru_maxrss;
+  #endif
 }
 
+//------------------------------------------------------------------------------
+// Function to get a percentile of values by the nearest rank, the values are sorted
+//------------------------------------------------------------------------------
+double percentileOf(double* values, unsigned int count, double fraction) {
+  if (count == 0) {
+    return 0;
+  }
+
+  qsort(values, count, sizeof(double), compareDoubles);
+
+  unsigned int rank = (unsigned int) ceil(fraction * count);
+
+  return values[rank > 0 ? rank - 1 : 0];
+}
 
 //------------------------------------------------------------------------------
-// Apply turn and ruleset, returns the number of changes
+// Function to write the benchmark results to a JSON file
 //------------------------------------------------------------------------------
-void applyTurn(struct playBoard* gameBoard, bool isInHistory) {
-  gameBoard->isDirty = false;               // Do we have any changes in this round to the playboard? Set the gameboard as staled.
-  bool deathInRound[gameBoard->cellCount];  // Storage for: Which cells die in this turn?
-  bool bornInRound[gameBoard->cellCount];   // Storage for: Which cells start to live in this turn?
+bool writeBenchmarkJSON(char* filename, struct benchmarkResult* result) {
+  FILE* jsonFile = fopen(filename, "w");
 
-  // Set everything to false of above containers
-  memset(deathInRound, false, gameBoard->cellCount);
-  memset(bornInRound, false, gameBoard->cellCount);
+  if (jsonFile == NULL) {
+    return false;
+  }
 
-  for (int i = 0; i < gameBoard->cellCount; ++i) {
-    int livingNeighbours = 0;   // The number of living neighbours of a cell
+  fprintf(jsonFile, "{\n  \"program\": \"cgol\",\n  \"samples\": %d,\n  \"cases\": [\n", BENCH_SAMPLES);
 
-    // Check each direction (TOP, TOP_RIGHT, RIGHT... ) round the clock
-    // for living neighbours of the current cell at "i"
-    for (int j = 0; j < 8; ++j) {
-      if (get_neighbour_living(&gameBoard->cells[i], gameBoard, j)) {
-        ++livingNeighbours;
-      }
-    }
+  for (unsigned int c = 0; c < result->count; ++c) {
+    struct benchmarkCase* benchCase = &result->cases[c];
 
-    if (gameBoard->cells[i].isLiving) {
-      // The cell is living, handle rule 1 to 3...
-      // Rule 1: Cell dies, if less then 2 living neighbours
-      // Rule 2: Cell continues to live, if 2 or 3 living neighbours
-      // Rule 3: Cell dies if more then 3 living neighbours
-      if (livingNeighbours < 2 || livingNeighbours > 3) {
-        deathInRound[i] = true;
-      }
-    } else if (livingNeighbours == 3) {
-      // Rule 4: Dead cell which has 3 living neighbours is born
-      bornInRound[i] = true;
+    fprintf(jsonFile, "    { \"name\": \"%s\", \"unit\": \"%s\", \"values\": [", benchCase->name, benchCase->unit);
+
+    for (unsigned int i = 0; i < benchCase->samples; ++i) {
+      fprintf(jsonFile, "%s%.1f", i == 0 ? "" : ", ", benchCase->values[i]);
     }
 
-    #ifdef DEBUG
-    // Debug output, to print out how many neighbours a particular cell has all togheter
-    printf("[%d, %d] => %d\n", gameBoard->cells[i].cellX, gameBoard->cells[i].cellY, livingNeighbours);
-    #endif
-  }
+    fprintf(jsonFile, "]");
 
-  #ifdef DEBUG
-  // Just a debug output separator
-  printf("########################################\n\n");
-  #endif
+    if (benchCase->percentiles[0] != 0) {
+      fprintf(jsonFile, ", \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f", benchCase->percentiles[0], benchCase->percentiles[1], benchCase->percentiles[2]);
+    }
 
-  // Set the status of the cells, according to values of "death" or "born" changes
-  for (int i = 0; i < gameBoard->cellCount; ++i) {
-    if (deathInRound[i]) {
-      gameBoard->cells[i].isLiving = false;   // Cell dies
-      gameBoard->cells[i].cellChanged = true; // The cell changed its status
-      --gameBoard->livingCells;               // Decrease the count of living cells on the playboard
-      gameBoard->isDirty = true;              // Do we have any changes in this round, yes!
-    } else if (bornInRound[i]) {
-      gameBoard->cells[i].isLiving = true;    // Living cell born
-      gameBoard->cells[i].cellChanged = true; // The cell changed its status
-      ++gameBoard->livingCells;               // Increase the count of living cells on the playboard
-      gameBoard->isDirty = true;              // Do we have any changes in this round, yes!
-    } else {
-      gameBoard->cells[i].cellChanged = false;
+    if (benchCase->bytes != 0) {
+      double median = medianOf(benchCase->values, benchCase->samples);
+      fprintf(jsonFile, ", \"bytes\": %.0f, \"MBps\": %.2f", benchCase->bytes, median > 0 ? benchCase->bytes * 1000.0 / median : 0);
     }
-  }
 
-  // Increase the turn count of playboard by one and avoid overflow
-  if (!isInHistory && ++gameBoard->turns > TURN_LIMIT) {
-    gameBoard->turns = 0;
+    if (benchCase->peakKilobytes != 0) {
+      fprintf(jsonFile, ", \"peakRSSkB\": %ld", benchCase->peakKilobytes);
+    }
+
+    fprintf(jsonFile, " }%s\n", c + 1 < result->count ? "," : "");
   }
+
+  fprintf(jsonFile, "  ]\n}\n");
+  fclose(jsonFile);
+
+  return true;
 }
 
 //------------------------------------------------------------------------------
-// Create a random playboard state
+// Function to read benchmark results from a JSON file written by
+// writeBenchmarkJSON. Only the name, unit and values of each case are read,
+// so any other fields are skipped.
 //------------------------------------------------------------------------------
-void initRandomBoard(struct playBoard* gameBoard, struct options* gameOptions) {
-  srand(time(NULL) + clock());  // Init random number generator
+bool readBenchmarkJSON(char* filename, struct benchmarkResult* result) {
+  FILE* jsonFile = fopen(filename, "rb");
 
-  // Reset the playboard
-  resetPlayboard(gameBoard);
+  if (jsonFile == NULL) {
+    return false;
+  }
 
-  unsigned int maximumFitCellsForRandom = gameOptions->maximumFitCellsForRandom * (((rand() % 75)+25) * 0.01);
+  fseek(jsonFile, 0, SEEK_END);
+  long fileSize = ftell(jsonFile);
+  fseek(jsonFile, 0, SEEK_SET);
 
-  //----------------------------------------------------------------------------
-  // Set random cells active
-  //----------------------------------------------------------------------------
-  unsigned int i = 0;  // Cell index we want to born
+  if (fileSize <= 0 || fileSize > BENCH_FILE_LIMIT) {
+    fclose(jsonFile);
+    return false;
+  }
 
-  // This is the most random approach, but might end up taking unknown amount of time of execution...
-  // before this was linear written, setting a random living state for each cell of maximumFitCellsForRandom
-  while (maximumFitCellsForRandom > 0) {
-    i = rand() % (gameBoard->cellCount - 1);
+  char* jsonText = malloc(fileSize + 1);
 
-    if (!gameBoard->cells[i].isLiving) {
-      // Cell is not yet living, turn its status living
-      gameBoard->cells[i].isLiving = true;
+  if (jsonText == NULL) {
+    fclose(jsonFile);
+    return false;
+  }
 
-      // Set the cell state for animation
-      gameBoard->cells[i].size = 0;
-      gameBoard->cells[i].cellChanged = true;
+  size_t readBytes = fread(jsonText, 1, fileSize, jsonFile);
+  jsonText[readBytes] = '\0';
+  fclose(jsonFile);
 
-      --maximumFitCellsForRandom; // Reduce the count of to be born cells by one
-      ++gameBoard->livingCells;   // Increase the living cell count on the playboard, as we created a living cell
+  char* position = jsonText;
+  char name[64];
+  char unit[16];
+
+  while ((position = strstr(position, "\"name\"")) != NULL) {
+    char* values = strstr(position, "\"values\"");
+    char* nextName = strstr(position + 6, "\"name\"");
+
+    if (values == NULL || (nextName != NULL && nextName < values) || sscanf(position, "\"name\" : \"%63[^\"]\"", name) != 1) {
+      position += 6;
+      continue;
+    }
+
+    // The unit is optional
+    char* unitPosition = strstr(position, "\"unit\"");
+    snprintf(unit, 16, "?");
+
+    if (unitPosition != NULL && unitPosition < values) {
+      sscanf(unitPosition, "\"unit\" : \"%15[^\"]\"", unit);
+    }
+
+    struct benchmarkCase* benchCase = addBenchmarkCase(result, name, unit);
+    position = strchr(values, '[');
+
+    if (benchCase == NULL || position == NULL) {
+      break;
+    }
+
+    ++position;
+
+    // Read the numbers until the closing bracket
+    while (*position != ']' && *position != '\0') {
+      char* numberEnd = NULL;
+      double value = strtod(position, &numberEnd);
+
+      if (numberEnd == position) {
+        ++position;
+        continue;
+      }
+
+      if (benchCase->samples < BENCH_SAMPLES) {
+        benchCase->values[benchCase->samples++] = value;
+      }
+
+      position = numberEnd;
     }
   }
+
+  free(jsonText);
+
+  return result->count > 0;
 }
 
 //------------------------------------------------------------------------------
-// Function to set a options message to be display to the user
+// Function to compare two doubles for qsort
 //------------------------------------------------------------------------------
-void set_options_message(struct options* gameOptions, char message[]) {
-  sprintf(gameOptions->message, message);
-  gameOptions->hasMessage = true;
-  gameOptions->messageTicks = 50;
+int compareDoubles(const void* first, const void* second) {
+  double a = *(const double*) first;
+  double b = *(const double*) second;
+
+  return (a > b) - (a < b);
+}
+
+//------------------------------------------------------------------------------
+// Function to get the median of at most BENCH_SAMPLES values, the values are
+// sorted in a copy to keep the order of the samples
+//------------------------------------------------------------------------------
+double medianOf(double* values, unsigned int count) {
+  double sorted[BENCH_SAMPLES];
+
+  if (count == 0) {
+    return 0;
+  }
+
+  if (count > BENCH_SAMPLES) {
+    count = BENCH_SAMPLES;
+  }
+
+  memcpy(sorted, values, sizeof(double) * count);
+  qsort(sorted, count, sizeof(double), compareDoubles);
+
+  return (count & 1) ? sorted[count / 2] : (sorted[(count / 2) - 1] + sorted[count / 2]) / 2;
 }
 
 //------------------------------------------------------------------------------
-// Function to paint cells with the mouse when painting mode is enabled
+// Function to get the 95% bootstrap confidence interval of the speedup between
+// a baseline and a candidate case. Both sample sets are resampled with
+// replacement and the ratio of their medians is taken each time, the interval
+// is spanned by the 2.5% and 97.5% percentiles of those ratios. This needs no
+// assumption about the distribution of timings, which are skewed by outliers.
 //------------------------------------------------------------------------------
-void paintCell(SDL_Event* appEvent, struct playBoard* gameBoard, bool isMotionEvent) {
-  if (!isMotionEvent) {
-    // Its a mousebutton event
-
-    // The index in the playboard cell array
-    unsigned int index = (floor(appEvent->button.x / (float) gameBoard->cellWidth)) + (floor(appEvent->button.y / (float) gameBoard->cellHeight) * gameBoard->cellsY);
+void bootstrapSpeedup(struct benchmarkCase* baseline, struct benchmarkCase* candidate, uint64_t* randomState, double* low, double* high) {
+  static double ratios[BENCH_RESAMPLES];
+  double baselineDraw[BENCH_SAMPLES];
+  double candidateDraw[BENCH_SAMPLES];
+
+  for (int r = 0; r < BENCH_RESAMPLES; ++r) {
+    for (unsigned int i = 0; i < baseline->samples; ++i) {
+      // xorshift64 random number generator
+      *randomState ^= *randomState << 13;
+      *randomState ^= *randomState >> 7;
+      *randomState ^= *randomState << 17;
+      baselineDraw[i] = baseline->values[*randomState % baseline->samples];
+    }
 
-    // The index is valid, paint the cell living and increase living cell count by one
-    if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
-      gameBoard->cells[index].isLiving = true;
-      ++gameBoard->livingCells;
+    for (unsigned int i = 0; i < candidate->samples; ++i) {
+      *randomState ^= *randomState << 13;
+      *randomState ^= *randomState >> 7;
+      *randomState ^= *randomState << 17;
+      candidateDraw[i] = candidate->values[*randomState % candidate->samples];
     }
 
-    return;
+    double candidateMedian = medianOf(candidateDraw, candidate->samples);
+    ratios[r] = candidateMedian > 0 ? medianOf(baselineDraw, baseline->samples) / candidateMedian : 0;
   }
 
-  // Its a motion event, try to apply smoothing
-  int xDistance = appEvent->motion.xrel;  // The total x distance we traveled from last move event
-  int yDistance = appEvent->motion.yrel;  // The total y distance we traveled from last move event
-  unsigned int index = 0; // The array index
+  qsort(ratios, BENCH_RESAMPLES, sizeof(double), compareDoubles);
 
-  // Check if our drawing would hit the boundaries in x
-  if (xDistance < 0 && appEvent->motion.x + xDistance < 0) {
-    xDistance = appEvent->motion.x;
-  } else if (xDistance > 0 && appEvent->motion.x + xDistance > gameBoard->width) {
-    xDistance = gameBoard->width - appEvent->motion.x;
-  }
+  *low = ratios[(int) (BENCH_RESAMPLES * 0.025)];
+  *high = ratios[(int) (BENCH_RESAMPLES * 0.975)];
+}
 
-  // Check if our drawing would hit the boundaries in y
-  if (yDistance < 0 && appEvent->motion.y + yDistance < 0) {
-    yDistance = appEvent->motion.y;
-  } else if (yDistance > 0 && appEvent->motion.y + yDistance > gameBoard->height) {
-    yDistance = gameBoard->height - appEvent->motion.y;
+//------------------------------------------------------------------------------
+// Function to compare two benchmark result files case by case. The speedup is
+// the baseline median over the candidate median, above 1 the candidate is
+// faster. A case regressed if even the upper end of its confidence interval is
+// slower than the threshold allows, so noise alone does not fail a comparison.
+//------------------------------------------------------------------------------
+bool compareBenchmarks(char* baselineFile, char* candidateFile, double threshold) {
+  struct benchmarkResult baseline = { 0, NULL };
+  struct benchmarkResult candidate = { 0, NULL };
+  uint64_t randomState = 0x9E3779B97F4A7C15ull;  // Fixed seed, the same files always compare the same
+  unsigned int regressions = 0;
+  unsigned int improvements = 0;
+
+  if (!readBenchmarkJSON(baselineFile, &baseline)) {
+    printf("[ERROR] Could not read the benchmark results %s\n", baselineFile);
+    return false;
   }
 
-  // Check if xDistance or y distance is either zero so we fill one axis
-  if (xDistance == 0 || yDistance == 0) {
-
-    // How much do we increase
-    int stepWidth = 0;
-
-    // How many steps do we take?
-    int steps = abs(xDistance) > abs(yDistance) ? abs(xDistance) : abs(yDistance);
-
-    if (xDistance == 0) {
-      // We only have movement in the y-axis
-      stepWidth = yDistance < 0 ? -1 : 1; // Positive or negative multiplicator
-
-      // Paint all relevant indexes
-      for (int i = 0; i < steps; ++i) {
-        index = (floor(appEvent->motion.x / (float) gameBoard->cellWidth)) + (floor((appEvent->motion.y + (stepWidth * i)) / (float) gameBoard->cellHeight) * gameBoard->cellsY);
+  if (!readBenchmarkJSON(candidateFile, &candidate)) {
+    printf("[ERROR] Could not read the benchmark results %s\n", candidateFile);
+    freeBenchmarkResult(&baseline);
+    return false;
+  }
 
-        // The index is valid, paint the cell living and increase living cell count by one
-        if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
-          gameBoard->cells[index].isLiving = true;
-          ++gameBoard->livingCells;
-        }
-      }
-    } else {
-      // We only have movement in the x-axis
-      stepWidth = xDistance < 0 ? -1 : 1; // Positive or negative multiplicator
+  printf("[BENCH] Comparing %s (baseline) to %s (candidate), regression threshold %.1f%%\n\n", baselineFile, candidateFile, threshold * 100);
+  printf("%-40s %14s %14s %8s %17s\n", "case", "baseline", "candidate", "speedup", "95% interval");
 
-      // Paint all relevant indexes
-      for (int i = 0; i < steps; ++i) {
-        index = (floor((appEvent->motion.x + (stepWidth * i)) / (float) gameBoard->cellWidth)) + (floor(appEvent->motion.y / (float) gameBoard->cellHeight) * gameBoard->cellsY);
+  for (unsigned int c = 0; c < candidate.count; ++c) {
+    struct benchmarkCase* candidateCase = &candidate.cases[c];
+    struct benchmarkCase* baselineCase = NULL;
 
-        // The index is valid, paint the cell living and increase living cell count by one
-        if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
-          gameBoard->cells[index].isLiving = true;
-          ++gameBoard->livingCells;
-        }
+    for (unsigned int b = 0; b < baseline.count && baselineCase == NULL; ++b) {
+      if (strcmp(baseline.cases[b].name, candidateCase->name) == 0) {
+        baselineCase = &baseline.cases[b];
       }
     }
 
-  } else {
-    // The largest distance determines how many steps we take
-    int steps = abs(xDistance) > abs(yDistance) ? abs(xDistance) : abs(yDistance);
+    if (baselineCase == NULL || baselineCase->samples == 0 || candidateCase->samples == 0) {
+      printf("%-40s %14s %14s %8s\n", candidateCase->name, "-", "-", "new");
+      continue;
+    }
 
-    // How much do we increase x and y in every stepped round?
-    double stepWidthX = (double) xDistance / steps; // Positive or negative additition for the x-axis
-    double stepWidthY = (double) yDistance / steps; // Positive or negative additition for the y-axis
+    double low = 0;
+    double high = 0;
+    bootstrapSpeedup(baselineCase, candidateCase, &randomState, &low, &high);
+
+    double baselineMedian = medianOf(baselineCase->values, baselineCase->samples);
+    double candidateMedian = medianOf(candidateCase->values, candidateCase->samples);
+    double speedup = candidateMedian > 0 ? baselineMedian / candidateMedian : 0;
+    char* verdict = "";
+
+    if (high < 1 - threshold) {
+      verdict = "REGRESSION";
+      ++regressions;
+    } else if (low > 1 + threshold) {
+      verdict = "faster";
+      ++improvements;
+    }
 
-    // Store the increment of x and y
-    double increaseX = 0.0;
-    double increaseY = 0.0;
+    printf("%-40s %14.0f %14.0f %7.3fx [%.3f, %.3f] %s\n", candidateCase->name, baselineMedian, candidateMedian, speedup, low, high, verdict);
+  }
 
-    for (int i = 0; i < steps; ++i) {
-      // Get the index, increase x by step and y by a rounded float increament each time
-      index = (floor((appEvent->motion.x + ceil(increaseX)) / (float) gameBoard->cellWidth)) + (floor((appEvent->motion.y + ceil(increaseY)) / (float) gameBoard->cellHeight) * gameBoard->cellsY);
+  for (unsigned int b = 0; b < baseline.count; ++b) {
+    bool isFound = false;
 
-      // The index is valid, paint the cell living and increase living cell count by one
-      if (index < gameBoard->cellCount && !gameBoard->cells[index].isLiving) {
-        gameBoard->cells[index].isLiving = true;
-        ++gameBoard->livingCells;
-      }
+    for (unsigned int c = 0; c < candidate.count && !isFound; ++c) {
+      isFound = strcmp(baseline.cases[b].name, candidate.cases[c].name) == 0;
+    }
 
-      // Increase x and y by it stepwidth factor
-      increaseX += stepWidthX;
-      increaseY += stepWidthY;
+    if (!isFound) {
+      printf("%-40s %14s %14s %8s\n", baseline.cases[b].name, "-", "-", "removed");
     }
   }
 
-}
+  printf("\n[BENCH] %u regressions, %u improvements beyond %.1f%%\n", regressions, improvements, threshold * 100);
+
+  freeBenchmarkResult(&baseline);
+  freeBenchmarkResult(&candidate);
 
+  return regressions == 0;
+}
 
 //------------------------------------------------------------------------------
-// Function to generate cell content from 24 bit png images
+// Function to start recording the input events of the session to a file. The
+// header keeps the playboard size and random seed, which the replay needs to
+// reach the same state with the same events.
 //------------------------------------------------------------------------------
-bool generateCellMapFromImage(char* droppedFilePath, struct playBoard* gameBoard, struct options* gameOptions) {
-  FILE* inputFile = fopen(droppedFilePath, "rb");
+bool openInputRecording(struct inputSession* session, char* filename, int cellsX, int cellsY, uint64_t seed) {
+  memset(session, 0, sizeof(struct inputSession));
+  session->file = fopen(filename, "w");
 
-  // If we couldnt open the file for reading, its not usable
-  // We could perform this check with access so, but this requires gnu technology
-  if (inputFile == NULL) {
-    set_options_message(gameOptions, "Image file not accessiable.");
+  if (session->file == NULL) {
     return false;
   }
 
-  // Close it we dont use it anymore, we have read access
-  fclose(inputFile);
+  session->cellsX = cellsX;
+  session->cellsY = cellsY;
+  session->seed = seed;
+  session->startTicks = SDL_GetTicks();
 
-  // Check the filepath ending
-  int pathSize = strlen(droppedFilePath);
-  if (pathSize <= 3) {
-    set_options_message(gameOptions, "Filename without ");
-    return false;
-  }
+  fprintf(session->file, "# cgol input recording: frame milliseconds event values\n");
+  fprintf(session->file, "cells %d %d\n", cellsX, cellsY);
+  fprintf(session->file, "seed %llu\n", (unsigned long long) seed);
 
-  char* fileType = strrchr(droppedFilePath, '.');
+  return true;
+}
 
-  if (fileType == NULL) {
-    set_options_message(gameOptions, "Image missing \".\" in name.");
+//------------------------------------------------------------------------------
+// Function to open a recorded input session for replay and read its header.
+// The last frame is taken from the "end" line written when the recording
+// closed, then the file is rewound to the first event.
+//------------------------------------------------------------------------------
+bool openInputReplay(struct inputSession* session, char* filename) {
+  char line[INPUT_LINE_LIMIT];
+  unsigned long long seed = 0;
+
+  memset(session, 0, sizeof(struct inputSession));
+  session->file = fopen(filename, "r");
+
+  if (session->file == NULL) {
     return false;
   }
 
-  // Lower the fileType for checking
-  for (int i = strlen(fileType)-1; i > 0; --i) {
-    fileType[i] = tolower(fileType[i]);
-  }
+  session->isReplaying = true;
 
-  // Check if the filename is a supported png...
-  if (strcmp(fileType, ".png") != 0) {
-    // Its sees to be a unsupported filetype
-    set_options_message(gameOptions, "Only png images are supported.");
-    return false;
+  while (fgets(line, INPUT_LINE_LIMIT, session->file) != NULL) {
+    if (sscanf(line, "cells %d %d", &session->cellsX, &session->cellsY) == 2) {
+      continue;
+    } else if (sscanf(line, "seed %llu", &seed) == 1) {
+      session->seed = seed;
+    } else {
+      sscanf(line, "end %u", &session->endFrame);
+    }
   }
 
-  // Assign a surface and load the image
-  SDL_Surface* imageSurface = IMG_Load(droppedFilePath);
+  rewind(session->file);
 
-  // Check if the file was loading properly
-  if (imageSurface == NULL) {
-    set_options_message(gameOptions, "Image loading error, check console.");
-    printf("[ERROR] Image loading errror:\n%s\n\n", IMG_GetError());
+  if (session->cellsX < 5 || session->cellsY < 5 || session->cellsX > 250 || session->cellsY > 250 || session->endFrame == 0) {
+    fclose(session->file);
+    session->file = NULL;
     return false;
   }
 
+  readInputEvent(session);
 
-  // Finally, work with the surface
-  if (imageSurface->format->BitsPerPixel < 32 ) {
-    SDL_FreeSurface(imageSurface);
-    set_options_message(gameOptions, "Only 32 bit png images are supported.");
-    return false;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to write one input event of the current frame to the recording.
+// Only the events the main loop handles are written, with the values it reads.
+//------------------------------------------------------------------------------
+void recordInputEvent(struct inputSession* session, SDL_Event* appEvent) {
+  unsigned int milliseconds = SDL_GetTicks() - session->startTicks;
+
+  switch (appEvent->type) {
+    case SDL_WINDOWEVENT:
+      fprintf(session->file, "%u %u window %d %d %d\n", session->frame, milliseconds, appEvent->window.event, appEvent->window.data1, appEvent->window.data2);
+      break;
+    case SDL_MOUSEMOTION:
+      fprintf(session->file, "%u %u motion %d %d %d %d %u\n", session->frame, milliseconds, appEvent->motion.x, appEvent->motion.y, appEvent->motion.xrel, appEvent->motion.yrel, appEvent->motion.state);
+      break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+      fprintf(session->file, "%u %u %s %d %d %d %d\n", session->frame, milliseconds, appEvent->type == SDL_MOUSEBUTTONDOWN ? "buttondown" : "buttonup", appEvent->button.button, appEvent->button.x, appEvent->button.y, appEvent->button.clicks);
+      break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      fprintf(session->file, "%u %u %s %d %d\n", session->frame, milliseconds, appEvent->type == SDL_KEYDOWN ? "keydown" : "keyup", appEvent->key.keysym.sym, appEvent->key.keysym.mod);
+      break;
+    case SDL_DROPFILE:
+      fprintf(session->file, "%u %u drop %s\n", session->frame, milliseconds, appEvent->drop.file);
+      break;
+    default:
+      break;
   }
+}
 
-  unsigned int imgWidth = imageSurface->w;    // The image width
-  unsigned int imgHeight = imageSurface->h;   // The image height
+//------------------------------------------------------------------------------
+// Function to read the next event of the recording into the pending event,
+// returns false at the end of the recording
+//------------------------------------------------------------------------------
+bool readInputEvent(struct inputSession* session) {
+  char line[INPUT_LINE_LIMIT];
+  char eventName[16];
+  unsigned int milliseconds = 0;
+  int values[5];
+  int valuesOffset = 0;
+
+  session->hasPending = false;
+
+  while (fgets(line, INPUT_LINE_LIMIT, session->file) != NULL) {
+    if (sscanf(line, "%u %u %15s %n", &session->pendingFrame, &milliseconds, eventName, &valuesOffset) != 3) {
+      // Header, comment and end lines
+      continue;
+    }
 
-  // How many image pixels are average for one cell in x and y
-  unsigned int xPixelPerCell = floor((double) imgWidth / gameBoard->cellsX);
-  unsigned int yPixelPerCell = floor((double) imgHeight / gameBoard->cellsY);
+    SDL_Event* appEvent = &session->pending;
+    memset(appEvent, 0, sizeof(SDL_Event));
+    appEvent->common.timestamp = milliseconds;
+
+    if (strcmp(eventName, "window") == 0 && sscanf(&line[valuesOffset], "%d %d %d", &values[0], &values[1], &values[2]) == 3) {
+      appEvent->type = SDL_WINDOWEVENT;
+      appEvent->window.event = values[0];
+      appEvent->window.data1 = values[1];
+      appEvent->window.data2 = values[2];
+    } else if (strcmp(eventName, "motion") == 0 && sscanf(&line[valuesOffset], "%d %d %d %d %d", &values[0], &values[1], &values[2], &values[3], &values[4]) == 5) {
+      appEvent->type = SDL_MOUSEMOTION;
+      appEvent->motion.x = values[0];
+      appEvent->motion.y = values[1];
+      appEvent->motion.xrel = values[2];
+      appEvent->motion.yrel = values[3];
+      appEvent->motion.state = values[4];
+    } else if ((strcmp(eventName, "buttondown") == 0 || strcmp(eventName, "buttonup") == 0) && sscanf(&line[valuesOffset], "%d %d %d %d", &values[0], &values[1], &values[2], &values[3]) == 4) {
+      appEvent->type = eventName[6] == 'd' ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+      appEvent->button.button = values[0];
+      appEvent->button.state = eventName[6] == 'd' ? SDL_PRESSED : SDL_RELEASED;
+      appEvent->button.x = values[1];
+      appEvent->button.y = values[2];
+      appEvent->button.clicks = values[3];
+    } else if ((strcmp(eventName, "keydown") == 0 || strcmp(eventName, "keyup") == 0) && sscanf(&line[valuesOffset], "%d %d", &values[0], &values[1]) == 2) {
+      appEvent->type = eventName[3] == 'd' ? SDL_KEYDOWN : SDL_KEYUP;
+      appEvent->key.state = eventName[3] == 'd' ? SDL_PRESSED : SDL_RELEASED;
+      appEvent->key.keysym.sym = values[0];
+      appEvent->key.keysym.mod = values[1];
+    } else if (strcmp(eventName, "drop") == 0) {
+      // The main loop frees the dropped file path with SDL
+      line[strcspn(line, "\r\n")] = '\0';
+      appEvent->type = SDL_DROPFILE;
+      appEvent->drop.file = SDL_strdup(&line[valuesOffset]);
+    } else {
+      printf("[ERROR] Unknown input recording line skipped: %s", line);
+      continue;
+    }
 
-  // The total amount of image pixels one conway cell covers/is averaged from
-  unsigned int totalPixelPerCell = xPixelPerCell * yPixelPerCell;
+    session->hasPending = true;
+    return true;
+  }
 
-  // What is the maximum limit in x and y we cover with our cells, this is used to determe the borders
-  unsigned int limitX = imgWidth; // - round((double) imgWidth / gameBoard->cellsX);
-  unsigned int limitY = imgHeight; // - round((double) imgHeight / gameBoard->cellsY);
+  return false;
+}
 
-  // In case we have less then one by one pixel representation, we stop here
-  if (xPixelPerCell < 1 || yPixelPerCell < 1) {
-    SDL_FreeSurface(imageSurface);
-    set_options_message(gameOptions, "Image pixel size should be bigger then x and y count of the conway cells.");
+//------------------------------------------------------------------------------
+// Function to get the next replayed event of the current frame, like
+// SDL_PollEvent returns the waiting events of SDL
+//------------------------------------------------------------------------------
+bool nextReplayEvent(struct inputSession* session, SDL_Event* appEvent) {
+  if (!session->hasPending || session->pendingFrame > session->frame) {
     return false;
   }
 
-  // Reset the game board
-  resetPlayboard(gameBoard);
+  *appEvent = session->pending;
+  readInputEvent(session);
 
-  unsigned int index = 0;       // Index of the conway cell in the array of cells
-  unsigned int tempOffset = 0;  // The offset of a pixel in the image, used for calulation to retrive colors
+  return true;
+}
 
-  unsigned int workingX = 0;    // The maximum x offset we are scanning to/from, starting from workingX - xPixelPerCell
-  unsigned int workingY = 0;    // The maximum y offset we are scanning to/from, starting from workingY - yPixelPerCell
+//------------------------------------------------------------------------------
+// Function to count a frame of the main loop. When replaying, the time of the
+// last frame is collected and the real input of the window is discarded, so
+// only the recording drives the game.
+//------------------------------------------------------------------------------
+void beginInputFrame(struct inputSession* session) {
+  Uint64 now = SDL_GetPerformanceCounter();
 
-  // The color storages in RGB and averages by amount of samples
-  unsigned int rValue = 0;      // The added red color value
-  unsigned int gValue = 0;      // The added green color value
-  unsigned int bValue = 0;      // The added blue color value
-  unsigned int rAverage = 0;    // The red average of rValue divided by samples
-  unsigned int gAverage = 0;    // The green average of gValue divided by samples
-  unsigned int bAverage = 0;    // The blue average of bValue divided by samples
+  if (session->isReplaying) {
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
 
-  // Lock the sdl surface
-  SDL_LockSurface(imageSurface);
+    if (session->frame != 0) {
+      if (session->frameCount == session->frameCapacity) {
+        unsigned int capacity = session->frameCapacity == 0 ? 1024 : session->frameCapacity * 2;
+        double* frameTimes = realloc(session->frameTimes, sizeof(double) * capacity);
 
-  // Get the pixeldata from the image surface in a Uin32 pointer for access
-  Uint32* pixelData32bit = (Uint32 *)imageSurface->pixels;
+        if (frameTimes != NULL) {
+          session->frameTimes = frameTimes;
+          session->frameCapacity = capacity;
+        }
+      }
 
-  //----------------------------------------------------------------------------
-  // Analyze the image
-  //----------------------------------------------------------------------------
+      if (session->frameCount < session->frameCapacity) {
+        session->frameTimes[session->frameCount++] = (double) (now - session->frameStart) * 1000000000.0 / (double) SDL_GetPerformanceFrequency();
+      }
+    }
+  }
 
-  // Set the working Y to init with yPixelPercel as boundary
-  workingY = yPixelPerCell;
-  int row = 0;
+  session->frameStart = now;
+  ++session->frame;
+}
 
-  // Process loop
-  while (true) {
+//------------------------------------------------------------------------------
+// Function to end the recording or replay. A recording gets its last frame
+// written. A replay reports the frame time percentiles on the console and
+// writes them as benchmark results next to the recording, with the frame
+// times of equal parts of the replay as samples, to compare with -benchcompare.
+// The hash of the playboard shows if two replays ended the same.
+//------------------------------------------------------------------------------
+void closeInputSession(struct inputSession* session, char* filename, struct playBoard* gameBoard) {
+  if (session->file == NULL) {
+    return;
+  }
 
-    // Incease workingX
-    workingX += xPixelPerCell;
+  if (!session->isReplaying) {
+    fprintf(session->file, "end %u\n", session->frame);
+    fclose(session->file);
+    session->file = NULL;
+    printf("[STATUS] Recorded %u frames of input to %s\n", session->frame, filename);
+    return;
+  }
 
-    // Would this read of the image limit in X?
-    if (workingX > limitX) {
-      // Yes, we are at the right boundary of the image
-      workingX = xPixelPerCell;   // Reset working x to left
-      workingY += yPixelPerCell;  // Increase the row in y
+  fclose(session->file);
+  session->file = NULL;
 
-      ++row;
-      index = (row * gameBoard->cellsX) - row;
+  printf("[REPLAY] Playboard after the replay: turn %u, %u living cells, hash %016llx\n", gameBoard->turns, gameBoard->livingCells, (unsigned long long) hashPlayBoard(gameBoard));
 
-      if (workingY > limitY) {
-        // We break the loop as reading is over the boundaries of what can/should be read
-        break;
-      }
-    }
+  if (session->frameCount >= BENCH_SAMPLES) {
+    struct benchmarkResult result = { 0, NULL };
+    struct benchmarkCase* benchCase = addBenchmarkCase(&result, "replay/frame", "ns/frame");
+    char resultFile[512];
+    double totalTime = 0;
 
-    // Reset the rgb values to zero to start a new count
-    rValue = 0;
-    gValue = 0;
-    bValue = 0;
+    if (benchCase != NULL) {
+      unsigned int framesPerSample = session->frameCount / BENCH_SAMPLES;
 
-    // Retrieve the color values of the image area we are scanning in
-    for (unsigned int j = workingX - xPixelPerCell; j < workingX; ++j) {
-      for (unsigned int i = workingY - yPixelPerCell; i < workingY; ++i) {
-        tempOffset = j + (i * imgWidth) - i;  // At which image pixel we are reading from
+      for (unsigned int sample = 0; sample < BENCH_SAMPLES; ++sample) {
+        double sampleTime = 0;
 
-        // Read in the r and g and b color values from the pixel
-        rValue += ((pixelData32bit[tempOffset] & imageSurface->format->Rmask) >> imageSurface->format->Rshift) << imageSurface->format->Rloss;
-        gValue += ((pixelData32bit[tempOffset] & imageSurface->format->Gmask) >> imageSurface->format->Gshift) << imageSurface->format->Gloss;
-        bValue += ((pixelData32bit[tempOffset] & imageSurface->format->Bmask) >> imageSurface->format->Bshift) << imageSurface->format->Bloss;
+        for (unsigned int i = sample * framesPerSample; i < (sample + 1) * framesPerSample; ++i) {
+          sampleTime += session->frameTimes[i];
+        }
+
+        benchCase->values[benchCase->samples++] = sampleTime / framesPerSample;
       }
-    }
 
-    // Get the average value of the rgb colorspace divided by number of samples
-    rAverage = rValue / totalPixelPerCell;
-    gAverage = gValue / totalPixelPerCell;
-    bAverage = bValue / totalPixelPerCell;
+      for (unsigned int i = 0; i < session->frameCount; ++i) {
+        totalTime += session->frameTimes[i];
+      }
 
-    // Is the sum of all colors over the threshold?
-    if ((rAverage + gAverage + bAverage) <= gameOptions->colorThreshold) {
-      // Turn the cell on living and set its animation state
-      gameBoard->cells[index].isLiving = true;
-      gameBoard->cells[index].cellChanged = true;
-      ++gameBoard->livingCells;
-    }
+      benchCase->percentiles[0] = percentileOf(session->frameTimes, session->frameCount, 0.5);
+      benchCase->percentiles[1] = percentileOf(session->frameTimes, session->frameCount, 0.9);
+      benchCase->percentiles[2] = percentileOf(session->frameTimes, session->frameCount, 0.99);
 
-    // Increase the working index
-    ++index;
+      // The frame times are sorted by the percentiles, the last is the longest
+      printf("[REPLAY] %u frames, mean %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n", session->frameCount, totalTime / session->frameCount / 1000000.0, benchCase->percentiles[0] / 1000000.0, benchCase->percentiles[1] / 1000000.0, benchCase->percentiles[2] / 1000000.0, session->frameTimes[session->frameCount - 1] / 1000000.0);
 
-    // If in any case, the index would hit the playboard cell count, break
-    if (index >= gameBoard->cellCount-1) {
-      break;
+      snprintf(resultFile, 512, "%s.json", filename);
+
+      if (writeBenchmarkJSON(resultFile, &result)) {
+        printf("[REPLAY] Frame times written to %s\n", resultFile);
+      }
     }
 
+    freeBenchmarkResult(&result);
+  } else {
+    printf("[REPLAY] Only %u frames replayed, too few for frame time statistics.\n", session->frameCount);
   }
 
-  // Unlock the sdl image surface
-  SDL_UnlockSurface(imageSurface);
-
-  // Free the image surface
-  SDL_FreeSurface(imageSurface);
-
-  // Everything well, return true
-  return true;
+  free(session->frameTimes);
+  session->frameTimes = NULL;
+  session->frameCount = 0;
+  session->frameCapacity = 0;
 }
 
 //------------------------------------------------------------------------------
-// Function to reset the playboard to initial state
+// Function to end a timed phase of the program start, the phase lasted from
+// the end of the last one until now. The performance counter works before
+// SDL is initialized.
 //------------------------------------------------------------------------------
-void resetPlayboard(struct playBoard* gameBoard) {
-  // Reset the playboard cells...
-  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
-    gameBoard->cells[i].size = 0;
-    gameBoard->cells[i].isLiving = false;
-    gameBoard->cells[i].cellChanged = false;
+void markStartupPhase(struct startupReport* report, char* name) {
+  Uint64 now = SDL_GetPerformanceCounter();
+
+  if (report->count < STARTUP_PHASES) {
+    strncpy(report->names[report->count], name, 31);
+    report->names[report->count][31] = '\0';
+    report->milliseconds[report->count] = (double) (now - report->last) * 1000.0 / (double) SDL_GetPerformanceFrequency();
+    ++report->count;
   }
 
-  // ... and turns and living cells
-  gameBoard->turns = 0;
-  gameBoard->livingCells = 0;
+  report->last = now;
 }
 
 //------------------------------------------------------------------------------
-// Function to print out the help
+// Function to print the timeline of the program start, each phase with its
+// duration and the time since the start, up to the first frame
 //------------------------------------------------------------------------------
-void printHelp() {
-  printf("\n\nGENERAL HELP\n\nThis is Conway's Game of life.\nYou can either paint living cells, using the mouse in paint mode\nor drag and drop a 32 bit png with alpha channel into the game window,\nthis will generate a cell map varying from the image.\n\nImages should be equal in there dimensions in order to reach the best effect.\nFor example a one by one ratio, divisble by the cells in x and y to the image pixel dimensions.\nFor generation you could use The Gimp or save out images from the game using \"s\" key.\nExample images are incuded which are all consisting of 32bit PNG images with alpha.\n");
-  printf("\nSAVING IMAGES AND DRAG AND DROP\n\nIf you want to save an image, you can do so by pressing \"s\" key.\nIt is then saved to the folder \"saved_images/TIMESTAMP.png\".\nThe routine saves everything except the grid and the message displayed inside the game window.\nThose images can be reimported into the application, like other images, by drag and drop.\n\nNote that CAIRO backend png's, switch \"-cb\", cannot directly be imported as they are missing the alpha channel.\nYou have to use The Gimp or similiar to add an alpha channel, then import is working!\n");
-  printf("\nINFO PANEL USAGE\n\nIf the history is enabled (\"h\" key) - and the info panel enabled,\nthree bars are shown at the bottom of the screen. When the mouse is moved on\ntop of those bars, either:\n\t- Stable cells are shown, which didnt change in this turn or survived\n\t- Born cells. cells which did become born during a turn\n\t- Dead cells, which died during this turn\n\nIf you hover over the corresponding bar, you see the exact cells highlighted.\nAnd there counts are always displayed on the bars.\n");
-  printf("\nAVAILABLE COMMANDS\n");
-  printf("-h\t\t\t\tThis help\n");
-  printf("-c5 ... 250\t\t\tAmount of cells in x and y by one number from 5 to 250 (default: 50)\n");
-  printf("-ct0.0 ... 1.0\t\t\tFloating point value 0.5 for 50 percent color threshold (default: 0.85)\n\t\t\t\t(rgb added together and averaged) for living cell image generation, below the set value\n");
-  printf("-mfc0.0 ... 1.0\t\t\tMaximum fit cells for random number generator (default 0.4)\n");
-  printf("\nStart options of boolean type either 0/1 or t/f AND (also in game options/keybindings):\n\n");
-  printf("-gBOOL\t+[KEY]\t\t\tGrid enabled (t)rue or 1 or disabled (f)alse or 0 - (\"g\" key in game)\n");
-  printf("-aBOOL\t+[KEY]\t\t\tAnimations enabled or disabled (\"a\" key in game to toggle)\n");
-  printf("-htBOOL\t+[KEY]\t\t\tHistory enabled or disabled (Toggled using \"h\" key in game)\n");
-  printf("-iBOOL\t+[KEY]\t\t\tDraw infopanel when history is enabled and one turn is processed (Toggled with \"i\" key)\n");
-  printf("-r\t+[KEY]\t\t\tShould the game start with a random playboard, be regenerated with a\n\t\t\t\trandom playboard (\"r\" key in game)\n");
-  printf("\n-cb\t\t\t\tShould cairo's png functions be used instead of libpng to save images\n\t\t\t\tCairo backend images cannot be imported directly! Please read the help for more information.\n");
-  printf("\n[KEY] \"s\"\t\t\tSaves the actual scene, including the info panel if displayed (\"s\" key in game)\n");
-  printf("[KEY] \"+\" (not numpad)\t\tDecrease game ticks and increase game speed (\"+\" key in game)\n");
-  printf("[KEY] \",\"\t\t\tGo back in history, if enabled (\",\" key in game)\n");
-  printf("[KEY] \".\"\t\t\tGo forward in history, if enabled (\".\" key in game)\n");
-  printf("[KEY] \"c\"\t\t\tClear game board (\"c\" key in game)\n");
-  printf("[KEY] \"p\"\t\t\tPaint mode (\"p\" key in game)\n");
-  printf("[KEY] \"Space\"\t\t\tPlay/Pause the game (\"space\" key in game)\n");
+void printStartupReport(struct startupReport* report) {
+  double elapsed = 0;
+
+  printf("[STARTUP] %-24s %10s %10s\n", "phase", "ms", "at ms");
+
+  for (unsigned int i = 0; i < report->count; ++i) {
+    elapsed += report->milliseconds[i];
+    printf("[STARTUP] %-24s %10.3f %10.3f\n", report->names[i], report->milliseconds[i], elapsed);
+  }
+
+  printf("[STARTUP] Time to first frame: %.3f ms\n", (double) (report->last - report->start) * 1000.0 / (double) SDL_GetPerformanceFrequency());
+  printf("[STARTUP] Deferred until first use: image loading, font face, %s directory\n", SAVED_IMAGE_DIRECTORY);
 }
 
 //------------------------------------------------------------------------------
-// Function to clear the game history
+// Function to init the image loading of SDL image on the first image import,
+// most sessions never import an image. Returns false if it is not available.
 //------------------------------------------------------------------------------
-bool clearHistory(struct gameHistoryGame* gameHistory) {
-  if (gameHistory->turnData == NULL) {
-    return false;
-  }
+bool ensureImageLoading() {
+  static bool isInitialized = false;
 
-  for (unsigned int i = 0; i < gameHistory->turns; ++i) {
-    free(gameHistory->turnData[i].state);
-    free(gameHistory->turnData[i].index);
-  }
+  if (!isInitialized) {
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0) {
+      printf("[ERROR] Error initializing image loading:\n%s\n", IMG_GetError());
+      return false;
+    }
 
-  free(gameHistory->turnData);
-  gameHistory->turnData = NULL;
-  gameHistory->turns = 0;
-  gameHistory->currentTurn = 0;
+    isInitialized = true;
+  }
 
   return true;
 }
 
 //------------------------------------------------------------------------------
-// Function to add a turn to the history
+// Function to create a directory before the first file is written to it, an
+// existing directory is fine
 //------------------------------------------------------------------------------
-bool addHistory(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
-  if (gameHistory->turns > gameBoard->turns) {
+bool ensureDirectory(char* directoryPath) {
+  // Check if we build on windows, otherwise assume unix
+  #ifdef _ISWINDOWS
+    int isCreated = mkdir(directoryPath);
+  #else
+    int isCreated = mkdir(directoryPath, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+  #endif
+
+  if (isCreated != 0 && errno != EEXIST) {
+    printf("[ERROR] Could not create the directory %s\n", directoryPath);
     return false;
   }
 
-  if (gameHistory->turns == TURN_LIMIT) {
-    clearHistory(gameHistory);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Function to select the font face before the first text is drawn, the font
+// lookup is left out of the start of the program
+//------------------------------------------------------------------------------
+void selectGameFont(cairo_t* drawingContext, struct options* gameOptions) {
+  if (gameOptions->isFontSelected) {
+    return;
   }
 
-  gameHistory->turnData = realloc(gameHistory->turnData, sizeof(struct gameHistoryTurn) * (gameHistory->turns + 1));
+  cairo_select_font_face(drawingContext, "sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+  cairo_set_font_size(drawingContext, 16);
+  gameOptions->isFontSelected = true;
+}
 
-  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->turns];
+//------------------------------------------------------------------------------
+// Function to start the flight recorder, frames longer than stallMilliseconds
+// dump it. The recorder is dumped on SIGSEGV and SIGABRT too.
+//------------------------------------------------------------------------------
+void initFlightRecorder(unsigned int stallMilliseconds) {
+  flightLog.count = 0;
+  flightLog.frame = 0;
+  flightLog.frameStart = 0;
+  flightLog.isCrashed = 0;
+  flightLog.start = SDL_GetPerformanceCounter();
+  flightLog.frequency = SDL_GetPerformanceFrequency();
+  flightLog.stallTicks = flightLog.frequency * stallMilliseconds / 1000;
+
+  signal(SIGSEGV, flightRecorderSignal);
+  signal(SIGABRT, flightRecorderSignal);
+}
 
-  if (currentTurn == NULL) {
-    return false;
-  }
+//------------------------------------------------------------------------------
+// Function to record an event which started at the performance counter value
+// start and ends now, the oldest event is overwritten when the ring is full
+//------------------------------------------------------------------------------
+void recordFlightEvent(int type, Uint64 start, int value) {
+  struct flightEvent* event = &flightLog.events[flightLog.count % FLIGHT_EVENTS];
 
-  currentTurn->records = 0;
-  currentTurn->countBorn = 0;
-  currentTurn->countDeath = 0;
-  currentTurn->countStable = 0;
-  currentTurn->state = NULL;
-  currentTurn->index = NULL;
+  event->type = type;
+  event->value = value;
+  event->frame = flightLog.frame;
+  event->start = start;
+  event->duration = SDL_GetPerformanceCounter() - start;
 
-  gameHistory->currentTurn = gameHistory->turns;
-  ++gameHistory->turns;
+  ++flightLog.count;
+}
 
+//------------------------------------------------------------------------------
+// Function to count a frame of the main loop and start its timer. A frame
+// which was not ended before an idle delay of the main loop is ended here.
+//------------------------------------------------------------------------------
+void beginFlightFrame() {
+  endFlightFrame();
 
-  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
-    if (gameBoard->cells[i].cellChanged) {
-      currentTurn->state = realloc(currentTurn->state, sizeof(short) * (currentTurn->records + 1));
-      currentTurn->index = realloc(currentTurn->index, sizeof(unsigned int) * (currentTurn->records + 1));
+  flightLog.frameStart = SDL_GetPerformanceCounter();
+  ++flightLog.frame;
+}
 
-      currentTurn->index[currentTurn->records] = gameBoard->cells[i].cellX + (gameBoard->cells[i].cellY * gameBoard->cellsX);
+//------------------------------------------------------------------------------
+// Function to stop the timer of the running frame, called before the main
+// loop idles, so the delays of a paused game never count as a stall. The
+// frame is recorded and a frame longer than the stall threshold dumps the
+// recorder.
+//------------------------------------------------------------------------------
+void endFlightFrame() {
+  if (flightLog.frameStart == 0) {
+    return;
+  }
 
-      if (gameBoard->cells[i].isLiving) {
-        ++currentTurn->countBorn;
-        currentTurn->state[currentTurn->records] = BORN;
-      } else {
-        ++currentTurn->countDeath;
-        currentTurn->state[currentTurn->records] = DEAD;
-      }
+  Uint64 frameStart = flightLog.frameStart;
+  Uint64 now = SDL_GetPerformanceCounter();
 
-      ++currentTurn->records;
-    } else if (gameBoard->cells[i].isLiving) {
-      currentTurn->state = realloc(currentTurn->state, sizeof(short) * (currentTurn->records + 1));
-      currentTurn->index = realloc(currentTurn->index, sizeof(unsigned int) * (currentTurn->records + 1));
+  flightLog.frameStart = 0;
+  recordFlightEvent(FLIGHT_FRAME, frameStart, 0);
 
-      currentTurn->state[currentTurn->records] = STABLE;
-      currentTurn->index[currentTurn->records] = gameBoard->cells[i].cellX + (gameBoard->cells[i].cellY * gameBoard->cellsX);
-      ++currentTurn->countStable;
+  if (now - frameStart > flightLog.stallTicks) {
+    unsigned int milliseconds = (now - frameStart) * 1000 / flightLog.frequency;
 
-      ++currentTurn->records;
-    }
+    recordFlightEvent(FLIGHT_STALL, frameStart, milliseconds);
+    dumpFlightRecorder(FLIGHT_RECORDER_FILE, "stall");
+    printf("[STATUS] Frame %u took %u ms, the flight recorder is written to %s\n", flightLog.frame, milliseconds, FLIGHT_RECORDER_FILE);
   }
-
-  return true;
 }
 
 //------------------------------------------------------------------------------
-// Function to get backwards in the history
+// Function to append a decimal number to a line of the dump, printf is not
+// safe to call from a signal handler
 //------------------------------------------------------------------------------
-bool historyBackwards(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
-  if (gameHistory->currentTurn == 0 || gameHistory->turns == 0) {
-    return false;
-  }
+void appendFlightNumber(char* line, int* length, unsigned long long number) {
+  char digits[24];
+  int count = 0;
 
-  --gameHistory->currentTurn;
+  do {
+    digits[count++] = '0' + (number % 10);
+    number /= 10;
+  } while (number != 0);
 
-  if (historyDisplayTurn(gameHistory, gameBoard)) {
-    return true;
+  while (count > 0) {
+    line[(*length)++] = digits[--count];
   }
-
-  return false;
 }
 
 //------------------------------------------------------------------------------
-// Function to get forward in the history
+// Function to write the recorded events, oldest first, to a file. Times are
+// microseconds since the program start. Only open, write and close are used,
+// so it is safe to call from a signal handler.
 //------------------------------------------------------------------------------
-bool historyForwards(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+void dumpFlightRecorder(char* fileName, char* reason) {
+  int dumpFile = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
 
-  if (gameHistory->currentTurn == gameBoard->turns || gameHistory->turns == 0 || gameHistory->currentTurn == (gameHistory->turns - 1)) {
-    return false;
+  if (dumpFile < 0) {
+    return;
   }
 
-  ++gameHistory->currentTurn;
+  char line[128];
+  int length = 0;
+  char header[] = "# cgol flight recorder, times in microseconds since the start\n# frame start duration event value\n";
+  unsigned long long first = flightLog.count > FLIGHT_EVENTS ? flightLog.count - FLIGHT_EVENTS : 0;
 
-  if (historyDisplayTurn(gameHistory, gameBoard)) {
-    return true;
-  }
+  memcpy(line, "# dumped on ", 12);
+  length = 12;
 
-  return false;
-}
+  for (int i = 0; reason[i] != '\0' && length < 100; ++i) {
+    line[length++] = reason[i];
+  }
 
-//------------------------------------------------------------------------------
-// Function to display a history state on the playboard
-//------------------------------------------------------------------------------
-bool historyDisplayTurn(struct gameHistoryGame* gameHistory, struct playBoard* gameBoard) {
+  line[length++] = '\n';
 
-  // Reset the playboard to zero
-  for (unsigned int i = 0; i < gameBoard->cellCount; ++i) {
-    gameBoard->cells[i].isLiving = false;
-    gameBoard->cells[i].cellChanged = false;
-    gameBoard->cells[i].size = 0;
+  if (write(dumpFile, line, length) < 0 || write(dumpFile, header, sizeof(header) - 1) < 0) {
+    close(dumpFile);
+    return;
   }
 
-  // Get the current history turn
-  struct gameHistoryTurn* currentTurn = &gameHistory->turnData[gameHistory->currentTurn];
-
-  // The working cell index in the playboard cell array
-  unsigned int index = 0;
+  for (unsigned long long i = first; i < flightLog.count; ++i) {
+    struct flightEvent* event = &flightLog.events[i % FLIGHT_EVENTS];
+    Uint64 start = event->start - flightLog.start;
+
+    // Split the conversion to microseconds, so long runs do not overflow
+    length = 0;
+    appendFlightNumber(line, &length, event->frame);
+    line[length++] = ' ';
+    appendFlightNumber(line, &length, (start / flightLog.frequency) * 1000000 + (start % flightLog.frequency) * 1000000 / flightLog.frequency);
+    line[length++] = ' ';
+    appendFlightNumber(line, &length, (event->duration / flightLog.frequency) * 1000000 + (event->duration % flightLog.frequency) * 1000000 / flightLog.frequency);
+    line[length++] = ' ';
+
+    for (int c = 0; flightEventNames[event->type][c] != '\0'; ++c) {
+      line[length++] = flightEventNames[event->type][c];
+    }
 
-  // Set the cells accordings there recorded states
-  for (unsigned int i = 0; i < currentTurn->records; ++i) {
-    index = currentTurn->index[i];
+    line[length++] = ' ';
 
-    switch (currentTurn->state[i]) {
-      case STABLE:
-        // The cell was stable
-        gameBoard->cells[index].isLiving = true;
-        gameBoard->cells[index].cellChanged = false;
-        gameBoard->cells[index].size = 1;
-        break;
-      case DEAD:
-        // The cell was dying
-        gameBoard->cells[index].isLiving = false;
-        gameBoard->cells[index].cellChanged = true;
-        gameBoard->cells[index].size = 1;
-        break;
-      case BORN:
-        // The cell was born
-        gameBoard->cells[index].isLiving = true;
-        gameBoard->cells[index].cellChanged = true;
-        gameBoard->cells[index].size = 0;
-        break;
-      default:
-        break;
+    if (event->value < 0) {
+      line[length++] = '-';
+      appendFlightNumber(line, &length, -(long long) event->value);
+    } else {
+      appendFlightNumber(line, &length, event->value);
     }
 
+    line[length++] = '\n';
+
+    if (write(dumpFile, line, length) < 0) {
+      break;
+    }
   }
 
-  return true;
+  close(dumpFile);
 }
 
 //------------------------------------------------------------------------------
-// Function to write out a image using libPNG functions
+// Function to dump the flight recorder on SIGSEGV and SIGABRT to its own file,
+// which a stall dump, even one running while the crash hits, cannot overwrite.
+// Then the signal is raised again with the default handler to end the program.
 //------------------------------------------------------------------------------
-bool writePNG(SDL_Surface* drawingSurface, struct playBoard* gameBoard, char* filename, struct options* gameOptions) {
-  // Get the surface dimensions
-  unsigned int width = drawingSurface->w;
-  unsigned int height = drawingSurface->h;
+void flightRecorderSignal(int signalNumber) {
+  if (!flightLog.isCrashed) {
+    flightLog.isCrashed = 1;
+    dumpFlightRecorder(FLIGHT_CRASH_FILE, signalNumber == SIGSEGV ? "SIGSEGV" : "SIGABRT");
+  }
 
-  // Prepare the png structures
-  png_structp png_ptr = NULL;
-	png_infop info_ptr = NULL;
-	png_bytep row;
+  signal(signalNumber, SIG_DFL);
+  raise(signalNumber);
+}
 
-  // Try if we can access the image for reading
-  FILE *imageFile = fopen(filename, "wb");
+//------------------------------------------------------------------------------
+// Function to add or remove accounted bytes of a subsystem and update the peaks
+//------------------------------------------------------------------------------
+void memoryAccount(int tag, long long bytes) {
+  memoryStats.current[tag] += bytes;
+  memoryStats.total += bytes;
 
-  if (imageFile == NULL) {
-    set_options_message(gameOptions, "Could not open file for writing.");
-    return false;
+  if (memoryStats.current[tag] > memoryStats.peak[tag]) {
+    memoryStats.peak[tag] = memoryStats.current[tag];
   }
 
-  // Initialize png write structure
-  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  if (memoryStats.total > memoryStats.totalPeak) {
+    memoryStats.totalPeak = memoryStats.total;
+  }
+}
 
-  if (png_ptr == NULL) {
-    set_options_message(gameOptions, "Could not create png write structure.");
-    fclose(imageFile);
-    remove(filename);
-		return false;
-	}
+//------------------------------------------------------------------------------
+// Function to allocate memory accounted to a subsystem, like malloc. The size
+// and tag are stored in a header in front of the returned memory.
+//------------------------------------------------------------------------------
+void* memoryAllocate(int tag, size_t bytes) {
+  union memoryHeader* header = malloc(sizeof(union memoryHeader) + bytes);
 
-  // Initialize png info structure
-	info_ptr = png_create_info_struct(png_ptr);
-	if (info_ptr == NULL) {
-    set_options_message(gameOptions, "Could not create png info structure.");
-    fclose(imageFile);
-    remove(filename);
-    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
-	}
+  if (header == NULL) {
+    return NULL;
+  }
 
-  // Setup Exception handling
-	if (setjmp(png_jmpbuf(png_ptr))) {
-    set_options_message(gameOptions, "An error in libPNG occured.");
-    fclose(imageFile);
-    remove(filename);
-    png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
-    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
-	}
+  header->info.bytes = bytes;
+  header->info.tag = tag;
+  memoryAccount(tag, bytes);
+
+  return header + 1;
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate zeroed memory accounted to a subsystem, like calloc
+//------------------------------------------------------------------------------
+void* memoryAllocateZeroed(int tag, size_t count, size_t size) {
+  if (size != 0 && count > ((size_t) -1 - sizeof(union memoryHeader)) / size) {
+    return NULL;
+  }
 
-  // Init png
-  png_init_io(png_ptr, imageFile);
+  void* data = memoryAllocate(tag, count * size);
 
-	// Write header (8 bit color depth, RGB plus alpha channel)
-	png_set_IHDR(png_ptr, info_ptr, width, height,
-			8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
-			PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_DEFAULT);
+  if (data != NULL) {
+    memset(data, 0, count * size);
+  }
 
-	png_write_info(png_ptr, info_ptr);
+  return data;
+}
 
+//------------------------------------------------------------------------------
+// Function to resize memory accounted to a subsystem, like realloc a NULL
+// pointer allocates. On failure the old memory stays valid.
+//------------------------------------------------------------------------------
+void* memoryResize(int tag, void* data, size_t bytes) {
+  if (data == NULL) {
+    return memoryAllocate(tag, bytes);
+  }
 
-  // Allocate memory for one row (4 bytes per pixel - RGBA)
-	row = (png_bytep) calloc(sizeof(png_byte), 4 * width);
+  union memoryHeader* header = (union memoryHeader*) data - 1;
+  size_t oldBytes = header->info.bytes;
+  int oldTag = header->info.tag;
 
-  if (row == NULL) {
-    set_options_message(gameOptions, "Insufficient ram to create png row.");
-    fclose(imageFile);
-    remove(filename);
-    png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
-    png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
-    return false;
+  header = realloc(header, sizeof(union memoryHeader) + bytes);
+
+  if (header == NULL) {
+    return NULL;
   }
 
-  // Get the pixel data
-  SDL_LockSurface(drawingSurface);
-  Uint32* pixelData = (Uint32*) drawingSurface->pixels;
-  SDL_UnlockSurface(drawingSurface);
+  memoryAccount(oldTag, -(long long) oldBytes);
+  header->info.bytes = bytes;
+  header->info.tag = tag;
+  memoryAccount(tag, bytes);
 
-  // Write image data
-  unsigned int offset = 0;    // The offset of the pixel in the image
-  unsigned int yOffset = 0;   // The yOffset adding to the pixel offset
+  return header + 1;
+}
 
-  unsigned int rowOffset = 0;   // The offset of the pixel data in the row
+//------------------------------------------------------------------------------
+// Function to free accounted memory, NULL is ignored like by free
+//------------------------------------------------------------------------------
+void memoryFree(void* data) {
+  if (data == NULL) {
+    return;
+  }
 
-	for (unsigned int y = 0; y < height; y++) {
-    yOffset = (y * width);
-    for (unsigned int x = 0; x < width; x++) {
-      offset = x + yOffset;
-      rowOffset = x * 4;
-      row[rowOffset] = ((pixelData[offset] & drawingSurface->format->Rmask) >> drawingSurface->format->Rshift) << drawingSurface->format->Rloss;
-      row[rowOffset + 1] = ((pixelData[offset] & drawingSurface->format->Gmask) >> drawingSurface->format->Gshift) << drawingSurface->format->Gloss;
-      row[rowOffset + 2] = ((pixelData[offset] & drawingSurface->format->Bmask) >> drawingSurface->format->Bshift) << drawingSurface->format->Bloss;
-      row[rowOffset + 3] = 255;
-		}
+  union memoryHeader* header = (union memoryHeader*) data - 1;
 
-		png_write_row(png_ptr, row);
-	}
+  memoryAccount(header->info.tag, -(long long) header->info.bytes);
+  free(header);
+}
 
-  // End write
-	png_write_end(png_ptr, NULL);
+//------------------------------------------------------------------------------
+// Function to format the current and peak bytes of a subsystem as one line,
+// MEMORY_TAGS formats the sum of all subsystems
+//------------------------------------------------------------------------------
+void formatMemoryLine(char* line, int tag) {
+  if (tag == MEMORY_TAGS) {
+    snprintf(line, MEMORY_LINE_LENGTH, "%-15s %9.1f kB  peak %9.1f kB", "total", memoryStats.total / 1024.0, memoryStats.totalPeak / 1024.0);
+  } else {
+    snprintf(line, MEMORY_LINE_LENGTH, "%-15s %9.1f kB  peak %9.1f kB", memoryTagNames[tag], memoryStats.current[tag] / 1024.0, memoryStats.peak[tag] / 1024.0);
+  }
+}
 
-  // Close the image and cleanup
-  fclose(imageFile);
-  png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
-  png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+//------------------------------------------------------------------------------
+// Function to print the memory of every subsystem and the peak resident memory
+// of the process, which also covers the libraries and the program itself
+//------------------------------------------------------------------------------
+void printMemoryReport() {
+  char line[MEMORY_LINE_LENGTH];
 
-  free(row);
+  for (int tag = 0; tag <= MEMORY_TAGS; ++tag) {
+    formatMemoryLine(line, tag);
+    printf("[MEMORY] %s\n", line);
+  }
 
-  return true;
+  long peakKilobytes = peakResidentKilobytes();
+
+  if (peakKilobytes > 0) {
+    printf("[MEMORY] Peak resident memory of the process: %ld kB\n", peakKilobytes);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -1276,12 +9805,12 @@ bool writePNG(SDL_Surface* drawingSurface, struct playBoard* gameBoard, char* fi
 //------------------------------------------------------------------------------
 int main(int argc, char *argv[]) {
 
-  // Check if we build on windows, otherwise assume unix
-  #ifdef _ISWINDOWS
-    mkdir("saved_images");
-  #else
-    mkdir("saved_images", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-  #endif
+  // Time the program start up to the first frame, printed with --startup-report
+  struct startupReport startupReport;
+
+  memset(&startupReport, 0, sizeof(startupReport));
+  startupReport.start = SDL_GetPerformanceCounter();
+  startupReport.last = startupReport.start;
 
   //----------------------------------------------------------------------------
   // Show a welcome message on start
@@ -1315,6 +9844,42 @@ int main(int argc, char *argv[]) {
   int maximumFitCellsForRandom = (cellsX * cellsY) * 0.4;
   float maximumFitCellsForRandomValue = 0.4;
 
+  // Memory cap of the undo journal in kilobytes
+  int undoLimit = UNDO_LIMIT_KB;
+
+  // How many random playboards to verify the turn engines with, 0 starts the game
+  int verifyBoards = 0;
+
+  // The benchmark result file to write, and the two result files to compare
+  char* benchmarkFile = NULL;
+  char* baselineFile = NULL;
+  char* candidateFile = NULL;
+  float benchThreshold = BENCH_THRESHOLD;
+
+  // The input recording to write or to replay
+  char* recordFile = NULL;
+  char* replayFile = NULL;
+
+  // Frames longer than this many milliseconds dump the flight recorder
+  int stallMilliseconds = FLIGHT_STALL_MS;
+
+  // The neighbourhood of the cells and the rule, NULL takes the default rule of the neighbourhood
+  int neighbourhood = MOORE;
+  char* ruleText = NULL;
+  char* tableFile = NULL;         // The Golly .rule or .table file of a multi-state automaton, NULL for Conway's game
+  bool isWireWorld = false;       // Play Wireworld, the living cells are copper
+  unsigned int colourCount = 0;   // The colours of Immigration (2) or QuadLife (4), 0 for one colour
+  char* cubeRule = NULL;          // The rule of 3D Life in Bays notation, NULL for the game on the playboard
+  int elementaryRule = -1;        // The rule of a 1D automaton from 0 to 255, -1 for the game on the playboard
+  char* elementaryText = NULL;    // The rule number of a 1D automaton as given, NULL for the game on the playboard
+  char* leniaParameters = NULL;   // The radius, mu, sigma and time resolution of Lenia, NULL for the game on the playboard
+  char* engineName = NULL;        // The turn engine of a moore rule, NULL for the default engine
+
+  // The probabilities of the noise after each turn and the seed of all random draws, 0 seeds by the time
+  double birthNoise = 0;
+  double deathNoise = 0;
+  uint64_t seedOption = 0;
+
   // Command parser
   char commandValue[17];
   int dataPos = 0;
@@ -1323,7 +9888,28 @@ int main(int argc, char *argv[]) {
     if (argv[i][0] == '-') {
       commandType = -1;
 
-      if (strncmp(argv[i], "-ct", 3) == 0) {
+      if (strncmp(argv[i], "--startup-report", 16) == 0) {
+        dataPos = 16;
+        commandType = STARTUPREPORT;
+      } else if (strncmp(argv[i], "--record-input", 14) == 0) {
+        dataPos = 14;
+        commandType = RECORDINPUT;
+      } else if (strncmp(argv[i], "--replay-input", 14) == 0) {
+        dataPos = 14;
+        commandType = REPLAYINPUT;
+      } else if (strncmp(argv[i], "-lenia", 6) == 0) {
+        dataPos = 6;
+        commandType = LENIA;
+      } else if (strncmp(argv[i], "-eca", 4) == 0) {
+        dataPos = 4;
+        commandType = ELEMENTARY;
+      } else if (strncmp(argv[i], "-engine", 7) == 0) {
+        dataPos = 7;
+        commandType = TURNENGINE;
+      } else if (strncmp(argv[i], "-cube", 5) == 0) {
+        dataPos = 5;
+        commandType = LIFECUBE;
+      } else if (strncmp(argv[i], "-ct", 3) == 0) {
         dataPos = 3;
         commandType = COLORTRESHOLD;
       } else if (strncmp(argv[i], "-c", 2) == 0) {
@@ -1332,6 +9918,51 @@ int main(int argc, char *argv[]) {
       } else if (strncmp(argv[i], "-mfc", 4) == 0) {
         dataPos = 4;
         commandType = MAXIMUMFITCELLS;
+      } else if (strncmp(argv[i], "-ul", 3) == 0) {
+        dataPos = 3;
+        commandType = UNDOLIMIT;
+      } else if (strncmp(argv[i], "-verify", 7) == 0) {
+        dataPos = 7;
+        commandType = VERIFY;
+      } else if (strncmp(argv[i], "-benchcompare", 13) == 0) {
+        dataPos = 13;
+        commandType = BENCHCOMPARE;
+      } else if (strncmp(argv[i], "-bench", 6) == 0) {
+        dataPos = 6;
+        commandType = BENCHMARK;
+      } else if (strncmp(argv[i], "-bt", 3) == 0) {
+        dataPos = 3;
+        commandType = BENCHTHRESHOLD;
+      } else if (strncmp(argv[i], "-stall", 6) == 0) {
+        dataPos = 6;
+        commandType = STALLTHRESHOLD;
+      } else if (strncmp(argv[i], "-nb", 3) == 0) {
+        dataPos = 3;
+        commandType = NEIGHBOURHOOD;
+      } else if (strncmp(argv[i], "-rule", 5) == 0) {
+        dataPos = 5;
+        commandType = RULE;
+      } else if (strncmp(argv[i], "-table", 6) == 0) {
+        dataPos = 6;
+        commandType = STATETABLE;
+      } else if (strncmp(argv[i], "-seed", 5) == 0) {
+        dataPos = 5;
+        commandType = RANDOMSEED;
+      } else if (strncmp(argv[i], "-wireworld", 10) == 0) {
+        dataPos = 10;
+        commandType = WIREWORLD;
+      } else if (strncmp(argv[i], "-immigration", 12) == 0) {
+        dataPos = 12;
+        commandType = IMMIGRATION;
+      } else if (strncmp(argv[i], "-quadlife", 9) == 0) {
+        dataPos = 9;
+        commandType = QUADLIFE;
+      } else if (strncmp(argv[i], "-pb", 3) == 0) {
+        dataPos = 3;
+        commandType = BIRTHNOISE;
+      } else if (strncmp(argv[i], "-pd", 3) == 0) {
+        dataPos = 3;
+        commandType = DEATHNOISE;
       } else if (strncmp(argv[i], "-h", 2) == 0 || strncmp(argv[i], "-?", 2) == 0 || strncmp(argv[i], "?", 1) == 0) {
         printHelp();
         printf("\n######### Finished program. #########\n\n");
@@ -1359,7 +9990,7 @@ int main(int argc, char *argv[]) {
       if (commandType != -1 && strlen(argv[i]) >= dataPos) {
         commandValue[0] = '\0';
 
-        if (commandType <= MAXIMUMFITCELLS) {
+        if (commandType <= MAXIMUMFITCELLS || commandType == UNDOLIMIT || commandType == VERIFY || commandType == BENCHTHRESHOLD || commandType == STALLTHRESHOLD || commandType == BIRTHNOISE || commandType == DEATHNOISE) {
 
           strcpy(commandValue, &argv[i][dataPos]);
           commandValue[16] = '\0';
@@ -1377,84 +10008,372 @@ int main(int argc, char *argv[]) {
 
               cellsY = cellsX;
 
-              break;
-            case COLORTRESHOLD:
-              colorThresholdFloat =  atof(commandValue);
+              break;
+            case COLORTRESHOLD:
+              colorThresholdFloat =  atof(commandValue);
+
+              if (colorThresholdFloat < 0) {
+                colorThresholdFloat = 0.85;
+              } else if (colorThresholdFloat > 1) {
+                colorThresholdFloat = 0.85;
+              }
+
+              break;
+            case MAXIMUMFITCELLS:
+              maximumFitCellsForRandomValue = atof(commandValue);
+
+              if (maximumFitCellsForRandomValue < 0) {
+                maximumFitCellsForRandomValue = 0.4;
+              } else if (maximumFitCellsForRandomValue > 1) {
+                maximumFitCellsForRandomValue = 0.4;
+              }
+
+              break;
+            case UNDOLIMIT:
+              undoLimit = atoi(commandValue);
+
+              if (undoLimit < 1) {
+                undoLimit = UNDO_LIMIT_KB;
+              }
+
+              break;
+            case VERIFY:
+              verifyBoards = atoi(commandValue);
+
+              if (verifyBoards < 1) {
+                verifyBoards = 100;
+              }
+
+              break;
+            case BENCHTHRESHOLD:
+              benchThreshold = atof(commandValue);
+
+              if (benchThreshold < 0 || benchThreshold >= 1) {
+                benchThreshold = BENCH_THRESHOLD;
+              }
+
+              break;
+            case STALLTHRESHOLD:
+              stallMilliseconds = atoi(commandValue);
+
+              if (stallMilliseconds < 1) {
+                stallMilliseconds = FLIGHT_STALL_MS;
+              }
+
+              break;
+            case BIRTHNOISE:
+              birthNoise = atof(commandValue);
+
+              if (birthNoise < 0 || birthNoise > 1) {
+                birthNoise = 0;
+              }
+
+              break;
+            case DEATHNOISE:
+              deathNoise = atof(commandValue);
+
+              if (deathNoise < 0 || deathNoise > 1) {
+                deathNoise = 0;
+              }
+
+              break;
+            default:
+              continue;
+              break;
+          }
+
+        } else if (commandType == BENCHMARK) {
+          // File names are longer than the command value, so they are taken from the argument
+          benchmarkFile = argv[i][dataPos] != '\0' ? &argv[i][dataPos] : "benchmark.json";
+        } else if (commandType == BENCHCOMPARE) {
+          if (i + 2 >= argc) {
+            printf("[ERROR] -benchcompare needs a baseline and a candidate result file.\n");
+            return EXIT_FAILURE;
+          }
+
+          baselineFile = argv[++i];
+          candidateFile = argv[++i];
+        } else if (commandType == RECORDINPUT || commandType == REPLAYINPUT) {
+          if (i + 1 >= argc) {
+            printf("[ERROR] %s needs the file of the input recording.\n", argv[i]);
+            return EXIT_FAILURE;
+          }
+
+          if (commandType == RECORDINPUT) {
+            recordFile = argv[++i];
+          } else {
+            replayFile = argv[++i];
+          }
+        } else if (commandType == NEIGHBOURHOOD) {
+          // A neighbourhood is selected by the start of its name, "vn" is short for von Neumann
+          char* name = &argv[i][dataPos];
+
+          neighbourhood = -1;
+
+          for (int n = 0; n < NEIGHBOURHOOD_COUNT && name[0] != '\0'; ++n) {
+            if (strncmp(neighbourhoods[n].name, name, strlen(name)) == 0) {
+              neighbourhood = n;
+            }
+          }
+
+          if (strcmp(name, "vn") == 0) {
+            neighbourhood = VON_NEUMANN;
+          }
+
+          if (neighbourhood == -1) {
+            printf("[ERROR] Unknown neighbourhood \"%s\", use moore, hex or vn.\n", name);
+            return EXIT_FAILURE;
+          }
+        } else if (commandType == RULE) {
+          ruleText = &argv[i][dataPos];
+        } else if (commandType == STATETABLE) {
+          tableFile = &argv[i][dataPos];
+        } else if (commandType == RANDOMSEED) {
+          seedOption = strtoull(&argv[i][dataPos], NULL, 10);
+        } else if (commandType == WIREWORLD) {
+          isWireWorld = true;
+        } else if (commandType == IMMIGRATION) {
+          colourCount = 2;
+        } else if (commandType == QUADLIFE) {
+          colourCount = 4;
+        } else if (commandType == LIFECUBE) {
+          cubeRule = &argv[i][dataPos];
+        } else if (commandType == LENIA) {
+          leniaParameters = &argv[i][dataPos];
+        } else if (commandType == ELEMENTARY) {
+          elementaryText = &argv[i][dataPos];
+        } else if (commandType == TURNENGINE) {
+          engineName = &argv[i][dataPos];
+        } else if (commandType == STARTUPREPORT) {
+          startupReport.isEnabled = true;
+        } else if (commandType == USERANDOM) {
+          useRandom = true;
+        } else if (commandType == USECAIRO) {
+          useCairoPNGs = true;
+        } else {
+          strncpy(commandValue, &argv[i][dataPos], 16);
+          commandValue[16] = '\0';
+
+          // Its a boolean command
+          if (argv[i][dataPos] == '1' || argv[i][dataPos] == 't') {
+            switch (commandType) {
+              case DRAWGRID:
+                drawGrid = true;
+                break;
+              case SHOWANIMATIONS:
+                showAnimations = true;
+                break;
+              case DOCREATEHISTORY:
+                doCreateHistory = true;
+                break;
+              case DRAWINFOPANEL:
+                drawInfoPanel = true;
+                break;
+              default:
+                continue;
+                break;
+            }
+          } else if (argv[i][dataPos] == '0' || argv[i][dataPos] == 'f') {
+            switch (commandType) {
+              case DRAWGRID:
+                drawGrid = false;
+                break;
+              case SHOWANIMATIONS:
+                showAnimations = false;
+                break;
+              case DOCREATEHISTORY:
+                doCreateHistory = false;
+                break;
+              case DRAWINFOPANEL:
+                drawInfoPanel = false;
+                break;
+              default:
+                continue;
+                break;
+            }
+          }
+
+        }
+      }
+    }
+  }
+
+  markStartupPhase(&startupReport, "arguments");
+
+  // Check the rule before anything starts, it is applied to the playboard later
+  unsigned int birthRule = neighbourhoods[neighbourhood].birthRule;
+  unsigned int survivalRule = neighbourhoods[neighbourhood].survivalRule;
+  unsigned char ruleTable[512];
+  bool isIsotropicRule = false;   // Has the rule Hensel letters, so it needs the rule table?
+
+  if (ruleText != NULL && !parseRule(ruleText, &birthRule, &survivalRule)) {
+    isIsotropicRule = compileRuleTable(ruleText, ruleTable);
+
+    if (!isIsotropicRule) {
+      printf("[ERROR] Could not read the rule \"%s\", write it like B3/S23 or B2-a3/S12.\n", ruleText);
+      return EXIT_FAILURE;
+    }
+
+    if (neighbourhood != MOORE) {
+      printf("[ERROR] The Hensel letters of \"%s\" need the Moore neighbourhood.\n", ruleText);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Noise would flip copper and force a rebuild of the electron lists every turn
+  if (isWireWorld && (tableFile != NULL || isIsotropicRule || birthNoise > 0 || deathNoise > 0)) {
+    printf("[ERROR] Wireworld can not be played with a rule table, a rule or noise.\n");
+    return EXIT_FAILURE;
+  }
+
+  // The colour of a newborn cell is voted by its three parents
+  if (colourCount > 0 && (isWireWorld || tableFile != NULL || isIsotropicRule || neighbourhood != MOORE || birthRule != (1 << 3))) {
+    printf("[ERROR] Immigration and QuadLife need the moore neighbourhood and a rule with births by 3 neighbours, like B3/S23.\n");
+    return EXIT_FAILURE;
+  }
+
+  // 3D Life has its own rule and the playboard only shows the voxels
+  struct lifeCube lifeCube = { 0 };
+
+  if (cubeRule != NULL && (colourCount > 0 || isWireWorld || tableFile != NULL || ruleText != NULL || neighbourhood != MOORE || birthNoise > 0 || deathNoise > 0)) {
+    printf("[ERROR] 3D Life can not be played with a rule table, a rule, noise or another game.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (cubeRule != NULL && !parseCubeRule(cubeRule, &lifeCube)) {
+    return EXIT_FAILURE;
+  }
+
+  if (elementaryText != NULL) {
+    char* end = NULL;
+    long rule = strtol(elementaryText, &end, 10);
+
+    if (end == elementaryText || *end != '\0' || rule < 0 || rule > 255) {
+      printf("[ERROR] The 1D automaton rule \"%s\" is not a number from 0 to 255.\n", elementaryText);
+      return EXIT_FAILURE;
+    }
+
+    elementaryRule = (int) rule;
+  }
+
+  // Noise would flip the generations already drawn above the bottom row
+  if (elementaryRule != -1 && (cubeRule != NULL || colourCount > 0 || isWireWorld || tableFile != NULL || ruleText != NULL || neighbourhood != MOORE || birthNoise > 0 || deathNoise > 0)) {
+    printf("[ERROR] A 1D automaton can not be played with a rule table, a rule, noise or another game.\n");
+    return EXIT_FAILURE;
+  }
+
+  struct lenia lenia = { 0 };
+
+  if (leniaParameters != NULL && (elementaryRule != -1 || cubeRule != NULL || colourCount > 0 || isWireWorld || tableFile != NULL || ruleText != NULL || neighbourhood != MOORE || birthNoise > 0 || deathNoise > 0)) {
+    printf("[ERROR] Lenia can not be played with a rule table, a rule, noise or another game.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (leniaParameters != NULL && !parseLeniaParameters(leniaParameters, &lenia)) {
+    return EXIT_FAILURE;
+  }
+
+  // The turn engines play moore rules, the reference and the table engine only Conway's game
+  struct turnEngine* turnEngine = NULL;
+
+  for (unsigned int e = 0; engineName != NULL && e < turnEngineCount; ++e) {
+    if (strcmp(turnEngines[e].name, engineName) == 0) {
+      turnEngine = &turnEngines[e];
+    }
+  }
+
+  if (engineName != NULL && turnEngine == NULL) {
+    printf("[ERROR] Unknown turn engine \"%s\", use reference, moore, isotropic, table, list or auto.\n", engineName);
+    return EXIT_FAILURE;
+  }
+
+  if (turnEngine != NULL && (leniaParameters != NULL || elementaryRule != -1 || cubeRule != NULL || colourCount > 0 || isWireWorld || tableFile != NULL || isIsotropicRule || neighbourhood != MOORE)) {
+    printf("[ERROR] The turn engines play the moore neighbourhood, not with Hensel letters, a rule table or another game.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (turnEngine != NULL && (turnEngine->applyTurn == applyTurn || turnEngine->applyTurn == applyTurnStateTable) && (birthRule != neighbourhoods[MOORE].birthRule || survivalRule != neighbourhoods[MOORE].survivalRule)) {
+    printf("[ERROR] The %s engine plays Conway's game only, use moore, isotropic, list or auto for other rules.\n", turnEngine->name);
+    return EXIT_FAILURE;
+  }
+
+  //------------------------------------------------------------------------------
+  // Verify the turn engines without a window and exit
+  //------------------------------------------------------------------------------
+  if (verifyBoards > 0) {
+    bool isVerified = runVerification(verifyBoards);
+    printf("\n######### Finished program. #########\n\n");
+    return isVerified ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  //------------------------------------------------------------------------------
+  // Benchmark or compare benchmark results without a window and exit
+  //------------------------------------------------------------------------------
+  if (benchmarkFile != NULL || baselineFile != NULL) {
+    bool isPassed = benchmarkFile != NULL ? runBenchmark(benchmarkFile) : compareBenchmarks(baselineFile, candidateFile, benchThreshold);
+    printf("\n######### Finished program. #########\n\n");
+    return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  //------------------------------------------------------------------------------
+  // Keep the latest events of the game, dumped on stalls and crashes
+  //------------------------------------------------------------------------------
+  initFlightRecorder(stallMilliseconds);
+
+  //------------------------------------------------------------------------------
+  // Load the rule table of a multi-state automaton, it replaces the rule
+  //------------------------------------------------------------------------------
+  struct stateTable loadedTable;
+
+  initStateTable(&loadedTable, "");
 
-              if (colorThresholdFloat < 0) {
-                colorThresholdFloat = 0.85;
-              } else if (colorThresholdFloat > 1) {
-                colorThresholdFloat = 0.85;
-              }
+  if (tableFile != NULL) {
+    if (!loadStateTable(tableFile, &loadedTable)) {
+      return EXIT_FAILURE;
+    }
 
-              break;
-            case MAXIMUMFITCELLS:
-              maximumFitCellsForRandomValue = atof(commandValue);
+    markStartupPhase(&startupReport, "rule table");
+  }
 
-              if (maximumFitCellsForRandomValue < 0) {
-                maximumFitCellsForRandomValue = 0.4;
-              } else if (maximumFitCellsForRandomValue > 1) {
-                maximumFitCellsForRandomValue = 0.4;
-              }
+  //------------------------------------------------------------------------------
+  // Record or replay the input, the replay takes the playboard size and the
+  // random seed of the recording
+  //------------------------------------------------------------------------------
+  struct inputSession inputSession;
+  uint64_t randomSeed = seedOption;
 
-              break;
-            default:
-              continue;
-              break;
-          }
+  memset(&inputSession, 0, sizeof(inputSession));
 
-        } else if (commandType == USERANDOM) {
-          useRandom = true;
-        } else if (commandType == USECAIRO) {
-          useCairoPNGs = true;
-        } else {
-          strncpy(commandValue, &argv[i][dataPos], 16);
-          commandValue[16] = '\0';
+  if (replayFile != NULL) {
+    if (!openInputReplay(&inputSession, replayFile)) {
+      printf("[ERROR] Could not read the input recording %s\n", replayFile);
+      return EXIT_FAILURE;
+    }
 
-          // Its a boolean command
-          if (argv[i][dataPos] == '1' || argv[i][dataPos] == 't') {
-            switch (commandType) {
-              case DRAWGRID:
-                drawGrid = true;
-                break;
-              case SHOWANIMATIONS:
-                showAnimations = true;
-                break;
-              case DOCREATEHISTORY:
-                doCreateHistory = true;
-                break;
-              case DRAWINFOPANEL:
-                drawInfoPanel = true;
-                break;
-              default:
-                continue;
-                break;
-            }
-          } else if (argv[i][dataPos] == '0' || argv[i][dataPos] == 'f') {
-            switch (commandType) {
-              case DRAWGRID:
-                drawGrid = false;
-                break;
-              case SHOWANIMATIONS:
-                showAnimations = false;
-                break;
-              case DOCREATEHISTORY:
-                doCreateHistory = false;
-                break;
-              case DRAWINFOPANEL:
-                drawInfoPanel = false;
-                break;
-              default:
-                continue;
-                break;
-            }
-          }
+    cellsX = inputSession.cellsX;
+    cellsY = inputSession.cellsY;
+    randomSeed = inputSession.seed;
+    printf("[STATUS] Replaying %u frames of %s on %dx%d cells.\n", inputSession.endFrame, replayFile, cellsX, cellsY);
+  } else if (recordFile != NULL) {
+    randomSeed = seedOption != 0 ? seedOption : (((uint64_t) time(NULL) << 32) ^ (uint64_t) clock()) | 1;
 
-        }
-      }
+    if (!openInputRecording(&inputSession, recordFile, cellsX, cellsY, randomSeed)) {
+      printf("[ERROR] Could not open %s to record the input.\n", recordFile);
+      return EXIT_FAILURE;
     }
+
+    printf("[STATUS] Recording the input to %s\n", recordFile);
+  }
+
+  // The shifted rows of the hexagonal grid wrap cleanly with an even row count
+  // only, an odd one is rounded up. A replay rounds the recorded size the same way.
+  if (neighbourhood == HEXAGONAL && cellsY % 2 != 0) {
+    ++cellsY;
+    printf("[STATUS] The hexagonal grid needs an even row count, playing on %dx%d cells.\n", cellsX, cellsY);
   }
 
+  markStartupPhase(&startupReport, "input session");
+
   //------------------------------------------------------------------------------
   // Game options recalculations
   //------------------------------------------------------------------------------
@@ -1486,6 +10405,8 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  markStartupPhase(&startupReport, "video init");
+
   // Get the display mode, to check if we the windows can correctly be displayed
   SDL_DisplayMode current;
 
@@ -1509,16 +10430,9 @@ int main(int argc, char *argv[]) {
     }
   }
 
-  //----------------------------------------------------------------------------
-  // Init SDL image library to handle JPG AND PNG images
-  //----------------------------------------------------------------------------
-  if (IMG_Init(IMG_INIT_PNG) == 0) {
-    printf("[ERROR] Error initializing image loading:\n%s\n\nExiting.\n", IMG_GetError());
+  markStartupPhase(&startupReport, "display mode");
 
-    SDL_VideoQuit();
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
+  // The SDL image library is initialized on the first image import, see ensureImageLoading
 
   //----------------------------------------------------------------------------
   // Create application window
@@ -1532,6 +10446,8 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  markStartupPhase(&startupReport, "window");
+
   //----------------------------------------------------------------------------
   // Retrieve the drawing surface of the application windows
   //----------------------------------------------------------------------------
@@ -1546,6 +10462,9 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  // The window surface is owned by SDL, the cairo surface draws on its pixels
+  memoryAccount(MEMORY_SURFACES, (long long) drawingSurface->pitch * drawingSurface->h);
+
   //----------------------------------------------------------------------------
   // Create the cairo contexts, a drawing surface based from the application windows drawing area
   //----------------------------------------------------------------------------
@@ -1586,24 +10505,24 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
-  // Set the default font size to use
-  cairo_select_font_face(drawingContext, "sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
-  cairo_set_font_size(drawingContext, 16);
+  // The font face is selected before the first text is drawn, see selectGameFont
+  markStartupPhase(&startupReport, "surface and cairo");
 
   //----------------------------------------------------------------------------
   // Set the game options
   //----------------------------------------------------------------------------
   struct options gameOptions = { drawGrid, showAnimations, doCreateHistory, drawInfoPanel, false, 50, "", maximumFitCellsForRandom, colorThreshold, DISABLED };
 
+  // A seeded, recorded or replayed session uses a fixed seed, so random playboards repeat
+  gameOptions.randomSeed = randomSeed;
+
   //----------------------------------------------------------------------------
   // Initialze the gameBoard with default values
   //----------------------------------------------------------------------------
-  struct playBoard gameBoard = { true, "[PAUSED]", windowWidth, windowHeight, cellsX, cellsY, windowWidth / cellsX, windowHeight / cellsY, cellsX * cellsY, 0, 0, NULL };
-
-  // Get memory of the gameboard cells
-  gameBoard.cells = malloc(sizeof(struct cell) * gameBoard.cellCount);
+  struct playBoard gameBoard;
 
-  if (gameBoard.cells == NULL) {
+  // Get memory of the gameboard cells and set them to not living
+  if (!initPlayBoard(&gameBoard, windowWidth, windowHeight, cellsX, cellsY)) {
     printf("[ERROR] Could not reserve memory for the cells of the gameboard.\nExiting.\n");
 
     // Cleanup cairo
@@ -1621,42 +10540,130 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  // The neighbourhood and rule of the turns, Conway's game keeps the reference turn
+  gameBoard.neighbourhood = neighbourhood;
+  gameBoard.birthRule = birthRule;
+  gameBoard.survivalRule = survivalRule;
+
+  void (*applyGameTurn)(struct playBoard*, bool) = applyTurn;
+  struct wireWorld wireWorld = { 0 };
+  struct colourLife colourLife = { 0 };
+
+  struct elementaryAutomaton elementary = { 0 };
+
+  if (leniaParameters != NULL) {
+    if (!initLenia(&gameBoard, &lenia)) {
+      return EXIT_FAILURE;
+    }
+
+    applyGameTurn = applyTurnLenia;
+    printf("[STATUS] Playing Lenia with radius %d, mu %g, sigma %g and time step %g.\n", lenia.radius, lenia.mu, lenia.sigma, lenia.dt);
+  } else if (elementaryRule != -1) {
+    if (!initElementaryAutomaton(&elementary, gameBoard.cellsX, elementaryRule)) {
+      return EXIT_FAILURE;
+    }
+
+    // The first generation is a single living cell in the middle of the bottom row
+    gameBoard.elementary = &elementary;
+    gameBoard.cells[gameBoard.cellCount - gameBoard.cellsX + (gameBoard.cellsX / 2)].isLiving = true;
+    gameBoard.livingCells = 1;
+    applyGameTurn = applyTurnElementary;
+    printf("[STATUS] Playing the 1D automaton rule %d, the bottom row is the generation.\n", elementaryRule);
+  } else if (cubeRule != NULL) {
+    if (!initLifeCube(&gameBoard, &lifeCube)) {
+      return EXIT_FAILURE;
+    }
+
+    applyGameTurn = applyTurnLifeCube;
+    printf("[STATUS] Playing 3D Life %s on %d^3 voxels, showing slice %d.\n", cubeRule, lifeCube.size, lifeCube.slice);
+  } else if (colourCount > 0) {
+    if (!initColourLife(&gameBoard, &colourLife, colourCount)) {
+      return EXIT_FAILURE;
+    }
+
+    applyGameTurn = applyTurnColourLife;
+    printf("[STATUS] Playing %s, newborn cells take the colour of most of their parents.\n", colourCount == 2 ? "Immigration" : "QuadLife");
+  } else if (isWireWorld) {
+    gameBoard.wireWorld = &wireWorld;
+    applyGameTurn = applyTurnWireWorld;
+    printf("[STATUS] Playing Wireworld, living cells are copper, click on copper to start an electron.\n");
+  } else if (tableFile != NULL) {
+    gameBoard.stateTable = &loadedTable;
+    gameBoard.neighbourhood = loadedTable.neighbourhood;
+    applyGameTurn = applyTurnStateTable;
+    printf("[STATUS] Playing the rule table %s with %u states on the %s neighbourhood.\n", loadedTable.name, loadedTable.stateCount, neighbourhoods[loadedTable.neighbourhood].name);
+  } else if (isIsotropicRule) {
+    memcpy(gameBoard.ruleTable, ruleTable, sizeof(ruleTable));
+    applyGameTurn = applyTurnIsotropic;
+    printf("[STATUS] Playing the isotropic rule %s on the moore neighbourhood.\n", ruleText);
+  } else if (turnEngine != NULL) {
+    char ruleName[24];
+
+    // The switches of the auto engine are printed
+    if (turnEngine->applyTurn == applyTurnAuto && !initAutoEngine(&gameBoard, true)) {
+      return EXIT_FAILURE;
+    }
+
+    fillTotalisticTable(gameBoard.ruleTable, birthRule, survivalRule);
+    applyGameTurn = turnEngine->applyTurn;
+    formatRule(ruleName, birthRule, survivalRule);
+    printf("[STATUS] Playing %s with the %s turn engine.\n", ruleName, turnEngine->name);
+  } else if (neighbourhood != MOORE || birthRule != neighbourhoods[MOORE].birthRule || survivalRule != neighbourhoods[MOORE].survivalRule) {
+    char ruleName[24];
+
+    applyGameTurn = neighbourhoods[neighbourhood].applyTurn;
+    formatRule(ruleName, birthRule, survivalRule);
+    printf("[STATUS] Playing %s on the %s neighbourhood.\n", ruleName, neighbourhoods[neighbourhood].name);
+  }
+
+  // The noise flips cells after each turn, its draws are keyed by the seed, the turn and the cell
+  if (birthNoise > 0 || deathNoise > 0) {
+    gameBoard.noiseSeed = randomSeed != 0 ? randomSeed : ((uint64_t) time(NULL) << 32) ^ (uint64_t) clock();
+    gameBoard.birthNoise = probabilityThreshold(birthNoise);
+    gameBoard.deathNoise = probabilityThreshold(deathNoise);
+    printf("[STATUS] Noise: dead cells are born with %g, living cells die with %g, seed %llu.\n", birthNoise, deathNoise, (unsigned long long) gameBoard.noiseSeed);
+  }
+
+  markStartupPhase(&startupReport, "playboard");
+
   //----------------------------------------------------------------------------
   // Initialze the game history
   //----------------------------------------------------------------------------
   struct gameHistoryGame gameHistory = {0, 0, NULL};
 
   //----------------------------------------------------------------------------
-  // Initialze the gameboard cells
+  // Initialze the undo journal of playboard edits
   //----------------------------------------------------------------------------
-  for (int y = 0; y < gameBoard.cellsY; ++y) {
-    for (int x = 0; x < gameBoard.cellsX; ++x) {
-
-      // The offset in the array
-      int offset = x + (y * gameBoard.cellsY);
+  struct editJournal editJournal = { 0, 0, 0, (size_t) undoLimit * 1024, NULL, 0, NULL, NULL, 0, 0, false, NULL };
 
-      // Set default to not living
-      gameBoard.cells[offset].isLiving = false;
+  //----------------------------------------------------------------------------
+  // Initialze the tracking of moving objects
+  //----------------------------------------------------------------------------
+  struct objectTracker objectTracker;
 
-      // The x and y position off the cell used for drawing
-      gameBoard.cells[offset].x = x * gameBoard.cellWidth;
-      gameBoard.cells[offset].y = y * gameBoard.cellHeight;
+  if (!initObjectTracker(&objectTracker, &gameBoard)) {
+    printf("[ERROR] Could not reserve memory for the object tracking, tracking is disabled.\n");
+  }
 
-      // The x and y location of the grid field in the gameboard
-      gameBoard.cells[offset].cellX = x;
-      gameBoard.cells[offset].cellY = y;
+  //----------------------------------------------------------------------------
+  // Load the pattern stamps of the built-in catalog and the patterns directory
+  //----------------------------------------------------------------------------
+  struct stampLibrary patternLibrary;
 
-      // Animation properties
-      gameBoard.cells[offset].cellChanged = false;
-      gameBoard.cells[offset].size = 0.0;
-    }
+  if (!initStampLibrary(&patternLibrary, PATTERN_DIRECTORY)) {
+    printf("[ERROR] Could not reserve memory for the pattern library, stamping is disabled.\n");
+  } else {
+    printf("[STATUS] Loaded %u patterns for stamping in paint mode.\n", patternLibrary.count);
   }
 
+  markStartupPhase(&startupReport, "tracker and patterns");
+
   //------------------------------------------------------------------------------
 
   // Should we init the gameboard randomly with living cells?
   if (useRandom) {
     initRandomBoard(&gameBoard, &gameOptions);
+    markStartupPhase(&startupReport, "random playboard");
   }
 
   //----------------------------------------------------------------------------
@@ -1681,6 +10688,10 @@ int main(int argc, char *argv[]) {
   bool doPaint = false;         // Are we in painting mode?
   bool storeAnimate = false;    // When painting mode is enabled/disabled, we restore the animation on/off state to the options
   bool mousePressed = false;    // Is the left mouse button pressed?
+  bool selectionPressed = false; // Is the right mouse button pressed to select a rectangle in paint mode?
+  SDL_Keycode shortcutKey = 0;  // The key last pressed with the control key, its release is not a plain key
+  int selectionAnchorX = 0;     // The cell x location where the selection started
+  int selectionAnchorY = 0;     // The cell y location where the selection started
 
   // History control
   bool isInHistory = false;     // Are we navigating in history?
@@ -1693,16 +10704,41 @@ int main(int argc, char *argv[]) {
   // Saving png files
   char filename[256];           // Filename for saving a file
 
+  // Flight recorder
+  Uint64 eventStart = 0;        // Performance counter at the start of a recorded event
+
   // Draw the initial game board once
   animationInProgress = drawGameBoard(appWindow, drawingSurface, cairoSurface, drawingContext, &gameBoard, &gameOptions, &gameHistory);
 
+  markStartupPhase(&startupReport, "first frame");
+
+  if (startupReport.isEnabled) {
+    printStartupReport(&startupReport);
+  }
+
   //----------------------------------------------------------------------------
   // Main loop
   //----------------------------------------------------------------------------
   while(doRunMainLoop) {
 
-    // Handle SDL window events and user input and such
-    while (SDL_PollEvent(&appEvent)) {
+    // Count the frame for the flight recorder, a stalled frame dumps it
+    beginFlightFrame();
+
+    // Count the frames of a recording or replay, the replay ends after the last recorded frame
+    if (inputSession.file != NULL) {
+      beginInputFrame(&inputSession);
+
+      if (inputSession.isReplaying && inputSession.frame > inputSession.endFrame) {
+        break;
+      }
+    }
+
+    // Handle SDL window events and user input and such, when replaying the recorded ones
+    while (inputSession.isReplaying ? nextReplayEvent(&inputSession, &appEvent) : SDL_PollEvent(&appEvent)) {
+      if (inputSession.file != NULL && !inputSession.isReplaying) {
+        recordInputEvent(&inputSession, &appEvent);
+      }
+
       switch(appEvent.type) {
         case SDL_WINDOWEVENT:
           switch (appEvent.window.event) {
@@ -1714,8 +10750,17 @@ int main(int argc, char *argv[]) {
           }
           break;
         case SDL_MOUSEMOTION:
-          if (doPaint && mousePressed) {
+          if (doPaint && selectionPressed) {
+            // Span the selection from the anchor to the mouse
+            setSelection(&gameOptions, &gameBoard, selectionAnchorX, selectionAnchorY, appEvent.motion.x / gameBoard.cellWidth, appEvent.motion.y / gameBoard.cellHeight);
+          } else if (doPaint && patternLibrary.active != -1) {
+            // Move the stamp preview centered under the mouse
+            gameOptions.stampX = (appEvent.motion.x / gameBoard.cellWidth) - (patternLibrary.oriented.width / 2);
+            gameOptions.stampY = (appEvent.motion.y / gameBoard.cellHeight) - (patternLibrary.oriented.height / 2);
+          } else if (doPaint && mousePressed) {
+            eventStart = SDL_GetPerformanceCounter();
             paintCell(&appEvent, &gameBoard, true);
+            recordFlightEvent(FLIGHT_PAINT, eventStart, gameBoard.livingCells);
           } else if (gameOptions.drawInfoPanel) {
             if (appEvent.button.y < windowHeight - 100) {
              gameOptions.activePanelItem = DISABLED;
@@ -1737,17 +10782,49 @@ int main(int argc, char *argv[]) {
                 case SDL_PRESSED:
                   mousePressed = true;
 
-                  if (doPaint) {
+                  if (doPaint && patternLibrary.active != -1) {
+                    // Stamp the selected pattern centered on the clicked cell
+                    gameOptions.stampX = (appEvent.button.x / gameBoard.cellWidth) - (patternLibrary.oriented.width / 2);
+                    gameOptions.stampY = (appEvent.button.y / gameBoard.cellHeight) - (patternLibrary.oriented.height / 2);
+
+                    beginEdit(&editJournal, &gameBoard);
+                    stampBitBlock(&patternLibrary.oriented, &gameBoard, gameOptions.stampX, gameOptions.stampY);
+                    commitEdit(&editJournal, &gameBoard);
+
+                    // Stamping is done per click, not while dragging
+                    mousePressed = false;
+                    continue;
+                  } else if (doPaint) {
+                    // The painted stroke is recorded as one edit when the button is released
+                    beginEdit(&editJournal, &gameBoard);
+                    eventStart = SDL_GetPerformanceCounter();
                     paintCell(&appEvent, &gameBoard, false);
+                    recordFlightEvent(FLIGHT_PAINT, eventStart, gameBoard.livingCells);
                     continue;
                   }
                   break;
                 case SDL_RELEASED:
                 default:
+                  if (doPaint && mousePressed) {
+                    commitEdit(&editJournal, &gameBoard);
+                  }
+
                   mousePressed = false;
                   break;
               }
 
+              break;
+            case SDL_BUTTON_RIGHT:
+              // The right mouse button selects a rectangle in paint mode
+              if (doPaint && appEvent.button.state == SDL_PRESSED) {
+                selectionPressed = true;
+                selectionAnchorX = appEvent.button.x / gameBoard.cellWidth;
+                selectionAnchorY = appEvent.button.y / gameBoard.cellHeight;
+                setSelection(&gameOptions, &gameBoard, selectionAnchorX, selectionAnchorY, selectionAnchorX, selectionAnchorY);
+              } else {
+                selectionPressed = false;
+              }
+
               break;
             default:
               break;
@@ -1756,8 +10833,13 @@ int main(int argc, char *argv[]) {
           break;
         case SDL_DROPFILE:
           droppedFilePath = appEvent.drop.file;
+          beginEdit(&editJournal, &gameBoard);
+          eventStart = SDL_GetPerformanceCounter();
 
           if (generateCellMapFromImage(droppedFilePath, &gameBoard, &gameOptions)) {
+            recordFlightEvent(FLIGHT_IMPORT, eventStart, gameBoard.livingCells);
+            commitEdit(&editJournal, &gameBoard);
+
             if (gameOptions.doRecordHistory) {
               // Clear any history if present
               clearHistory(&gameHistory);
@@ -1774,12 +10856,127 @@ int main(int argc, char *argv[]) {
           SDL_free(droppedFilePath);
           break;
         case SDL_KEYDOWN:
+          // Undo and redo with the control key, and selection commands in paint mode. Every key
+          // pressed with the control key is a shortcut, it never reaches the plain keys.
+          if (appEvent.key.keysym.mod & KMOD_CTRL) {
+            shortcutKey = appEvent.key.keysym.sym;
+
+            SDL_Keycode key = appEvent.key.keysym.sym;
+
+            // The selection commands need paint mode, ctrl + c never clears the playboard
+            if (!doPaint && (key == SDLK_c || key == SDLK_x || key == SDLK_v || key == SDLK_i || key == SDLK_r || key == SDLK_d || key == SDLK_f)) {
+              set_options_message(&gameOptions, "Enter paint mode (\"p\" key) to select.");
+              break;
+            }
+
+            switch (appEvent.key.keysym.sym) {
+              case SDLK_z:
+              case SDLK_y:
+                // "ctrl + z" undoes and "ctrl + y" redoes the last edit
+                if (isInHistory) {
+                  set_options_message(&gameOptions, "Undo is not available while reviewing history.");
+                } else if (appEvent.key.keysym.sym == SDLK_z ? undoEdit(&editJournal, &gameBoard) : redoEdit(&editJournal, &gameBoard)) {
+                  sprintf(message, "[%s] Edit %u of %u.", appEvent.key.keysym.sym == SDLK_z ? "UNDO" : "REDO", editJournal.position, editJournal.entries);
+                  set_options_message(&gameOptions, message);
+                  doRender = true;
+
+                  // The recorded history does not match the playboard anymore
+                  if (gameOptions.doRecordHistory) {
+                    clearHistory(&gameHistory);
+                    historyCreated = false;
+                  }
+                } else {
+                  set_options_message(&gameOptions, appEvent.key.keysym.sym == SDLK_z ? "Nothing to undo." : "Nothing to redo.");
+                }
+                break;
+              case SDLK_c:
+              case SDLK_x:
+                // "ctrl + c" copies and "ctrl + x" cuts the selection into the clipboard
+                if (!copySelection(&gameBoard, &gameOptions, &patternLibrary)) {
+                  set_options_message(&gameOptions, "Select a rectangle with the right mouse button first.");
+                  break;
+                }
+
+                if (appEvent.key.keysym.sym == SDLK_x) {
+                  beginEdit(&editJournal, &gameBoard);
+                  applyRegionOperation(&gameBoard, &gameOptions, REGION_CLEAR);
+                  commitEdit(&editJournal, &gameBoard);
+                }
+
+                // Keep the oriented stamp in sync if the clipboard is stamped right now
+                if (patternLibrary.active == patternLibrary.clipboard) {
+                  selectStamp(&patternLibrary, patternLibrary.clipboard, patternLibrary.rotation, patternLibrary.flipped);
+                  gameOptions.stampPreview = &patternLibrary.oriented;
+                }
+
+                sprintf(message, "[SELECTION] %s %dx%d cells.", appEvent.key.keysym.sym == SDLK_x ? "Cut" : "Copied", gameOptions.selectionWidth, gameOptions.selectionHeight);
+                set_options_message(&gameOptions, message);
+                break;
+              case SDLK_v:
+                // "ctrl + v" selects the clipboard as pattern stamp to paste it by click
+                if (patternLibrary.clipboard == -1 || !selectStamp(&patternLibrary, patternLibrary.clipboard, 0, false)) {
+                  set_options_message(&gameOptions, "Nothing copied to paste.");
+                  break;
+                }
+
+                gameOptions.stampPreview = &patternLibrary.oriented;
+                set_options_message(&gameOptions, "[SELECTION] Click to paste the clipboard.");
+                break;
+              case SDLK_i:
+                // "ctrl + i" inverts the selection
+                beginEdit(&editJournal, &gameBoard);
+
+                if (applyRegionOperation(&gameBoard, &gameOptions, REGION_INVERT)) {
+                  commitEdit(&editJournal, &gameBoard);
+                  set_options_message(&gameOptions, "[SELECTION] Inverted.");
+                }
+                break;
+              case SDLK_r:
+                // "ctrl + r" fills the selection randomly by the maximum fit cells ratio
+                beginEdit(&editJournal, &gameBoard);
+
+                if (applyRegionOperation(&gameBoard, &gameOptions, REGION_RANDOM)) {
+                  commitEdit(&editJournal, &gameBoard);
+                  set_options_message(&gameOptions, "[SELECTION] Filled randomly.");
+                }
+                break;
+              case SDLK_d:
+                // "ctrl + d" removes the selection
+                gameOptions.hasSelection = false;
+                break;
+              case SDLK_f:
+                // "ctrl + f" searches the selected pattern stamp in all orientations
+                clearPatternMatches(&gameOptions);
+
+                if (patternLibrary.active == -1) {
+                  set_options_message(&gameOptions, "Select a pattern stamp to search for.");
+                  break;
+                }
+
+                gameOptions.matchCount = findPatternMatches(&gameBoard, &patternLibrary.patterns[patternLibrary.active].block, &gameOptions.matches);
+
+                // List the matches on the console
+                for (unsigned int i = 0; i < gameOptions.matchCount; ++i) {
+                  printf("[SEARCH] %s at %d x, %d y, %d degrees%s\n", patternLibrary.patterns[patternLibrary.active].name, gameOptions.matches[i].x, gameOptions.matches[i].y, (gameOptions.matches[i].orientation & 3) * 90, gameOptions.matches[i].orientation >= 4 ? ", flipped" : "");
+                }
+
+                sprintf(message, "[SEARCH] Found %u matches of %.24s.", gameOptions.matchCount, patternLibrary.patterns[patternLibrary.active].name);
+                set_options_message(&gameOptions, message);
+                break;
+              default:
+                break;
+            }
+
+            break;
+          }
+
           switch (appEvent.key.keysym.sym) {
             case SDLK_COMMA:
               // Navigate history backwards, by pressing ";" key
               if (historyCreated) {
                 if (historyBackwards(&gameHistory, &gameBoard)) {
                   isInHistory = true; // Set that we are navigating in history
+                  clearJournal(&editJournal);
 
                   if (gameHistory.currentTurn == 0) {
                     set_options_message(&gameOptions, "[HISTORY] Reached initital state.");
@@ -1801,6 +10998,7 @@ int main(int argc, char *argv[]) {
               if (historyCreated) {
                 if (historyForwards(&gameHistory, &gameBoard)) {
                   isInHistory = true;   // Set that we are navigating in history
+                  clearJournal(&editJournal);
                   sprintf(message, "[FORWARD] Showing historical turn: %d", gameHistory.currentTurn);
                   set_options_message(&gameOptions, message);
                 } else if (gameHistory.currentTurn == (gameHistory.turns - 1)) {
@@ -1815,19 +11013,67 @@ int main(int argc, char *argv[]) {
                 set_options_message(&gameOptions, "History is not yet recorded.");
               }
 
+              break;
+            case SDLK_UP:
+            case SDLK_DOWN:
+              // Show the next or previous slice of 3D Life by pressing the arrow keys
+              if (gameBoard.lifeCube == NULL || isInHistory) {
+                break;
+              }
+
+              // Keep the cells painted on the shown slice or projection
+              if (gameBoard.isEdited) {
+                applyLifeCubeEdits(&gameBoard);
+              }
+
+              lifeCube.slice = (lifeCube.slice + (appEvent.key.keysym.sym == SDLK_UP ? 1 : lifeCube.size - 1)) % lifeCube.size;
+              lifeCube.isProjected = false;
+              showLifeCube(&gameBoard, true);
+              doRender = true;
+
+              sprintf(message, "[3D] Showing slice %d of %d.", lifeCube.slice, lifeCube.size);
+              set_options_message(&gameOptions, message);
+
               break;
             default:
               break;
           }
           break;
         case SDL_KEYUP:
+          // The keys of control shortcuts were handled by their press, also if the control key is released first
+          if ((appEvent.key.keysym.mod & KMOD_CTRL) || appEvent.key.keysym.sym == shortcutKey) {
+            shortcutKey = 0;
+            break;
+          }
+
           switch (appEvent.key.keysym.sym) {
+            case SDLK_DELETE:
+              // "delete" key clears the selection in paint mode
+              if (!doPaint) {
+                break;
+              }
+
+              beginEdit(&editJournal, &gameBoard);
+
+              if (applyRegionOperation(&gameBoard, &gameOptions, REGION_CLEAR)) {
+                commitEdit(&editJournal, &gameBoard);
+                set_options_message(&gameOptions, "[SELECTION] Cleared.");
+              }
+
+              break;
             case SDLK_s:
               // "s" key saves the current game scene to a png file labeled by the time
               // unfortuntely those cannot be reloaded in the application, but have to be added an alpha value in Gimp or similar
 
               set_options_message(&gameOptions, "");
 
+              // Do not save the stamp preview, selection and search matches of paint mode
+              gameOptions.stampPreview = NULL;
+              bool storeSelection = gameOptions.hasSelection;
+              unsigned int storeMatchCount = gameOptions.matchCount;
+              gameOptions.hasSelection = false;
+              gameOptions.matchCount = 0;
+
               if (drawGrid) {
                 // Turn the grid temporary off
                 gameOptions.drawGrid = false;
@@ -1843,11 +11089,15 @@ int main(int argc, char *argv[]) {
               }
 
               #ifdef _ISWINDOWS
-                sprintf(filename, "saved_images/%I64d.png", time(NULL));
+                sprintf(filename, SAVED_IMAGE_DIRECTORY "/%I64d.png", time(NULL));
               #else
-                sprintf(filename, "saved_images/%ld.png", time(NULL));
+                sprintf(filename, SAVED_IMAGE_DIRECTORY "/%ld.png", time(NULL));
               #endif
 
+              // The directory is created on the first save
+              ensureDirectory(SAVED_IMAGE_DIRECTORY);
+              eventStart = SDL_GetPerformanceCounter();
+
               if (!useCairoPNGs) {
                 if (writePNG(drawingSurface, &gameBoard, &filename[0], &gameOptions)) {
                   sprintf(message, "Image saved in %s", filename);
@@ -1872,6 +11122,15 @@ int main(int argc, char *argv[]) {
                 }
               }
 
+              recordFlightEvent(FLIGHT_SAVE, eventStart, gameBoard.turns);
+
+              if (doPaint && patternLibrary.active != -1) {
+                gameOptions.stampPreview = &patternLibrary.oriented;
+              }
+
+              gameOptions.hasSelection = storeSelection;
+              gameOptions.matchCount = storeMatchCount;
+
               break;
             case SDLK_PLUS:
               // "+" (not numpad!) to decrease turn ticks to increase game speed
@@ -1901,8 +11160,10 @@ int main(int argc, char *argv[]) {
                 clearHistory(&gameHistory);
               }
 
-              // Reset the playboard
+              // Reset the playboard, recorded for undo
+              beginEdit(&editJournal, &gameBoard);
               resetPlayboard(&gameBoard);
+              commitEdit(&editJournal, &gameBoard);
 
               // Set to render and pause the game
               doRender = true;
@@ -1934,6 +11195,11 @@ int main(int argc, char *argv[]) {
                 gameOptions.showAnimations = false;
                 sprintf(gameBoard.status, "[PAINT MODE]");
 
+                // A pattern stamp kept from the paint mode before is shown again
+                if (patternLibrary.active != -1) {
+                  gameOptions.stampPreview = &patternLibrary.oriented;
+                }
+
                 // Reset history states as we draw it invalid...
                 historyCreated = false; // Reset history to be not yet created
                 isInHistory = false;    // Reset that we are not anymore in history
@@ -1945,6 +11211,10 @@ int main(int argc, char *argv[]) {
 
               } else {
                 gameOptions.showAnimations = storeAnimate;
+                gameOptions.stampPreview = NULL;
+                gameOptions.hasSelection = false;
+                selectionPressed = false;
+                clearPatternMatches(&gameOptions);
                 sprintf(gameBoard.status, doPause ? "[PAUSED]" : "[RUNNING]");
 
                 // Restart processing and drawing in case the game ended
@@ -1994,18 +11264,58 @@ int main(int argc, char *argv[]) {
                 clearHistory(&gameHistory);
               }
 
-              // Init a random playboard
+              // Init a random playboard, recorded for undo
+              beginEdit(&editJournal, &gameBoard);
               initRandomBoard(&gameBoard, &gameOptions);
+              commitEdit(&editJournal, &gameBoard);
 
               set_options_message(&gameOptions, "Initialized random playboard.");
               sprintf(gameBoard.status, doPause ? "[PAUSED]" : "[RUNNING]");
 
+              break;
+            case SDLK_o:
+              // Turn the object tracking on and off by pressing "o" key
+              if (objectTracker.visited == NULL) {
+                set_options_message(&gameOptions, "Object tracking is not available.");
+                break;
+              }
+
+              objectTracker.isEnabled = !objectTracker.isEnabled;
+              objectTracker.count = 0;
+              snprintf(objectTracker.summary, 128, "Tracking objects from the next turn");
+              gameOptions.trackingSummary = objectTracker.isEnabled ? objectTracker.summary : NULL;
+
+              set_options_message(&gameOptions, objectTracker.isEnabled ? "Object tracking enabled, shown in the info panel." : "Object tracking disabled.");
+              break;
+            case SDLK_m:
+              // Turn the memory overlay on and off by pressing "m" key
+              gameOptions.drawMemoryStats = !gameOptions.drawMemoryStats;
+              set_options_message(&gameOptions, gameOptions.drawMemoryStats ? "Memory overlay turned on." : "Memory overlay turned off.");
+
               break;
             case SDLK_g:
               // Turn on and off the grid drawing, by pressing "g" key
               gameOptions.drawGrid = !gameOptions.drawGrid;
               set_options_message(&gameOptions, gameOptions.drawGrid ? "Grid turned on." : "Grid turned off." );
 
+              break;
+            case SDLK_v:
+              // Switch 3D Life between the slice and the projection of all planes by pressing "v" key
+              if (gameBoard.lifeCube == NULL || isInHistory) {
+                break;
+              }
+
+              // Keep the cells painted on the shown slice or projection
+              if (gameBoard.isEdited) {
+                applyLifeCubeEdits(&gameBoard);
+              }
+
+              lifeCube.isProjected = !lifeCube.isProjected;
+              showLifeCube(&gameBoard, true);
+              doRender = true;
+
+              set_options_message(&gameOptions, lifeCube.isProjected ? "[3D] Showing the projection of all slices." : "[3D] Showing a slice, arrow keys to move.");
+
               break;
             case SDLK_a:
               // Turn animations on or off by pressing "a" key
@@ -2020,6 +11330,47 @@ int main(int argc, char *argv[]) {
                 set_options_message(&gameOptions, gameOptions.showAnimations ? "Animations turned on." : "Animations turned off.");
               }
 
+              break;
+            case SDLK_0:
+            case SDLK_1:
+            case SDLK_2:
+            case SDLK_3:
+            case SDLK_4:
+            case SDLK_5:
+            case SDLK_6:
+            case SDLK_7:
+            case SDLK_8:
+            case SDLK_9:
+            case SDLK_n:
+            case SDLK_t:
+            case SDLK_f:
+              // Select ("1" to "9", "n" for next), rotate ("t") and flip ("f") pattern stamps in paint mode, "0" returns to single cells
+              if (!doPaint) {
+                set_options_message(&gameOptions, "Patterns can be stamped in paint mode only.");
+                break;
+              }
+
+              if (appEvent.key.keysym.sym == SDLK_0 || patternLibrary.count == 0) {
+                selectStamp(&patternLibrary, -1, 0, false);
+              } else if (appEvent.key.keysym.sym == SDLK_n) {
+                selectStamp(&patternLibrary, (patternLibrary.active + 1) % (int) patternLibrary.count, 0, false);
+              } else if (appEvent.key.keysym.sym == SDLK_t) {
+                selectStamp(&patternLibrary, patternLibrary.active, patternLibrary.rotation + 1, patternLibrary.flipped);
+              } else if (appEvent.key.keysym.sym == SDLK_f) {
+                selectStamp(&patternLibrary, patternLibrary.active, patternLibrary.rotation, !patternLibrary.flipped);
+              } else {
+                selectStamp(&patternLibrary, appEvent.key.keysym.sym - SDLK_1, 0, false);
+              }
+
+              if (patternLibrary.active == -1) {
+                gameOptions.stampPreview = NULL;
+                set_options_message(&gameOptions, "Painting single cells.");
+              } else {
+                gameOptions.stampPreview = &patternLibrary.oriented;
+                snprintf(message, 64, "[STAMP] %s, %d degrees%s", patternLibrary.patterns[patternLibrary.active].name, patternLibrary.rotation * 90, patternLibrary.flipped ? ", flipped" : "");
+                set_options_message(&gameOptions, message);
+              }
+
               break;
             case SDLK_SPACE:
               // Pause or play by pressing "space" key
@@ -2036,6 +11387,10 @@ int main(int argc, char *argv[]) {
                 doPaint = false;
                 mousePressed = false;
                 gameOptions.showAnimations = storeAnimate;
+                gameOptions.stampPreview = NULL;
+                gameOptions.hasSelection = false;
+                selectionPressed = false;
+                clearPatternMatches(&gameOptions);
                 doPause = false;
               } else {
                 // Pause state change
@@ -2061,8 +11416,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (doPaint) {
+      eventStart = SDL_GetPerformanceCounter();
       drawGameBoard(appWindow, drawingSurface, cairoSurface, drawingContext, &gameBoard, &gameOptions, &gameHistory);
-      if (gameOptions.hasMessage || !mousePressed) {
+      recordFlightEvent(FLIGHT_RENDER, eventStart, gameBoard.livingCells);
+      endFlightFrame();
+      if ((gameOptions.hasMessage || !mousePressed) && !inputSession.isReplaying) {
         SDL_Delay(40);
       }
       continue;
@@ -2070,7 +11428,10 @@ int main(int argc, char *argv[]) {
 
     if ((!doRender || (!animationInProgress && doPause)) && !gameOptions.hasMessage && gameOptions.activePanelItem == DISABLED) {
       // Delay the application execution waiting only for user input or while in pause mode after animation finish
-      SDL_Delay(125);
+      endFlightFrame();
+      if (!inputSession.isReplaying) {
+        SDL_Delay(125);
+      }
       continue;
     }
 
@@ -2083,7 +11444,9 @@ int main(int argc, char *argv[]) {
 
           // If we create a a history add the initial turn
           if (!isInHistory && !historyCreated) {
+            eventStart = SDL_GetPerformanceCounter();
             historyCreated = addHistory(&gameHistory, &gameBoard);
+            recordFlightEvent(FLIGHT_HISTORY, eventStart, gameHistory.turns);
           }
 
           // Check if we record a history and if we are "in history" mode
@@ -2099,17 +11462,34 @@ int main(int argc, char *argv[]) {
           }
         }
 
+        // Recorded edits can not be undone on a playboard changed by turns, a running edit is dropped
+        if (editJournal.entries != 0 || gameBoard.journal != NULL) {
+          clearJournal(&editJournal);
+        }
+
         // Check that we are not regenerating the playboard from history
         if (!isInHistory) {
           // Apply a turn and rules for birth and death
-          applyTurn(&gameBoard, isInHistory);
+          eventStart = SDL_GetPerformanceCounter();
+          applyGameTurn(&gameBoard, isInHistory);
+
+          recordFlightEvent(FLIGHT_TURN, eventStart, gameBoard.turns);
+
+          // Follow the moving objects through the changed cells of the turn
+          if (objectTracker.isEnabled) {
+            updateObjectTracker(&objectTracker, &gameBoard);
+          }
 
           // If we create a a history add this turn
           if (gameOptions.doRecordHistory) {
+            eventStart = SDL_GetPerformanceCounter();
+
             if (!addHistory(&gameHistory, &gameBoard)) {
               set_options_message(&gameOptions, "[HISTORY] Could not add to history, recording disabled.");
               gameOptions.doRecordHistory = false;
             }
+
+            recordFlightEvent(FLIGHT_HISTORY, eventStart, gameHistory.turns);
           }
         }
 
@@ -2124,10 +11504,12 @@ int main(int argc, char *argv[]) {
     }
 
     // Draw the basic game board and living cells
+    eventStart = SDL_GetPerformanceCounter();
     animationInProgress = drawGameBoard(appWindow, drawingSurface, cairoSurface, drawingContext, &gameBoard, &gameOptions, &gameHistory);
+    recordFlightEvent(FLIGHT_RENDER, eventStart, gameBoard.livingCells);
 
-    // Perform a check if all cells died in this turn
-    if (!doPause && doRender && gameBoard.livingCells == 0) {
+    // Perform a check if all cells died in this turn, 3D Life lives on in other slices
+    if (!doPause && doRender && gameBoard.livingCells == 0 && (gameBoard.lifeCube == NULL || gameBoard.lifeCube->livingVoxels == 0)) {
 
       // Set render state to false after the last cells animated out or had been cleared
       if (!animationInProgress || !gameOptions.showAnimations) {
@@ -2146,22 +11528,39 @@ int main(int argc, char *argv[]) {
     }
     SDL_SetWindowTitle(appWindow, titleString);
 
-    // Delay the application execution
-    if (!doPaint && !mousePressed) {
+    // Delay the application execution, a replay runs as fast as possible
+    endFlightFrame();
+    if (!doPaint && !mousePressed && !inputSession.isReplaying) {
       SDL_Delay(40);
     }
   }
 
+  // Report the memory of each subsystem at the end of the game and its peak
+  printMemoryReport();
+
   //----------------------------------------------------------------------------
   // Cleanup
-  free(gameBoard.cells);
+  closeInputSession(&inputSession, replayFile != NULL ? replayFile : recordFile, &gameBoard);
+  freePlayBoard(&gameBoard);
+  freeWireWorld(&wireWorld);
+  freeColourLife(&colourLife);
+  freeLifeCube(&lifeCube);
+  freeElementaryAutomaton(&elementary);
+  freeLenia(&lenia);
+  freeStateTable(&loadedTable);
+  freeStateTable(&conwayStateTable);
+  freeObjectTracker(&objectTracker);
   clearHistory(&gameHistory);
+  freeJournal(&editJournal);
+  clearPatternMatches(&gameOptions);
+  freeStampLibrary(&patternLibrary);
 
   // Cleanup cairo
   cairo_surface_destroy(cairoSurface);
   cairo_destroy(drawingContext);
 
   // Cleanup SDL
+  memoryAccount(MEMORY_SURFACES, -(long long) drawingSurface->pitch * drawingSurface->h);
   SDL_FreeSurface(drawingSurface);
   SDL_DestroyWindow(appWindow);
 